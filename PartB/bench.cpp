@@ -0,0 +1,156 @@
+#include "include/AsyncWorkflow.h"
+#include "include/FileIO.h"
+#include "include/SpscQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Benchmark of the coroutine workflow against a thread-per-stage design
+ *
+ * Both variants run the same job on every input file: read it, fit the model
+ * and write a prediction report (AsyncWorkflow::trainAndScore). The baseline
+ * dedicates one thread to each stage (reader -> compute -> writer) joined by
+ * SPSC queues; the coroutine version suspends on I/O and resumes the jobs on
+ * a shared compute pool.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct Job {
+    size_t index = 0;
+    std::string text;
+};
+
+// Write a synthetic machine.data-style file
+void writeSyntheticFile(const std::string& path, size_t rows, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> myct(17, 1500), mem(64, 32000), cach(0, 256), chan(0, 52);
+    std::ofstream out(path);
+    for (size_t i = 0; i < rows; ++i) {
+        int a = myct(rng), b = mem(rng), c = b + mem(rng), d = cach(rng), e = chan(rng), f = e + chan(rng);
+        int prp = static_cast<int>(0.05 * b / 8 + 0.01 * c / 8 + 0.6 * d + 1.5 * f - 0.02 * a) + 10;
+        out << "vendor" << i % 7 << ",model" << i << "," << a << "," << b << "," << c << ","
+            << d << "," << e << "," << f << "," << prp << "," << prp << "\n";
+    }
+}
+
+// Reader thread -> compute thread -> writer thread
+size_t runThreadPerStage(const std::vector<std::string>& inputs,
+                         const std::vector<std::string>& outputs) {
+    SpscQueue<Job> loaded(4);
+    SpscQueue<Job> scored(4);
+    size_t succeeded = 0;
+
+    std::thread reader([&]() {
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            Job job;
+            job.index = i;
+            FileReader file;
+            if (file.open(inputs[i])) {
+                file.readAll(job.text);
+            }
+            loaded.push(std::move(job));
+        }
+        loaded.close();
+    });
+
+    std::thread compute([&]() {
+        Job job;
+        while (loaded.pop(job)) {
+            std::string report;
+            if (!AsyncWorkflow::trainAndScore(job.text, report)) {
+                report.clear();
+            }
+            job.text = std::move(report);
+            scored.push(std::move(job));
+        }
+        scored.close();
+    });
+
+    std::thread writer([&]() {
+        Job job;
+        while (scored.pop(job)) {
+            if (job.text.empty()) {
+                continue;
+            }
+            FileWriter file;
+            if (file.open(outputs[job.index]) && file.write(job.text) && file.close()) {
+                ++succeeded;
+            }
+        }
+    });
+
+    reader.join();
+    compute.join();
+    writer.join();
+    return succeeded;
+}
+
+bool readWhole(const std::string& path, std::string& content) {
+    FileReader file;
+    return file.open(path) && file.readAll(content);
+}
+
+int main(int argc, char* argv[]) {
+    size_t fileCount = argc > 1 ? std::stoul(argv[1]) : 32;
+    size_t rowsPerFile = argc > 2 ? std::stoul(argv[2]) : 20000;
+    int repeats = 3;
+
+    std::filesystem::path dirPath = std::filesystem::temp_directory_path() / "cpuperf_bench";
+    std::filesystem::create_directories(dirPath);
+    std::string dir = dirPath.string();
+
+    std::vector<std::string> inputs, stageOutputs, asyncOutputs;
+    for (size_t i = 0; i < fileCount; ++i) {
+        std::string base = dir + "/input" + std::to_string(i);
+        writeSyntheticFile(base + ".csv", rowsPerFile, static_cast<unsigned>(i + 1));
+        inputs.push_back(base + ".csv");
+        stageOutputs.push_back(base + ".stage.txt");
+        asyncOutputs.push_back(base + ".async.txt");
+    }
+
+    std::cout << "=== Async workflow benchmark ===" << std::endl;
+    std::cout << "Files: " << fileCount << ", rows per file: " << rowsPerFile
+              << ", hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    double bestStage = 1e30, bestAsync = 1e30;
+    size_t stageOk = 0, asyncOk = 0;
+    AsyncWorkflow workflow;
+    for (int r = 0; r < repeats; ++r) {
+        Clock::time_point start = Clock::now();
+        stageOk = runThreadPerStage(inputs, stageOutputs);
+        bestStage = std::min(bestStage, std::chrono::duration<double>(Clock::now() - start).count());
+
+        start = Clock::now();
+        asyncOk = workflow.processFiles(inputs, asyncOutputs);
+        bestAsync = std::min(bestAsync, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    // Both variants must produce byte-identical reports
+    size_t mismatches = 0;
+    for (size_t i = 0; i < fileCount; ++i) {
+        std::string a, b;
+        if (!readWhole(stageOutputs[i], a) || !readWhole(asyncOutputs[i], b) || a != b) {
+            ++mismatches;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Thread-per-stage: " << bestStage * 1000.0 << " ms (" << stageOk << " ok)" << std::endl;
+    std::cout << "Coroutines:       " << bestAsync * 1000.0 << " ms (" << asyncOk << " ok)" << std::endl;
+    std::cout << "Speedup:          " << bestStage / bestAsync << "x" << std::endl;
+    std::cout << "Report mismatches: " << mismatches << std::endl;
+
+    std::filesystem::remove_all(dirPath);
+
+    return mismatches == 0 ? 0 : 1;
+}
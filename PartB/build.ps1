@@ -14,16 +14,52 @@ $Executable = Join-Path $BinDir "cpu_performance_predictor.exe"
 
 # Compiler settings
 $CXX = "g++"
-$CXXFLAGS = @("-std=c++17", "-Wall", "-Wextra", "-O2")
+$CXXFLAGS = @("-std=c++17", "-Wall", "-Wextra", "-O2", "-pthread")
 $IncludeFlag = "-I$IncludeDir"
 
+# Per-level flags for the SIMD kernel variants
+$SimdFlags = @{
+    "SimdKernelsBaseline.cpp" = @();
+    "SimdKernelsSse42.cpp" = @("-msse4.2");
+    "SimdKernelsAvx2.cpp" = @("-mavx2");
+    "SimdKernelsAvx512.cpp" = @("-mavx512f", "-mavx512bw", "-mavx512dq", "-mavx512vl")
+}
+
 # Source files
 $SourceFiles = @(
     "DataPoint.cpp",
+    "CsvScanner.cpp",
+    "FileIO.cpp",
+    "NormalEquations.cpp",
+    "StreamingPipeline.cpp",
+    "MetricAccumulator.cpp",
+    "DistributedTrainer.cpp",
+    "SharedDataset.cpp",
+    "Numa.cpp",
+    "HugePages.cpp",
+    "AsyncWorkflow.cpp",
     "Matrix.cpp", 
+    "LUDecomposition.cpp",
+    "CholeskyDecomposition.cpp",
+    "ScoringKernel.cpp",
+    "Summation.cpp",
+    "ScanTuning.cpp",
+    "CpuDispatch.cpp",
+    "SimdKernelsBaseline.cpp",
+    "SimdKernelsSse42.cpp",
+    "SimdKernelsAvx2.cpp",
+    "SimdKernelsAvx512.cpp",
+    "SparseMatrix.cpp",
+    "IterativeSolver.cpp",
     "Dataset.cpp",
     "LinearRegression.cpp",
-    "Evaluator.cpp"
+    "MultiTargetRegression.cpp",
+    "RandomFourierFeatures.cpp",
+    "KernelRidgeRegression.cpp",
+    "Ensemble.cpp",
+    "Evaluator.cpp",
+    "DriftMonitor.cpp",
+    "cpuperf.cpp"
 )
 
 function Show-Help {
@@ -86,7 +122,18 @@ function Build-Project {
         
         Write-Host "Compiling $SourceFile..." -ForegroundColor Gray
         
-        $CompileArgs = $CXXFLAGS + @($IncludeFlag, "-c", $SourcePath, "-o", $ObjectPath)
+        # The coroutine workflow is the only C++20 translation unit
+        $FileFlags = $CXXFLAGS
+        if ($SourceFile -eq "AsyncWorkflow.cpp") {
+            $FileFlags = $CXXFLAGS + @("-std=c++20")
+        }
+        
+        # SIMD kernel variants, one per instruction-set level (see CpuDispatch.h)
+        if ($SimdFlags.ContainsKey($SourceFile)) {
+            $FileFlags = $CXXFLAGS + $SimdFlags[$SourceFile] + @("-ffp-contract=off")
+        }
+        
+        $CompileArgs = $FileFlags + @($IncludeFlag, "-c", $SourcePath, "-o", $ObjectPath)
         $Process = Start-Process -FilePath $CXX -ArgumentList $CompileArgs -Wait -PassThru -NoNewWindow
         
         if ($Process.ExitCode -ne 0) {
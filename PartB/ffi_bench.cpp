@@ -0,0 +1,182 @@
+#include "include/CpuDispatch.h"
+#include "include/cpuperf.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Cost of the C API boundary per batch size
+ *
+ * Scores the same float columns three ways for batch sizes from one row up:
+ * the dispatched column kernel called directly (the floor), the exported
+ * cpuperf_predict_batch() through the shared library (PLT call, argument
+ * checks, column pointers, kernel lookup) and the row-major double path
+ * cpuperf_predict() for comparison. Prints nanoseconds per call and per
+ * row and the boundary overhead per call, and checks every path returns
+ * the same predictions. A foreign runtime adds its own call cost on top
+ * (a cgo call, for instance), the same for every batch size. Given a model
+ * file, the batch path is timed again with drift monitoring on, using the
+ * baseline --save-model wrote next to it.
+ *
+ * Usage: ffi_bench [model file]   (default: train on Data/machine.data)
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+const int REPEATS = 5;
+// Rows scored per timing at every batch size, so small batches make many calls
+const size_t ROWS_PER_TIMING = 1 << 22;
+const size_t BATCH_SIZES[] = {1, 4, 16, 64, 256, 1024, 4096, 65536};
+
+template <typename Fn>
+double bestSeconds(Fn fn) {
+    double best = 1e300;
+    for (int r = 0; r < REPEATS; ++r) {
+        auto start = Clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+// Each window of n rows holds the n values of every column back to back, the
+// layout cpuperf_predict_batch takes
+std::vector<float> packWindows(const std::vector<float>& cols, size_t maxRows, size_t n) {
+    std::vector<float> packed(CPUPERF_FEATURES * maxRows);
+    for (size_t w = 0; w < maxRows / n; ++w) {
+        for (size_t j = 0; j < CPUPERF_FEATURES; ++j) {
+            std::copy_n(cols.data() + j * maxRows + w * n, n, packed.data() + w * CPUPERF_FEATURES * n + j * n);
+        }
+    }
+    return packed;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    cpuperf_model* model = argc > 1 ? cpuperf_model_load(argv[1])
+                                    : cpuperf_model_train("Data/machine.data", 0.0);
+    if (model == nullptr) {
+        std::cerr << "Error: " << cpuperf_last_error() << std::endl;
+        return 1;
+    }
+    double coefficients[CPUPERF_FEATURES];
+    cpuperf_model_coefficients(model, coefficients, CPUPERF_FEATURES);
+
+    // Integer-valued hardware features, as a column-major float block and row-major doubles
+    const size_t maxRows = BATCH_SIZES[sizeof(BATCH_SIZES) / sizeof(BATCH_SIZES[0]) - 1];
+    const double scale[CPUPERF_FEATURES] = {1500, 32000, 64000, 256, 52, 176};
+    std::vector<float> cols(CPUPERF_FEATURES * maxRows);
+    std::vector<double> rows(CPUPERF_FEATURES * maxRows);
+    for (size_t i = 0; i < maxRows; ++i) {
+        for (size_t j = 0; j < CPUPERF_FEATURES; ++j) {
+            double value = static_cast<double>(((i + 1) * (j + 7) * 2654435761ULL) % 1000003) / 1000003.0;
+            float feature = static_cast<float>(static_cast<long>(value * scale[j]));
+            cols[j * maxRows + i] = feature;
+            rows[i * CPUPERF_FEATURES + j] = feature;
+        }
+    }
+    std::vector<double> direct(maxRows), batch(maxRows), rowMajor(maxRows);
+    const CpuDispatch::Kernels& kernels = CpuDispatch::kernels();
+
+    std::cout << "=== C API boundary, " << CpuDispatch::levelName(kernels.level)
+              << " kernels (ns, best of " << REPEATS << ") ===" << std::endl;
+    std::cout << std::left << std::setw(8) << "rows" << std::right << std::setw(12) << "kernel/call"
+              << std::setw(12) << "batch/call" << std::setw(12) << "overhead" << std::setw(10) << "batch/row"
+              << std::setw(12) << "rows/call" << std::setw(10) << "rows/row" << std::endl;
+
+    bool ok = true;
+    std::vector<double> unmonitored;
+    for (size_t n : BATCH_SIZES) {
+        size_t calls = ROWS_PER_TIMING / n;
+        // Every call scores a fresh window of rows, as a service would pass them
+        size_t windows = maxRows / n;
+        // Both paths read the same packed buffer
+        std::vector<float> packed = packWindows(cols, maxRows, n);
+        double kernelSeconds = bestSeconds([&]() {
+            for (size_t c = 0; c < calls; ++c) {
+                size_t w = c % windows;
+                const float* columns[CPUPERF_FEATURES];
+                for (size_t j = 0; j < CPUPERF_FEATURES; ++j) {
+                    columns[j] = packed.data() + w * CPUPERF_FEATURES * n + j * n;
+                }
+                kernels.scoreColumns(coefficients, CPUPERF_FEATURES, 0.0, columns, n, direct.data() + w * n);
+            }
+        });
+        double batchSeconds = bestSeconds([&]() {
+            for (size_t c = 0; c < calls; ++c) {
+                size_t w = c % windows;
+                cpuperf_predict_batch(model, packed.data() + w * CPUPERF_FEATURES * n, n, batch.data() + w * n);
+            }
+        });
+        double rowSeconds = bestSeconds([&]() {
+            for (size_t c = 0; c < calls; ++c) {
+                size_t offset = (c % windows) * n;
+                cpuperf_predict(model, rows.data() + offset * CPUPERF_FEATURES, n, rowMajor.data() + offset);
+            }
+        });
+
+        unmonitored.push_back(batchSeconds);
+
+        size_t covered = std::min(calls, windows) * n;
+        bool same = std::equal(direct.begin(), direct.begin() + covered, batch.begin()) &&
+                    std::equal(direct.begin(), direct.begin() + covered, rowMajor.begin());
+        ok = ok && same;
+
+        double perCall = 1e9 / static_cast<double>(calls);
+        std::cout << std::left << std::setw(8) << n << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << kernelSeconds * perCall << std::setw(12) << batchSeconds * perCall
+                  << std::setw(12) << (batchSeconds - kernelSeconds) * perCall << std::setw(10)
+                  << std::setprecision(2) << batchSeconds * perCall / static_cast<double>(n)
+                  << std::setprecision(1) << std::setw(12) << rowSeconds * perCall << std::setw(10)
+                  << std::setprecision(2) << rowSeconds * perCall / static_cast<double>(n)
+                  << (same ? "" : "  MISMATCH") << std::endl;
+    }
+
+    // The same batch calls with every 64th row (the default) sampled for the drift monitor
+    std::string baselinePath = argc > 1 ? std::string(argv[1]) + ".baseline" : "";
+    if (baselinePath.empty()) {
+        std::cout << "\n(pass a model file written by --save-model to time drift monitoring)" << std::endl;
+    } else if (cpuperf_model_monitor_drift(model, baselinePath.c_str(), 0) != CPUPERF_OK) {
+        std::cerr << "Error: " << cpuperf_last_error() << std::endl;
+        ok = false;
+    } else {
+        std::cout << "\n=== cpuperf_predict_batch with drift monitoring, 1 row in 64 sampled (ns) ===" << std::endl;
+        std::cout << std::left << std::setw(8) << "rows" << std::right << std::setw(12) << "batch/call"
+                  << std::setw(12) << "monitored" << std::setw(12) << "overhead" << std::setw(10) << "per row"
+                  << std::endl;
+        for (size_t b = 0; b < unmonitored.size(); ++b) {
+            size_t n = BATCH_SIZES[b];
+            size_t calls = ROWS_PER_TIMING / n;
+            size_t windows = maxRows / n;
+            std::vector<float> packed = packWindows(cols, maxRows, n);
+            double monitoredSeconds = bestSeconds([&]() {
+                for (size_t c = 0; c < calls; ++c) {
+                    size_t w = c % windows;
+                    cpuperf_predict_batch(model, packed.data() + w * CPUPERF_FEATURES * n, n, batch.data() + w * n);
+                }
+            });
+            double perCall = 1e9 / static_cast<double>(calls);
+            double overhead = (monitoredSeconds - unmonitored[b]) * perCall;
+            std::cout << std::left << std::setw(8) << n << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(12) << unmonitored[b] * perCall << std::setw(12) << monitoredSeconds * perCall
+                      << std::setw(12) << overhead << std::setw(10) << std::setprecision(2)
+                      << overhead / static_cast<double>(n) << std::endl;
+        }
+        int drifted = 0;
+        double psi[CPUPERF_FEATURES], ks[CPUPERF_FEATURES];
+        cpuperf_drift_scores(model, psi, ks, CPUPERF_FEATURES, &drifted);
+        std::cout << "Drift of the benchmark rows: " << (drifted ? "yes" : "no") << " (MMAX PSI " << std::setprecision(3)
+                  << psi[2] << ", KS " << ks[2] << ")" << std::endl;
+    }
+
+    cpuperf_model_free(model);
+    std::cout << (ok ? "\nAll results match" : "\nResults DIFFER") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,435 @@
+#ifndef ASYNC_TASK_H
+#define ASYNC_TASK_H
+
+#if __cplusplus < 202002L
+#error "AsyncTask.h requires C++20 coroutines; include AsyncWorkflow.h from C++17 code"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Coroutine primitives for the asynchronous workflow
+ *
+ * Task<T>      - lazily started coroutine, resumed by whoever awaits it
+ * ThreadPool   - `co_await pool.schedule()` moves the coroutine onto a worker
+ * IoService    - dedicated I/O threads; reads/writes return an IoOperation that
+ *                starts immediately and resumes its awaiter on the compute pool
+ * whenAll      - await a vector of tasks, each of which should begin with
+ *                `co_await pool.schedule()` to run in parallel
+ * syncWait     - block a non-coroutine caller until a task completes
+ */
+
+template <typename T>
+class Task;
+
+namespace async_detail {
+
+// Resume the awaiting coroutine (symmetric transfer) when a task finishes
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        std::coroutine_handle<> continuation = handle.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr exception;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() { exception = std::current_exception(); }
+};
+
+// Fire-and-forget coroutine used by whenAll and syncWait
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+} // namespace async_detail
+
+template <typename T>
+class Task {
+public:
+    struct promise_type : async_detail::PromiseBase {
+        std::optional<T> value;
+
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        template <typename U>
+        void return_value(U&& result) {
+            value.emplace(std::forward<U>(result));
+        }
+    };
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle) handle.destroy();
+    }
+
+    // Awaiting starts the task; the awaiter resumes when it completes
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume() {
+        if (handle.promise().exception) {
+            std::rethrow_exception(handle.promise().exception);
+        }
+        return std::move(*handle.promise().value);
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+template <>
+class Task<void> {
+public:
+    struct promise_type : async_detail::PromiseBase {
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        void return_void() const noexcept {}
+    };
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle) handle.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    void await_resume() {
+        if (handle.promise().exception) {
+            std::rethrow_exception(handle.promise().exception);
+        }
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * @brief Fixed-size pool of worker threads resuming coroutines
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = 0) : stopping(false) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (unsigned i = 0; i < threads; ++i) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Queue a coroutine for resumption on a worker
+    void enqueue(std::coroutine_handle<> handle) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(handle);
+        }
+        ready.notify_one();
+    }
+
+    // co_await pool.schedule() continues the coroutine on a worker thread
+    auto schedule() {
+        struct ScheduleAwaiter {
+            ThreadPool* pool;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { pool->enqueue(handle); }
+            void await_resume() const noexcept {}
+        };
+        return ScheduleAwaiter{this};
+    }
+
+    size_t size() const { return workers.size(); }
+
+private:
+    void workerLoop() {
+        while (true) {
+            std::coroutine_handle<> handle;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [this]() { return stopping || !queue.empty(); });
+                if (queue.empty()) {
+                    return;  // stopping and drained
+                }
+                handle = queue.front();
+                queue.pop_front();
+            }
+            handle.resume();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::deque<std::coroutine_handle<>> queue;
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool stopping;
+};
+
+/**
+ * @brief Eagerly started I/O operation that can be awaited later
+ *
+ * await_resume() rethrows the operation's failure as std::runtime_error.
+ */
+template <typename T>
+class IoOperation {
+public:
+    struct State {
+        std::mutex mutex;
+        bool done = false;
+        std::optional<T> value;
+        std::string error;
+        std::coroutine_handle<> waiter;
+        ThreadPool* resumeOn = nullptr;
+
+        // Called from the I/O thread when the operation finishes
+        void complete(std::optional<T> result, std::string failure) {
+            std::coroutine_handle<> toResume;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                value = std::move(result);
+                error = std::move(failure);
+                done = true;
+                toResume = waiter;
+            }
+            if (toResume) {
+                resumeOn->enqueue(toResume);
+            }
+        }
+    };
+
+    explicit IoOperation(std::shared_ptr<State> state) : state(std::move(state)) {}
+
+    bool await_ready() const {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        return state->done;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->done) {
+            return false;  // finished in the meantime, continue inline
+        }
+        state->waiter = handle;
+        return true;
+    }
+
+    T await_resume() {
+        if (!state->value) {
+            throw std::runtime_error(state->error);
+        }
+        return std::move(*state->value);
+    }
+
+private:
+    std::shared_ptr<State> state;
+};
+
+/**
+ * @brief Dedicated I/O threads running FileReader/FileWriter operations
+ */
+class IoService {
+public:
+    IoService(ThreadPool& computePool, unsigned threads = 1);
+    ~IoService();
+
+    IoService(const IoService&) = delete;
+    IoService& operator=(const IoService&) = delete;
+
+    // Read a whole file; resumes the awaiter on the compute pool
+    IoOperation<std::string> readFile(const std::string& filename);
+
+    // Write (create/truncate) a file; yields the number of bytes written
+    IoOperation<size_t> writeFile(const std::string& filename, std::string content);
+
+private:
+    void post(std::function<void()> job);
+    void workerLoop();
+
+    ThreadPool& computePool;
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool stopping;
+};
+
+namespace async_detail {
+
+template <typename T>
+struct WhenAllState {
+    std::atomic<size_t> remaining;
+    std::coroutine_handle<> continuation;
+    std::vector<std::optional<T>> results;
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+};
+
+template <typename T>
+DetachedTask runAndSignal(Task<T>& task, size_t index, WhenAllState<T>& state) {
+    try {
+        state.results[index].emplace(co_await task);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(state.exceptionMutex);
+        if (!state.exception) {
+            state.exception = std::current_exception();
+        }
+    }
+    if (state.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        state.continuation.resume();
+    }
+}
+
+template <typename T>
+struct WhenAllAwaiter {
+    std::vector<Task<T>>& tasks;
+    WhenAllState<T>& state;
+
+    bool await_ready() const noexcept { return tasks.empty(); }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        state.continuation = handle;
+        // One extra count so the last finisher and this call cannot both resume
+        state.remaining.store(tasks.size() + 1, std::memory_order_relaxed);
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            runAndSignal(tasks[i], i, state);
+        }
+        return state.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct SyncEvent {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+
+    // Notify under the lock: the waiter may destroy the event as soon as it wakes
+    void set() {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        cv.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]() { return done; });
+    }
+};
+
+template <typename T>
+DetachedTask runAndNotify(Task<T>& task, std::optional<T>& result,
+                          std::exception_ptr& exception, SyncEvent& event) {
+    try {
+        result.emplace(co_await task);
+    } catch (...) {
+        exception = std::current_exception();
+    }
+    event.set();
+}
+
+} // namespace async_detail
+
+// Await all tasks; results are returned in the order of the input
+template <typename T>
+Task<std::vector<T>> whenAll(std::vector<Task<T>> tasks) {
+    async_detail::WhenAllState<T> state;
+    state.results.resize(tasks.size());
+    co_await async_detail::WhenAllAwaiter<T>{tasks, state};
+    if (state.exception) {
+        std::rethrow_exception(state.exception);
+    }
+    std::vector<T> results;
+    results.reserve(state.results.size());
+    for (std::optional<T>& value : state.results) {
+        results.push_back(std::move(*value));
+    }
+    co_return results;
+}
+
+// Block the calling (non-coroutine) thread until the task completes
+template <typename T>
+T syncWait(Task<T> task) {
+    std::optional<T> result;
+    std::exception_ptr exception;
+    async_detail::SyncEvent event;
+    async_detail::runAndNotify(task, result, exception, event);
+    event.wait();
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+    return std::move(*result);
+}
+
+#endif // ASYNC_TASK_H
@@ -0,0 +1,57 @@
+#ifndef ASYNC_WORKFLOW_H
+#define ASYNC_WORKFLOW_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Coroutine-driven load -> train -> cross-validate/report workflow
+ *
+ * Implemented with C++20 coroutines (AsyncTask.h) in AsyncWorkflow.cpp, which
+ * is the only translation unit built as C++20; this interface stays C++17 so
+ * the rest of the program can call it. File reads and writes run on a
+ * dedicated I/O thread and resume the waiting coroutine on the compute pool,
+ * so no compute thread blocks on I/O.
+ */
+class AsyncWorkflow {
+public:
+    struct Result {
+        bool success = false;
+        size_t rows = 0;
+        std::vector<double> coefficients;
+        double testRMSE = 0.0;
+        std::vector<double> foldRMSEs;
+        size_t reportBytes = 0;
+        double wallSeconds = 0.0;
+        std::string error;
+    };
+
+    // Constructor (0 compute threads = hardware concurrency)
+    explicit AsyncWorkflow(unsigned computeThreads = 0, unsigned ioThreads = 1);
+
+    // Destructor
+    ~AsyncWorkflow();
+
+    AsyncWorkflow(const AsyncWorkflow&) = delete;
+    AsyncWorkflow& operator=(const AsyncWorkflow&) = delete;
+
+    // Load and split the data, train, then run the cross-validation folds in
+    // parallel while the prediction report is being written
+    Result run(const std::string& dataPath, const std::string& reportPath, int folds = 5);
+
+    // Train on and write a prediction report for every input concurrently;
+    // returns the number of jobs that succeeded
+    size_t processFiles(const std::vector<std::string>& inputs,
+                        const std::vector<std::string>& outputs);
+
+    // Job body shared with the thread-per-stage benchmark baseline: fit on the
+    // CSV text and render coefficients plus per-row predictions
+    static bool trainAndScore(const std::string& csvText, std::string& report);
+
+private:
+    struct Runtime;
+    std::unique_ptr<Runtime> runtime;
+};
+
+#endif // ASYNC_WORKFLOW_H
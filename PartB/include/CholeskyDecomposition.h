@@ -0,0 +1,43 @@
+#ifndef CHOLESKY_DECOMPOSITION_H
+#define CHOLESKY_DECOMPOSITION_H
+
+#include "Matrix.h"
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Cholesky factorization A = L * L^T of a symmetric positive definite matrix
+ *
+ * Quadratic forms x^T A^(-1) x are ||L^(-1) x||^2, so a batch of them costs
+ * one forward substitution over the batch instead of a matrix-vector
+ * product per row. Throws std::runtime_error if A is not positive definite.
+ */
+class CholeskyDecomposition {
+private:
+    size_t n;
+    std::vector<double> lower;      // L, row-major (upper part is zero)
+
+public:
+    // Constructors
+    CholeskyDecomposition();
+    explicit CholeskyDecomposition(const Matrix& matrix);
+
+    // Getters
+    size_t size() const { return n; }
+    double at(size_t row, size_t col) const { return lower[row * n + col]; }
+
+    // In place L^(-1) on a batch stored column-wise: columns[j * rows + i]
+    // is component j of vector i
+    void solveLowerColumns(double* columns, size_t rows) const;
+
+    // x^T A^(-1) x for each row of a row-major batch (rows x n)
+    void quadraticForms(const double* batch, size_t rows, double* out) const;
+
+    // Solve A x = b
+    std::vector<double> solve(const std::vector<double>& b) const;
+
+    // Diagonal of A^(-1)
+    std::vector<double> inverseDiagonal() const;
+};
+
+#endif // CHOLESKY_DECOMPOSITION_H
@@ -0,0 +1,86 @@
+#ifndef CPU_DISPATCH_H
+#define CPU_DISPATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Runtime selection of the SIMD kernel variants
+ *
+ * The vector kernels (compensated reductions, sin/cos for random Fourier
+ * features, CSV structural classification, float column scoring for the C
+ * API) are compiled once per instruction-set level in their own translation
+ * units (SimdKernels*.cpp, each built with its own -m flags) and one table
+ * is chosen on first use from cpuid, so a generic -O2 binary runs the
+ * widest variant the host supports. CPUPERF_SIMD=baseline|sse4.2|avx2|avx512 caps the choice, e.g.
+ * to keep AVX-512 frequency licences off a host.
+ *
+ * Every level performs the same operations in the same order (the kernel
+ * units are built with -ffp-contract=off, so no multiply-add is fused, and
+ * the reductions always keep REDUCE_LANES running sums however many fit in
+ * one register), so results are bit-identical across levels and hosts.
+ */
+namespace CpuDispatch {
+
+enum Level { BASELINE, SSE42, AVX2, AVX512, LEVEL_COUNT };
+
+// Running sums kept by the reduction kernels, whatever the vector width
+const size_t REDUCE_LANES = 16;
+
+/**
+ * @brief Kernel table for one instruction-set level
+ */
+struct Kernels {
+    Level level;
+    size_t width;   // doubles per vector register
+
+    // Compensated sum of term(a[i], b[i]) over the longest prefix that is a
+    // multiple of REDUCE_LANES, prefetching `ahead` elements ahead (0 = off).
+    // Writes the REDUCE_LANES sums followed by their REDUCE_LANES errors to
+    // lanes and returns the number of elements consumed
+    using Reduce = size_t (*)(const double* a, const double* b, size_t n, size_t ahead, double* lanes);
+    Reduce values;
+    Reduce products;
+    Reduce squaredDifferences;
+    Reduce absoluteDifferences;
+
+    // Same for (a[i] - center)^2, with the center broadcast instead of read
+    using ReduceAbout = size_t (*)(const double* a, double center, size_t n, size_t ahead, double* lanes);
+    ReduceAbout squaredDeviations;
+
+    // sin and cos of n angles
+    void (*sinCos)(const double* angles, size_t n, double* sines, double* cosines);
+
+    // Delimiter and newline bitmaps of `blocks` consecutive 64-byte blocks
+    void (*classify)(const char* data, size_t blocks, char delimiter,
+                     uint64_t* delimiters, uint64_t* newlines);
+
+    // intercept + sum of coefficients[j] * columns[j][i] for n rows of float
+    // columns, the terms added in column order as in ScoringKernel
+    void (*scoreColumns)(const double* coefficients, size_t features, double intercept,
+                         const float* const* columns, size_t n, double* out);
+};
+
+// Highest level this CPU (and this build) supports
+Level detected();
+
+// Level in use: detected(), capped by CPUPERF_SIMD or setLevel()
+Level level();
+
+// Switch every kernel to another level; false (and no change) if the CPU
+// or the build does not support it. For benchmarks and tests
+bool setLevel(Level level);
+
+// Table for the level in use, or for a specific level (nullptr if unsupported)
+const Kernels& kernels();
+const Kernels* kernelsFor(Level level);
+
+const char* levelName(Level level);
+
+// CPU features, levels built and the selection, for --print-dispatch
+std::string describe();
+
+} // namespace CpuDispatch
+
+#endif // CPU_DISPATCH_H
@@ -0,0 +1,147 @@
+#ifndef CSV_SCANNER_H
+#define CSV_SCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Two-stage structural scanner for comma-separated input
+ *
+ * Stage 1 classifies the input 64 bytes at a time into delimiter and newline
+ * bitmaps (AVX-512, AVX2 or SSE compares picked at run time) and extracts the
+ * offsets of the set bits with a trailing-zero count. Stage 2 walks those
+ * offsets to hand out trimmed records and their fields without copying.
+ */
+class CsvScanner {
+public:
+    // Bytes classified per stage-1 step
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    // Bitmaps for one 64-byte block (bit i set if byte i matches)
+    struct Block {
+        uint64_t delimiters;
+        uint64_t newlines;
+    };
+
+    // A field inside the scanned buffer (not null-terminated)
+    struct Field {
+        const char* begin;
+        size_t length;
+    };
+
+    // Classify one block; `ptr` must have BLOCK_SIZE readable bytes
+    static Block classifyBlock(const char* ptr, char delimiter = ',');
+
+    // Stage 1: append the offset of every delimiter and newline in the buffer
+    static void findStructurals(const char* data, size_t length,
+                                std::vector<uint32_t>& offsets, char delimiter = ',');
+
+    // Stage 2: call fn(fields, count, lineNumber) for every non-blank record.
+    // Records are trimmed of surrounding whitespace and split on the delimiter;
+    // a trailing delimiter does not start a new field. Line numbers are 1-based
+    // and continue from firstLineNumber. Returns the number of lines consumed.
+    template <typename Fn>
+    static size_t forEachRecord(const char* data, size_t length, Fn&& fn,
+                                size_t firstLineNumber = 1, char delimiter = ',');
+
+    // Parse a decimal integer of at most 8 digits with an optional '-' sign.
+    // Returns false (leaving value untouched) for anything else so the caller
+    // can fall back to a general-purpose conversion.
+    static bool parseInt(const char* str, size_t length, int& value);
+
+private:
+    // Offsets are 32-bit, so stage 1 runs over windows of at most this size
+    static constexpr size_t MAX_WINDOW = size_t(1) << 26;
+
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    template <typename Fn>
+    static void emitRecord(const char* begin, const char* end, const uint32_t* commas,
+                           size_t commaCount, const char* window, std::vector<Field>& fields,
+                           size_t lineNumber, Fn& fn);
+};
+
+template <typename Fn>
+size_t CsvScanner::forEachRecord(const char* data, size_t length, Fn&& fn,
+                                 size_t firstLineNumber, char delimiter) {
+    std::vector<uint32_t> structurals;
+    std::vector<Field> fields;
+    size_t lineNumber = firstLineNumber;
+    size_t pos = 0;
+
+    while (pos < length) {
+        // Cut windows on a newline so no record straddles two of them
+        size_t windowLength = length - pos;
+        if (windowLength > MAX_WINDOW) {
+            windowLength = MAX_WINDOW;
+            while (windowLength > 0 && data[pos + windowLength - 1] != '\n') {
+                --windowLength;
+            }
+            if (windowLength == 0) {
+                windowLength = MAX_WINDOW;  // pathological line, split it
+            }
+        }
+
+        const char* window = data + pos;
+        structurals.clear();
+        findStructurals(window, windowLength, structurals, delimiter);
+
+        size_t lineStart = 0;
+        size_t firstComma = 0;
+        for (size_t s = 0; s < structurals.size(); ++s) {
+            uint32_t offset = structurals[s];
+            if (window[offset] != '\n') {
+                continue;
+            }
+            emitRecord(window + lineStart, window + offset, structurals.data() + firstComma,
+                       s - firstComma, window, fields, lineNumber, fn);
+            ++lineNumber;
+            lineStart = offset + 1;
+            firstComma = s + 1;
+        }
+
+        if (lineStart < windowLength) {
+            // Final line without a terminating newline
+            emitRecord(window + lineStart, window + windowLength,
+                       structurals.data() + firstComma, structurals.size() - firstComma,
+                       window, fields, lineNumber, fn);
+            ++lineNumber;
+        }
+
+        pos += windowLength;
+    }
+
+    return lineNumber - firstLineNumber;
+}
+
+template <typename Fn>
+void CsvScanner::emitRecord(const char* begin, const char* end, const uint32_t* commas,
+                            size_t commaCount, const char* window, std::vector<Field>& fields,
+                            size_t lineNumber, Fn& fn) {
+    while (begin < end && isSpace(*begin)) ++begin;
+    while (end > begin && isSpace(*(end - 1))) --end;
+    if (begin == end) {
+        return;  // blank line
+    }
+
+    fields.clear();
+    const char* fieldStart = begin;
+    for (size_t c = 0; c < commaCount; ++c) {
+        const char* comma = window + commas[c];
+        if (comma < begin || comma >= end) {
+            continue;  // inside the trimmed margin
+        }
+        fields.push_back({fieldStart, static_cast<size_t>(comma - fieldStart)});
+        fieldStart = comma + 1;
+    }
+    if (fieldStart < end) {
+        fields.push_back({fieldStart, static_cast<size_t>(end - fieldStart)});
+    }
+
+    fn(fields.data(), fields.size(), lineNumber);
+}
+
+#endif // CSV_SCANNER_H
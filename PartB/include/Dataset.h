@@ -2,6 +2,8 @@
 #define DATASET_H
 
 #include "DataPoint.h"
+#include "CsvScanner.h"
+#include "SparseMatrix.h"
 #include <vector>
 #include <string>
 #include <random>
@@ -13,6 +15,10 @@ class Dataset {
 private:
     std::vector<DataPoint> data;
     std::mt19937 rng;
+    
+    // Quiet datasets print nothing; the last error or skipped line is kept
+    bool quiet;
+    std::string lastError;
 
 public:
     // Constructor
@@ -24,6 +30,13 @@ public:
     // Load data from file
     bool loadFromFile(const std::string& filename);
     
+    // Parse CSV text already in memory (replaces current data)
+    bool loadFromBuffer(const std::string& buffer);
+    
+    // Silence load output (the C API reports through getLastError())
+    void setQuiet(bool value) { quiet = value; }
+    const std::string& getLastError() const { return lastError; }
+    
     // Get data
     const std::vector<DataPoint>& getData() const { return data; }
     std::vector<DataPoint>& getData() { return data; }
@@ -51,18 +64,28 @@ public:
     // Get feature matrix (X) and target vector (y)
     void getMatrices(std::vector<std::vector<double>>& X, std::vector<double>& y) const;
     
+    // Sparse design matrix: the 6 hardware features, optionally followed by
+    // one-hot vendor columns (vendor names returned in column order)
+    SparseMatrix getSparseDesign(bool oneHotVendors = false,
+                                 std::vector<std::string>* vendorNames = nullptr) const;
+    
     // Display statistics
     void displayStatistics() const;
     
     // Display first n data points
     void displaySample(size_t n = 5) const;
 
+    // Parse one scanned record; returns false on malformed input, with the
+    // warning printed or, when problem is given, stored there
+    static bool parseRecord(const CsvScanner::Field* fields, size_t count,
+                            size_t lineNumber, DataPoint& point, std::string* problem = nullptr);
+
 private:
-    // Helper function to parse CSV line
-    std::vector<std::string> parseLine(const std::string& line) const;
+    // Record an error; printed unless quiet
+    bool fail(const std::string& message);
     
     // Helper function to trim whitespace
-    std::string trim(const std::string& str) const;
+    static std::string trim(const std::string& str);
 };
 
 #endif // DATASET_H
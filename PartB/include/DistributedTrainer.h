@@ -0,0 +1,100 @@
+#ifndef DISTRIBUTED_TRAINER_H
+#define DISTRIBUTED_TRAINER_H
+
+#include "LinearRegression.h"
+#include "MetricAccumulator.h"
+#include "NormalEquations.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Settings for DistributedTrainer
+ */
+struct DistributedConfig {
+    size_t workers = 4;           // worker processes, one shard each
+    double trainRatio = 0.8;      // fraction of rows routed to training
+    double lambda = 0.0;          // ridge parameter (0 = ordinary least squares)
+    uint64_t seed = 42;           // seed of the per-row train/test assignment
+    size_t batchRows = 4096;      // rows per column batch inside a worker
+};
+
+/**
+ * @brief Data-parallel training and evaluation across local worker processes
+ *
+ * start() forks one worker per shard, each connected to the coordinator by a
+ * Unix socket pair. Worker k reads the lines that start in the k-th byte range
+ * of the file, routes every row to train or test by a hash of its byte offset
+ * (so the split does not depend on the worker count), and sends back the
+ * train and test NormalEquations. The coordinator merges them in worker
+ * order and solves. evaluate() sends coefficients to every worker, which
+ * scores its held-out rows into a MetricAccumulator and returns it; the
+ * workers stay up for further evaluate() calls until stop().
+ *
+ * Protocol: a 16-byte header (message type, worker index, payload length in
+ * doubles) followed by the payload. POSIX only; elsewhere start() fails.
+ */
+class DistributedTrainer {
+public:
+    // What one worker read and accumulated
+    struct WorkerReport {
+        int pid = 0;
+        uint64_t bytes = 0;
+        double trainRows = 0.0;
+        double testRows = 0.0;
+        double seconds = 0.0;     // shard read + parse + accumulate
+    };
+
+    struct Result {
+        std::vector<double> coefficients;
+        double trainRows = 0.0;
+        double testRows = 0.0;
+        double trainRMSE = 0.0;
+        MetricAccumulator test;
+        double wallSeconds = 0.0;
+        std::vector<WorkerReport> workers;
+    };
+
+    // Constructor (throws std::invalid_argument on a bad configuration)
+    DistributedTrainer();
+    explicit DistributedTrainer(const DistributedConfig& config);
+
+    // Stops the workers
+    ~DistributedTrainer();
+
+    DistributedTrainer(const DistributedTrainer&) = delete;
+    DistributedTrainer& operator=(const DistributedTrainer&) = delete;
+
+    // Spawn the workers on a file and gather their statistics
+    bool start(const std::string& filename);
+
+    // Solve on the merged training statistics
+    bool train(LinearRegression& model);
+
+    // Score every worker's held-out rows with these coefficients
+    bool evaluate(const std::vector<double>& coefficients, MetricAccumulator& metrics);
+
+    // Close the sockets and reap the workers; false if any worker failed
+    bool stop();
+
+    // start + train + evaluate + stop
+    bool run(const std::string& filename, LinearRegression& model);
+
+    // Results and merged statistics
+    const Result& getResult() const { return result; }
+    const NormalEquations& getTrainStatistics() const { return trainStats; }
+    const NormalEquations& getTestStatistics() const { return testStats; }
+
+    // Display per-worker counters and evaluation results
+    void displayResults() const;
+
+private:
+    DistributedConfig config;
+    NormalEquations trainStats;
+    NormalEquations testStats;
+    Result result;
+    std::vector<int> sockets;     // coordinator end, one per worker
+    std::vector<int> pids;
+};
+
+#endif // DISTRIBUTED_TRAINER_H
@@ -0,0 +1,184 @@
+#ifndef DRIFT_MONITOR_H
+#define DRIFT_MONITOR_H
+
+#include "Dataset.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Per-feature distribution summary captured at training time
+ *
+ * For every feature: row count, mean, variance and the fraction of rows
+ * between consecutive training quantiles (BINS equal-frequency bins; tied
+ * quantiles, common with integer features, collapse into one edge).
+ * DriftMonitor bins live rows on the same edges, so the bin counts double
+ * as a quantile sketch of the scoring stream.
+ */
+class DriftBaseline {
+public:
+    static constexpr size_t BINS = 20;
+
+    struct Feature {
+        double count = 0.0;
+        double mean = 0.0;
+        double variance = 0.0;
+        std::vector<double> edges;      // ascending; bin k holds (edges[k-1], edges[k]]
+        std::vector<double> fractions;  // edges.size() + 1 training fractions
+    };
+
+private:
+    std::vector<Feature> features;
+    bool quiet = false;               // no output; errors kept for getLastError()
+    mutable std::string lastError;
+
+    bool fail(const std::string& message) const;
+
+public:
+    // Summarize a row-major batch (count x featureCount), or a dataset's features
+    bool capture(const double* rows, size_t count, size_t featureCount);
+    bool capture(const Dataset& data);
+
+    size_t featureCount() const { return features.size(); }
+    const Feature& feature(size_t j) const { return features[j]; }
+
+    // Bin of a value on a feature's edges
+    static size_t binOf(const std::vector<double>& edges, double value);
+
+    // Plain-text summary (17 significant digits), written next to the model by --save-model
+    bool save(const std::string& filename) const;
+    bool load(const std::string& filename);
+
+    void setQuiet(bool value) { quiet = value; }
+    const std::string& getLastError() const { return lastError; }
+};
+
+/**
+ * @brief Settings for DriftMonitor
+ */
+struct DriftConfig {
+    size_t sampleStride = 64;       // every Nth scored row is sampled, rounded up to a power of two
+    size_t batchRows = 1024;        // sampled rows handed to the worker at once
+    size_t queueBatches = 8;        // batches waiting for the worker; further ones are dropped
+    size_t windowRows = 65536;      // sampled rows per window generation
+    size_t minWindowRows = 500;     // sampled rows needed before features are flagged
+    double psiThreshold = 0.25;     // PSI above this flags a feature
+    double ksAlpha = 0.05;          // significance of the two-sample KS critical value
+};
+
+/**
+ * @brief Feature drift of the scoring stream against a DriftBaseline
+ *
+ * observe() is called on the scoring path with the rows just scored. It
+ * takes one relaxed atomic add per call to pick every sampleStride-th row;
+ * only calls that hit a sampled row copy it into a preallocated pending
+ * batch under a short lock. Full batches go to a worker thread that folds
+ * them into the live sketches (mean/variance and counts on the baseline
+ * bins); when the worker falls behind, batches are dropped and counted
+ * rather than making scoring wait. The live sketches cover the last one to two windows of
+ * sampled rows: a full window becomes the previous generation and the
+ * older one is discarded.
+ *
+ * report() scores each feature with the population stability index over
+ * the baseline bins and the two-sample Kolmogorov-Smirnov statistic
+ * evaluated at the bin edges (a lower bound on the exact statistic), and
+ * flags the feature when PSI exceeds psiThreshold or KS exceeds its
+ * critical value at ksAlpha. Nothing is flagged until the window holds
+ * minWindowRows sampled rows: PSI over few rows is biased upwards.
+ * observe() and report() may be called from any number of threads.
+ */
+class DriftMonitor {
+public:
+    struct FeatureDrift {
+        double baselineMean = 0.0;
+        double baselineStdDev = 0.0;
+        double liveMean = 0.0;
+        double liveStdDev = 0.0;
+        double psi = 0.0;
+        double ks = 0.0;
+        double ksCritical = 0.0;
+        bool drifted = false;
+    };
+
+    struct Report {
+        uint64_t scoredRows = 0;     // rows passed to observe() since construction
+        uint64_t windowRows = 0;     // sampled rows behind the live sketches
+        uint64_t droppedRows = 0;    // sampled rows dropped with a full queue
+        std::vector<FeatureDrift> features;
+        bool judged = false;         // window holds minWindowRows sampled rows
+        bool drifted = false;
+    };
+
+    explicit DriftMonitor(const DriftBaseline& baseline, const DriftConfig& config = DriftConfig());
+    ~DriftMonitor();
+
+    DriftMonitor(const DriftMonitor&) = delete;
+    DriftMonitor& operator=(const DriftMonitor&) = delete;
+
+    // Rows just scored: row-major (count x featureCount), or float columns
+    void observe(const double* rows, size_t count);
+    void observeColumns(const float* const* columns, size_t count);
+
+    // Hand the pending sampled rows to the worker and wait until all are folded
+    void flush();
+
+    // Drift scores of the live window (flushes first)
+    Report report();
+
+    const DriftBaseline& getBaseline() const { return baseline; }
+    const DriftConfig& getConfig() const { return config; }
+
+    // Per-feature table of a report
+    static void display(const Report& report);
+
+private:
+    // Running moments and bin counts of one feature
+    struct Sketch {
+        double count = 0.0;
+        double mean = 0.0;
+        double m2 = 0.0;
+        std::vector<double> bins;
+
+        void merge(const Sketch& other);
+    };
+
+    DriftBaseline baseline;
+    DriftConfig config;
+    size_t featureCount;
+
+    alignas(64) std::atomic<uint64_t> scored;
+    std::atomic<uint64_t> dropped;
+
+    // Pending sampled rows, the batches queued for the worker and folded
+    // batch buffers kept for reuse
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::condition_variable queueIdle;
+    std::vector<double> pending;
+    size_t pendingRows;
+    std::deque<std::vector<double>> queue;
+    std::vector<std::vector<double>> spares;
+    bool folding;
+    bool stopping;
+
+    // Live window, written by the worker
+    std::mutex sketchMutex;
+    std::vector<Sketch> current;
+    std::vector<Sketch> previous;
+
+    std::thread worker;
+
+    std::vector<Sketch> emptySketches() const;
+    size_t firstSample(size_t count);
+    void enqueuePending(bool force);
+    void fold(const std::vector<double>& rows);
+    void run();
+};
+
+#endif // DRIFT_MONITOR_H
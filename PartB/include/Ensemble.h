@@ -0,0 +1,92 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include "Matrix.h"
+#include "Dataset.h"
+#include "KernelRidgeRegression.h"
+#include "ScoringKernel.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/**
+ * @brief Bagged and stacked regression ensembles with fused scoring
+ *
+ * Linear members are stored as the columns of one features x members
+ * matrix, so scoring every member on a batch is a single GEMM. Because the
+ * blend of linear members is itself linear, predict() folds the blend into
+ * one coefficient vector and costs one GEMV per batch plus any kernel
+ * members. Bagged members are trained in parallel, each from a weighted
+ * Gram matrix whose row weights are Poisson(1) bootstrap counts drawn from
+ * a per-member seed. Stacked ensembles combine ridge and kernel ridge
+ * members with non-negative blend weights fitted on out-of-fold predictions.
+ */
+class Ensemble {
+public:
+    enum class Kind { Bagged, Stacked };
+
+private:
+    Kind kind;
+    size_t features;
+    std::vector<std::string> memberNames;       // linear members, then kernel members
+    Matrix linearCoefficients;                  // features x linear members
+    std::vector<KernelRidgeRegression> kernelMembers;
+    std::vector<double> blendWeights;           // one per member
+    double blendIntercept;
+    std::vector<double> fusedCoefficients;      // linear members folded through the blend
+    ScoringKernel fusedScorer;                  // fusedCoefficients + blendIntercept
+    bool isTrained;
+
+    // Recompute fusedCoefficients (and its scoring kernel) from the members and blend weights
+    void fuse();
+
+public:
+    static const size_t BATCH_ROWS = 1024;
+
+    // Constructor
+    Ensemble();
+
+    // Destructor
+    ~Ensemble() = default;
+
+    // Bagging: `members` Poisson-bootstrap ridge fits averaged with equal weights
+    bool fitBagged(const Matrix& X, const std::vector<double>& y, size_t members = 32,
+                   double lambda = 0.0, uint64_t seed = 42);
+    bool fitBagged(const Dataset& trainData, size_t members = 32, double lambda = 0.0,
+                   uint64_t seed = 42);
+
+    // Stacking: one ridge member per lambda and one kernel ridge member per
+    // frequency count, blended on out-of-fold predictions
+    bool fitStacked(const Matrix& X, const std::vector<double>& y,
+                    const std::vector<double>& ridgeLambdas = {0.0, 1e3, 1e5},
+                    const std::vector<size_t>& kernelFrequencies = {128, 512},
+                    int folds = 5, uint64_t seed = 42);
+    bool fitStacked(const Dataset& trainData, int folds = 5, uint64_t seed = 42);
+
+    // Every member's prediction (n x members), one GEMM per row batch
+    Matrix predictMembers(const Matrix& X) const;
+
+    // Blended prediction
+    std::vector<double> predict(const Matrix& X) const;
+    std::vector<double> predict(const Dataset& data) const;
+
+    // Evaluate model performance
+    double calculateRMSE(const Dataset& data) const;
+
+    // Design matrix and PRP targets of a dataset
+    static Matrix createDesignMatrix(const Dataset& data);
+    static std::vector<double> createTargetVector(const Dataset& data);
+
+    // Getters
+    Kind getKind() const { return kind; }
+    size_t getMemberCount() const { return memberNames.size(); }
+    const std::vector<std::string>& getMemberNames() const { return memberNames; }
+    const std::vector<double>& getBlendWeights() const { return blendWeights; }
+    const std::vector<double>& getFusedCoefficients() const { return fusedCoefficients; }
+    bool getIsTrained() const { return isTrained; }
+
+    // Display model information
+    void displayModel() const;
+};
+
+#endif // ENSEMBLE_H
@@ -2,6 +2,7 @@
 #define EVALUATOR_H
 
 #include "LinearRegression.h"
+#include "MultiTargetRegression.h"
 #include "Dataset.h"
 #include <vector>
 #include <string>
@@ -38,6 +39,9 @@ public:
     // Generate detailed evaluation report
     void generateReport(const Dataset& testData, const std::string& filename = "") const;
     
+    // Write per-sample predictions as CSV (vendor, model, actual, predicted, residual)
+    bool exportPredictions(const Dataset& data, const std::string& filename) const;
+    
     // Residual analysis
     void residualAnalysis(const Dataset& testData) const;
     
@@ -51,6 +55,24 @@ public:
     
     // Display results in formatted way
     void displayResults(const EvaluationResults& results) const;
+    
+    // Metrics of one output of a multi-target model
+    struct TargetMetrics {
+        std::string name;
+        double rmse;
+        double mse;
+        double mae;
+        double rSquared;
+        double meanAbsolutePercentageError;
+    };
+    
+    // Per-target metrics from one batched predict over the test set; the
+    // dataset overload needs a model trained on the PRP and ERP columns,
+    // other target sets pass their design matrix and actual values (n x k)
+    static std::vector<TargetMetrics> evaluateTargets(const MultiTargetRegression& model, const Dataset& testData);
+    static std::vector<TargetMetrics> evaluateTargets(const MultiTargetRegression& model, const Matrix& X,
+                                                      const Matrix& actual);
+    static void displayTargetMetrics(const std::vector<TargetMetrics>& metrics);
 
 private:
     // Helper functions
@@ -0,0 +1,96 @@
+#ifndef FILE_IO_H
+#define FILE_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+class IoBackend;
+
+/**
+ * @brief Block-oriented file reader with several reads in flight
+ *
+ * On Linux the reads go through io_uring with registered buffers, so the next
+ * queueDepth blocks are being fetched while the caller parses the current one.
+ * Falls back to pread where io_uring is unavailable (or CPUPERF_IO_BACKEND=pread
+ * is set) and to iostreams on non-POSIX platforms.
+ */
+class FileReader {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+    static constexpr unsigned DEFAULT_QUEUE_DEPTH = 16;
+
+    // Constructor
+    FileReader(size_t blockSize = DEFAULT_BLOCK_SIZE, unsigned queueDepth = DEFAULT_QUEUE_DEPTH);
+
+    // Destructor
+    ~FileReader();
+
+    FileReader(const FileReader&) = delete;
+    FileReader& operator=(const FileReader&) = delete;
+
+    // Open / close
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const;
+
+    // Size of the open file in bytes
+    uint64_t fileSize() const { return size; }
+
+    // Name of the active backend ("io_uring", "pread" or "stream")
+    std::string backendName() const;
+
+    // Deliver the file in order, one block per call. Returning false from the
+    // consumer stops the read early. Returns false on I/O error.
+    bool readBlocks(const std::function<bool(const char*, size_t)>& consumer);
+
+    // Read the whole file into buffer
+    bool readAll(std::string& buffer);
+
+private:
+    std::unique_ptr<IoBackend> backend;
+    size_t blockSize;
+    unsigned queueDepth;
+    uint64_t size;
+};
+
+/**
+ * @brief Buffered file writer that keeps several block writes in flight
+ *
+ * Output is staged into fixed-size blocks which are submitted asynchronously
+ * (io_uring) or written with pwrite / iostreams as a fallback.
+ */
+class FileWriter {
+public:
+    // Constructor
+    FileWriter(size_t blockSize = FileReader::DEFAULT_BLOCK_SIZE,
+               unsigned queueDepth = FileReader::DEFAULT_QUEUE_DEPTH);
+
+    // Destructor (closes the file, flushing pending data)
+    ~FileWriter();
+
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    // Create or truncate the file
+    bool open(const std::string& filename);
+
+    // Append data
+    bool write(const char* data, size_t length);
+    bool write(const std::string& text) { return write(text.data(), text.size()); }
+
+    // Flush pending blocks, wait for them and close the file
+    bool close();
+
+    bool isOpen() const;
+    std::string backendName() const;
+
+private:
+    std::unique_ptr<IoBackend> backend;
+    size_t blockSize;
+    unsigned queueDepth;
+};
+
+#endif // FILE_IO_H
@@ -0,0 +1,89 @@
+#ifndef HUGE_PAGES_H
+#define HUGE_PAGES_H
+
+#include <cstddef>
+#include <new>
+#include <string>
+
+/**
+ * @brief 2 MB huge-page backing for large scan buffers
+ *
+ * allocate() returns 64-byte aligned memory. Requests of at least
+ * THRESHOLD bytes get their own mapping, rounded up to whole 2 MB pages
+ * and 2 MB aligned, and backed according to the mode:
+ *   OFF          ordinary 4 KB pages
+ *   TRANSPARENT  madvise(MADV_HUGEPAGE), so the kernel may use THP
+ *   EXPLICIT     MAP_HUGETLB from the reserved pool, falling back to
+ *                TRANSPARENT when the pool is empty
+ * The mode defaults to TRANSPARENT and is set by CPUPERF_HUGE_PAGES
+ * (off / transparent / explicit) or setMode(). Smaller requests, and all
+ * requests off Linux, use aligned operator new.
+ *
+ * coverage() reports how much of the large buffers was actually backed by
+ * huge pages: explicit mappings count in full, transparent ones are
+ * measured from /proc/self/smaps by coverage() itself, never on the
+ * allocation path. A released transparent buffer keeps the share last
+ * measured while it was live; one released before any coverage() call
+ * counts as unmeasured and is left out of share().
+ */
+namespace HugePages {
+
+enum Mode { OFF, TRANSPARENT, EXPLICIT };
+
+const size_t PAGE_BYTES = size_t(2) << 20;
+const size_t THRESHOLD = PAGE_BYTES;
+const size_t ALIGNMENT = 64;
+
+Mode mode();
+void setMode(Mode mode);
+const char* modeName(Mode mode);
+
+// Throws std::bad_alloc; deallocate needs the size passed to allocate
+void* allocate(size_t bytes);
+void deallocate(void* pointer, size_t bytes);
+
+// Large buffers allocated since start-up (released and live)
+struct Coverage {
+    size_t allocations = 0;
+    size_t bytes = 0;             // mapped bytes, whole 2 MB pages
+    size_t hugeBytes = 0;         // of which backed by huge pages
+    size_t explicitBytes = 0;     // of which from the MAP_HUGETLB pool
+    size_t fallbacks = 0;         // EXPLICIT requests served transparently
+    size_t unmeasuredBytes = 0;   // transparent, released before coverage() measured them
+
+    double share() const {
+        return bytes > unmeasuredBytes ? static_cast<double>(hugeBytes) / (bytes - unmeasuredBytes) : 0.0;
+    }
+};
+Coverage coverage();
+
+// One line for reports, e.g. "transparent, 12.0 of 16.0 MB in 3 buffers (75.0%)"
+// (measured bytes only; unmeasured ones are listed after the share)
+std::string describe(const Coverage& coverage);
+
+// Standard allocator over allocate()/deallocate()
+template <typename T>
+struct Allocator {
+    using value_type = T;
+
+    Allocator() = default;
+    template <typename U>
+    Allocator(const Allocator<U>&) {}
+
+    T* allocate(size_t count) {
+        if (count > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(HugePages::allocate(count * sizeof(T)));
+    }
+    void deallocate(T* pointer, size_t count) { HugePages::deallocate(pointer, count * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const Allocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const Allocator<U>&) const { return false; }
+};
+
+} // namespace HugePages
+
+#endif // HUGE_PAGES_H
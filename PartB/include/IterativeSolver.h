@@ -0,0 +1,41 @@
+#ifndef ITERATIVE_SOLVER_H
+#define ITERATIVE_SOLVER_H
+
+#include "SparseMatrix.h"
+#include <vector>
+
+/**
+ * @brief Jacobi-preconditioned conjugate gradient
+ *
+ * solve() handles a symmetric positive definite system held as a sparse
+ * matrix (e.g. SparseMatrix::gram()). solveLeastSquares() minimizes
+ * ||A x - b||^2 + lambda ||x||^2 without forming A^T A: every iteration
+ * applies A and A^T once, so it scales to designs whose Gram matrix would
+ * not fit in memory. Convergence is ||r|| <= tolerance * ||rhs||. The
+ * parallel sparse kernels of all iterations run on one Parallel::Team.
+ */
+class ConjugateGradient {
+public:
+    struct Result {
+        std::vector<double> solution;
+        int iterations = 0;
+        double relativeResidual = 0.0;
+        bool converged = false;
+    };
+
+    // Constructor
+    explicit ConjugateGradient(int maxIterations = 1000, double tolerance = 1e-10);
+
+    // Solve A x = b for symmetric positive definite A
+    Result solve(const SparseMatrix& A, const std::vector<double>& b) const;
+
+    // Solve (A^T A + lambda * I) x = A^T b using only A x and A^T x
+    Result solveLeastSquares(const SparseMatrix& A, const std::vector<double>& b,
+                             double lambda = 0.0) const;
+
+private:
+    int maxIterations;
+    double tolerance;
+};
+
+#endif // ITERATIVE_SOLVER_H
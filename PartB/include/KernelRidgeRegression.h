@@ -0,0 +1,78 @@
+#ifndef KERNEL_RIDGE_REGRESSION_H
+#define KERNEL_RIDGE_REGRESSION_H
+
+#include "Matrix.h"
+#include "Dataset.h"
+#include "RandomFourierFeatures.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/**
+ * @brief Approximate RBF kernel ridge regression on random Fourier features
+ *
+ * Inputs are standardized, mapped through z(x) and a ridge model is solved
+ * in feature space: (Z^T Z + lambda * I) w = Z^T (y - mean(y)). Rows are
+ * processed in batches of BATCH_ROWS, so memory is bounded by the
+ * (2m x 2m) Gram matrix plus one batch of features regardless of n.
+ * The saved model holds the seed instead of the frequency matrix.
+ */
+class KernelRidgeRegression {
+private:
+    RandomFourierFeatures featureMap;
+    size_t frequencies;
+    double lambda;
+    double gamma;                   // 0 selects 1 / inputs
+    uint64_t seed;
+    std::vector<double> mean;       // input standardization
+    std::vector<double> scale;
+    std::vector<double> weights;    // one per mapped feature
+    double intercept;
+    double trainRMSE;
+    bool isTrained;
+
+    // Standardize rows [begin, end) of X into a row-major buffer
+    void standardize(ConstMatrixView X, size_t begin, size_t end, std::vector<double>& batch) const;
+
+public:
+    static const size_t BATCH_ROWS = 1024;
+
+    // Constructor
+    KernelRidgeRegression(size_t frequencies = 512, double lambda = 1.0,
+                          double gamma = 0.0, uint64_t seed = 42);
+
+    // Destructor
+    ~KernelRidgeRegression() = default;
+
+    // Train on the 6 hardware features and PRP
+    bool fit(const Dataset& trainData);
+
+    // Train on an explicit design matrix (n x inputs) and targets
+    bool fit(ConstMatrixView X, const std::vector<double>& y);
+
+    // Batched predict
+    std::vector<double> predict(ConstMatrixView X) const;
+    std::vector<double> predict(const Dataset& data) const;
+    double predict(const DataPoint& point) const;
+
+    // Evaluate model performance
+    double calculateRMSE(const Dataset& data) const;
+
+    // Text model file: hyperparameters, seed, standardization and weights
+    bool save(const std::string& filename) const;
+    bool load(const std::string& filename);
+
+    // Getters
+    size_t getFrequencies() const { return frequencies; }
+    double getLambda() const { return lambda; }
+    double getGamma() const { return featureMap.getGamma(); }
+    uint64_t getSeed() const { return seed; }
+    const std::vector<double>& getWeights() const { return weights; }
+    double getTrainRMSE() const { return trainRMSE; }
+    bool getIsTrained() const { return isTrained; }
+
+    // Display model information
+    void displayModel() const;
+};
+
+#endif // KERNEL_RIDGE_REGRESSION_H
@@ -0,0 +1,53 @@
+#ifndef LU_DECOMPOSITION_H
+#define LU_DECOMPOSITION_H
+
+#include "Matrix.h"
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Partial-pivoted LU factorization P*A = L*U of a square matrix
+ *
+ * Factored once with a blocked right-looking elimination (panel, row-block
+ * triangular solve, trailing update), then reused for any number of solves,
+ * the determinant and the inverse. L (unit diagonal) and U share one
+ * row-major array. A pivot below 1e-10 in magnitude marks the matrix
+ * singular: determinant() returns 0 and the solves throw.
+ */
+class LUDecomposition {
+private:
+    size_t n;
+    std::vector<double> factors;       // L below, U on and above the diagonal
+    std::vector<size_t> permutation;   // row i of P*A is row permutation[i] of A
+    int swapSign;                      // (-1)^(number of row swaps)
+    bool singular;
+
+    static const size_t BLOCK_SIZE = 32;
+
+    void factorize();
+    void requireNonSingular() const;
+
+public:
+    // Factor a square matrix or a square view of one
+    explicit LUDecomposition(ConstMatrixView matrix);
+
+    // Getters
+    size_t size() const { return n; }
+    bool isSingular() const { return singular; }
+
+    // Solve A x = b
+    std::vector<double> solve(const std::vector<double>& b) const;
+
+    // Solve A X = B for every column of B at once
+    Matrix solveMany(ConstMatrixView B) const;
+
+    // det(A), log|det(A)| and the sign of det(A)
+    double determinant() const;
+    double logDeterminant() const;
+    int determinantSign() const;
+
+    // A^(-1)
+    Matrix inverse() const;
+};
+
+#endif // LU_DECOMPOSITION_H
@@ -3,21 +3,48 @@
 
 #include "Matrix.h"
 #include "Dataset.h"
+#include "NormalEquations.h"
+#include "SparseMatrix.h"
+#include "CholeskyDecomposition.h"
+#include "ScoringKernel.h"
 #include <vector>
+#include <string>
 
 /**
  * @brief Linear Regression class for CPU performance prediction
  * Implements PRP = x1*MYCT + x2*MMIN + x3*MMAX + x4*CACH + x5*CHMIN + x6*CHMAX
  */
 class LinearRegression {
+public:
+    // Point prediction with its standard error and two-sided interval
+    struct PredictionInterval {
+        double prediction;
+        double standardError;
+        double lower;
+        double upper;
+    };
+
 private:
-    std::vector<double> coefficients;  // Model parameters [x1, x2, x3, x4, x5, x6]
+    std::vector<double> coefficients;  // Model parameters [x1, ..., x6], one per column for sparse fits
     bool isTrained;
+    ScoringKernel scorer;              // batched predict, dispatched when coefficients change
     
     // Statistics
     double trainRMSE;
     double testRMSE;
     double rSquared;
+    
+    // Inference (unregularized fits only): Cholesky factor of X^T X and
+    // the residual variance estimate RSS / (n - p)
+    CholeskyDecomposition gramFactor;
+    double residualVariance;
+    double degreesOfFreedom;
+    std::vector<double> coefficientStandardErrors;
+    bool hasInference;
+    
+    // Quiet models print nothing; failures are still kept for getLastError()
+    bool quiet;
+    mutable std::string lastError;
 
 public:
     // Constructor
@@ -32,12 +59,32 @@ public:
     // Train with regularization (Ridge regression)
     bool trainWithRegularization(const Dataset& trainData, double lambda = 0.01);
     
+    // Train from streamed sufficient statistics (lambda > 0 gives Ridge)
+    bool trainFromNormalEquations(const NormalEquations& equations, double lambda = 0.0);
+    
+    // Train on a sparse n x p design: sparse Gram matrix and LU for narrow
+    // designs, conjugate gradient for wide ones (e.g. one-hot vendors). The
+    // model then scores p-column rows; predict(Dataset) needs p = 6.
+    bool trainSparse(const SparseMatrix& X, const std::vector<double>& y, double lambda = 0.0);
+    
     // Predict single value
     double predict(const DataPoint& point) const;
     double predict(const std::vector<double>& features) const;
     
     // Predict multiple values
     std::vector<double> predict(const Dataset& testData) const;
+    std::vector<double> predict(const Matrix& X) const;
+    void predictBatch(const double* rows, size_t count, double* out) const;
+    
+    // Standard errors and intervals for a batch (n x 6 design matrix). With
+    // forNewObservation the residual variance is added (prediction interval),
+    // otherwise the interval covers the fitted mean (confidence interval).
+    std::vector<PredictionInterval> predictIntervals(const Matrix& X, double confidence = 0.95,
+                                                     bool forNewObservation = true) const;
+    std::vector<PredictionInterval> predictIntervals(const Dataset& data, double confidence = 0.95,
+                                                     bool forNewObservation = true) const;
+    PredictionInterval predictInterval(const DataPoint& point, double confidence = 0.95,
+                                       bool forNewObservation = true) const;
     
     // Evaluate model performance
     double calculateRMSE(const Dataset& testData) const;
@@ -48,6 +95,27 @@ public:
     // Get model parameters
     const std::vector<double>& getCoefficients() const { return coefficients; }
     bool getIsTrained() const { return isTrained; }
+    bool getHasInference() const { return hasInference; }
+    double getResidualVariance() const { return residualVariance; }
+    double getDegreesOfFreedom() const { return degreesOfFreedom; }
+    const std::vector<double>& getCoefficientStandardErrors() const { return coefficientStandardErrors; }
+    std::vector<double> getTStatistics() const;
+    
+    // Two-sided Student t critical value for the given confidence level
+    static double tCriticalValue(double confidence, double degreesOfFreedom);
+    
+    // Write a self-contained C++ header with the coefficients as constexpr
+    // data and an unrolled predict() for the 6-feature schema
+    bool exportHeader(const std::string& filename, const std::string& namespaceName = "cpuperf_model") const;
+    
+    // Plain-text model file (coefficients with 17 significant digits), for
+    // --save-model and cpuperf_model_load()
+    bool save(const std::string& filename) const;
+    bool load(const std::string& filename);
+    
+    // Silence progress and error output (the C API reports through getLastError())
+    void setQuiet(bool value) { quiet = value; }
+    const std::string& getLastError() const { return lastError; }
     
     // Display model information
     void displayModel() const;
@@ -58,6 +126,9 @@ public:
 
 private:
     // Helper functions
+    bool fail(const std::string& message) const;
+    void computeInference(const Matrix& gram, double residualSumSquares, double rows);
+    void clearInference();
     Matrix createDesignMatrix(const Dataset& data) const;
     std::vector<double> createTargetVector(const Dataset& data) const;
     double calculateMean(const std::vector<double>& values) const;
@@ -1,13 +1,43 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include "MatrixView.h"
 #include <vector>
 #include <iostream>
 
+class LUDecomposition;
+
 /**
  * @brief Matrix class for linear algebra operations
  */
 class Matrix {
+public:
+    /**
+     * @brief Lazy A^T over a matrix or a view of one
+     *
+     * Holds a view of the source, so it must not outlive it. Products
+     * through the view walk the source row by row instead of forming A^T.
+     */
+    class TransposedView {
+    private:
+        ConstMatrixView source;
+
+    public:
+        explicit TransposedView(ConstMatrixView source) : source(source) {}
+
+        size_t getRows() const { return source.getCols(); }
+        size_t getCols() const { return source.getRows(); }
+        double operator()(size_t row, size_t col) const { return source(col, row); }
+        ConstMatrixView base() const { return source; }
+
+        // Copy out as a dense matrix (tiled when the source rows are contiguous)
+        Matrix materialize() const;
+
+        // A^T * B and A^T * v as sums of per-row outer products
+        Matrix operator*(ConstMatrixView other) const;
+        std::vector<double> operator*(const std::vector<double>& v) const;
+    };
+
 private:
     std::vector<std::vector<double>> data;
     size_t rows;
@@ -18,6 +48,7 @@ public:
     Matrix();
     Matrix(size_t rows, size_t cols);
     Matrix(const std::vector<std::vector<double>>& data);
+    explicit Matrix(ConstMatrixView view);
 
     // Copy constructor and assignment operator
     Matrix(const Matrix& other);
@@ -37,6 +68,17 @@ public:
     // Row access
     std::vector<double>& operator[](size_t row);
     const std::vector<double>& operator[](size_t row) const;
+    
+    // Non-owning views (MatrixView.h); any Matrix converts to a ConstMatrixView
+    MatrixView view() { return MatrixView(data.data(), rows, cols); }
+    ConstMatrixView view() const { return ConstMatrixView(data.data(), rows, cols); }
+    operator ConstMatrixView() const { return view(); }
+    MatrixView block(size_t row, size_t col, size_t rowCount, size_t colCount) { return view().block(row, col, rowCount, colCount); }
+    ConstMatrixView block(size_t row, size_t col, size_t rowCount, size_t colCount) const { return view().block(row, col, rowCount, colCount); }
+    MatrixView rowRange(size_t begin, size_t end) { return view().rowRange(begin, end); }
+    ConstMatrixView rowRange(size_t begin, size_t end) const { return view().rowRange(begin, end); }
+    MatrixView colRange(size_t begin, size_t end) { return view().colRange(begin, end); }
+    ConstMatrixView colRange(size_t begin, size_t end) const { return view().colRange(begin, end); }
 
     // Matrix operations
     Matrix operator+(const Matrix& other) const;
@@ -44,15 +86,27 @@ public:
     Matrix operator*(const Matrix& other) const;
     Matrix operator*(double scalar) const;
     
-    // Transpose
+    // A * B over views (operator* delegates here)
+    static Matrix multiply(ConstMatrixView a, ConstMatrixView b);
+    
+    // Transpose: cache-oblivious recursion down to SIMD 4x4 tiles
     Matrix transpose() const;
     
-    // Inverse (using Gaussian elimination)
+    // Transpose a square matrix in place
+    void transposeInPlace();
+    
+    // Lazy transpose for kernels that can consume it without a copy
+    TransposedView transposed() const { return TransposedView(view()); }
+    
+    // Inverse (from the LU factorization)
     Matrix inverse() const;
     
     // Determinant
     double determinant() const;
     
+    // Partial-pivoted LU factorization, reusable across solves (LUDecomposition.h)
+    LUDecomposition lu() const;
+    
     // Identity matrix
     static Matrix identity(size_t size);
     
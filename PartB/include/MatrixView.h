@@ -0,0 +1,136 @@
+#ifndef MATRIX_VIEW_H
+#define MATRIX_VIEW_H
+
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief Non-owning strided window onto the rows of a Matrix
+ *
+ * Element (i, j) of the view is element (rowOffset + i * rowStep,
+ * colOffset + j * colStep) of the source. Slicing returns another view and
+ * checks its bounds (std::out_of_range); element access does not. A view
+ * stays valid while the source is neither resized nor destroyed.
+ *
+ * Row is std::vector<double> for MatrixView (writable) and
+ * const std::vector<double> for ConstMatrixView.
+ */
+template <typename Row>
+class BasicMatrixView {
+public:
+    using Value = typename std::conditional<std::is_const<Row>::value, const double, double>::type;
+
+private:
+    Row* base;
+    size_t rowOffset;
+    size_t colOffset;
+    size_t rows;
+    size_t cols;
+    size_t rowStep;
+    size_t colStep;
+
+    template <typename Other> friend class BasicMatrixView;
+
+public:
+    BasicMatrixView() : base(nullptr), rowOffset(0), colOffset(0), rows(0), cols(0), rowStep(1), colStep(1) {}
+    BasicMatrixView(Row* base, size_t rows, size_t cols)
+        : base(base), rowOffset(0), colOffset(0), rows(rows), cols(cols), rowStep(1), colStep(1) {}
+    BasicMatrixView(Row* base, size_t rowOffset, size_t colOffset, size_t rows, size_t cols,
+                    size_t rowStep, size_t colStep)
+        : base(base), rowOffset(rowOffset), colOffset(colOffset), rows(rows), cols(cols),
+          rowStep(rowStep), colStep(colStep) {}
+
+    // A writable view converts to a read-only one
+    template <typename Other, typename = typename std::enable_if<
+                                  std::is_same<const Other, Row>::value && !std::is_same<Other, Row>::value>::type>
+    BasicMatrixView(const BasicMatrixView<Other>& other)
+        : base(other.base), rowOffset(other.rowOffset), colOffset(other.colOffset), rows(other.rows),
+          cols(other.cols), rowStep(other.rowStep), colStep(other.colStep) {}
+
+    // Getters
+    size_t getRows() const { return rows; }
+    size_t getCols() const { return cols; }
+    bool hasUnitColumnStep() const { return colStep == 1; }
+
+    // Same source, window and steps
+    template <typename Other>
+    bool sameWindow(const BasicMatrixView<Other>& other) const {
+        return static_cast<const void*>(base) == static_cast<const void*>(other.base) &&
+               rowOffset == other.rowOffset && colOffset == other.colOffset && rows == other.rows &&
+               cols == other.cols && rowStep == other.rowStep && colStep == other.colStep;
+    }
+
+    // Unchecked element access
+    Value& operator()(size_t row, size_t col) const {
+        return base[rowOffset + row * rowStep][colOffset + col * colStep];
+    }
+
+    // Start of row i; consecutive when hasUnitColumnStep()
+    Value* rowData(size_t row) const {
+        return base[rowOffset + row * rowStep].data() + colOffset;
+    }
+
+    // Sub-block of rowCount x colCount starting at (row, col)
+    BasicMatrixView block(size_t row, size_t col, size_t rowCount, size_t colCount) const {
+        if (row + rowCount > rows || col + colCount > cols) {
+            throw std::out_of_range("Matrix view block out of range");
+        }
+        return BasicMatrixView(base, rowOffset + row * rowStep, colOffset + col * colStep,
+                               rowCount, colCount, rowStep, colStep);
+    }
+
+    // Rows [begin, end), columns [begin, end)
+    BasicMatrixView rowRange(size_t begin, size_t end) const {
+        if (begin > end) {
+            throw std::out_of_range("Matrix view row range out of range");
+        }
+        return block(begin, 0, end - begin, cols);
+    }
+    BasicMatrixView colRange(size_t begin, size_t end) const {
+        if (begin > end) {
+            throw std::out_of_range("Matrix view column range out of range");
+        }
+        return block(0, begin, rows, end - begin);
+    }
+
+    // Single row (1 x cols) and single column (rows x 1)
+    BasicMatrixView row(size_t index) const { return block(index, 0, 1, cols); }
+    BasicMatrixView column(size_t index) const { return block(0, index, rows, 1); }
+
+    // Every rowStride-th row and colStride-th column, from the first
+    BasicMatrixView strided(size_t rowStride, size_t colStride) const {
+        if (rowStride == 0 || colStride == 0) {
+            throw std::invalid_argument("Matrix view stride must be positive");
+        }
+        return BasicMatrixView(base, rowOffset, colOffset, (rows + rowStride - 1) / rowStride,
+                               (cols + colStride - 1) / colStride, rowStep * rowStride, colStep * colStride);
+    }
+
+    // Writes through the view (MatrixView only)
+    void fill(double value) const {
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                (*this)(i, j) = value;
+            }
+        }
+    }
+
+    template <typename Other>
+    void copyFrom(const BasicMatrixView<Other>& source) const {
+        if (source.getRows() != rows || source.getCols() != cols) {
+            throw std::invalid_argument("Matrix view dimensions must match for copy");
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                (*this)(i, j) = source(i, j);
+            }
+        }
+    }
+};
+
+using MatrixView = BasicMatrixView<std::vector<double>>;
+using ConstMatrixView = BasicMatrixView<const std::vector<double>>;
+
+#endif // MATRIX_VIEW_H
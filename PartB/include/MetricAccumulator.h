@@ -0,0 +1,48 @@
+#ifndef METRIC_ACCUMULATOR_H
+#define METRIC_ACCUMULATOR_H
+
+#include "Summation.h"
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Mergeable regression metrics
+ *
+ * Keeps compensated sums of the squared and absolute errors, the targets,
+ * their squares and the absolute percentage errors, so that accumulators
+ * filled on disjoint rows (threads, processes) merge into exactly the
+ * metrics of the union. R-squared uses TSS = sum(y^2) - sum(y)^2 / n.
+ */
+class MetricAccumulator {
+private:
+    Summation::KahanBabuska count;
+    Summation::KahanBabuska sumSquaredErrors;
+    Summation::KahanBabuska sumAbsoluteErrors;
+    Summation::KahanBabuska sumActual;
+    Summation::KahanBabuska sumActualSquares;
+    Summation::KahanBabuska sumPercentageErrors;
+    Summation::KahanBabuska percentageCount;   // rows with a non-zero target
+
+public:
+    // Add one row, or a batch of rows
+    void add(double actual, double predicted);
+    void addBatch(const double* actual, const double* predicted, size_t rows);
+
+    // Combine with metrics gathered over other rows
+    void merge(const MetricAccumulator& other);
+
+    // Metrics of the accumulated rows (0 when empty)
+    double getCount() const { return count.value(); }
+    double getMSE() const;
+    double getRMSE() const;
+    double getMAE() const;
+    double getRSquared() const;
+    double getMAPE() const;
+
+    // Flat form for sending to another process; deserialize() throws
+    // std::invalid_argument on a length mismatch
+    std::vector<double> serialize() const;
+    static MetricAccumulator deserialize(const double* data, size_t length);
+};
+
+#endif // METRIC_ACCUMULATOR_H
@@ -0,0 +1,61 @@
+#ifndef MULTI_TARGET_REGRESSION_H
+#define MULTI_TARGET_REGRESSION_H
+
+#include "Matrix.h"
+#include "Dataset.h"
+#include <vector>
+#include <string>
+
+/**
+ * @brief Linear regression with several targets sharing one design matrix
+ *
+ * Solves (X^T X + lambda * I) B = X^T Y for all k columns of Y at once: the
+ * Gram matrix is built and LU-factored a single time and every target is a
+ * right-hand side of that factorization. B is features x k, so predicting a
+ * batch is one n x features by features x k product.
+ */
+class MultiTargetRegression {
+private:
+    size_t features;
+    std::vector<std::string> targetNames;
+    Matrix coefficients;                 // features x targets
+    std::vector<double> trainRMSE;       // per target
+    bool isTrained;
+
+public:
+    // Constructor (default targets: PRP and ERP of the dataset)
+    MultiTargetRegression();
+
+    // Destructor
+    ~MultiTargetRegression() = default;
+
+    // Train on the dataset's PRP and ERP columns
+    bool train(const Dataset& trainData, double lambda = 0.0);
+
+    // Train on an explicit design matrix (n x features) and targets (n x k)
+    bool train(const Matrix& X, const Matrix& Y, const std::vector<std::string>& names,
+               double lambda = 0.0);
+
+    // Predict every target for one data point
+    std::vector<double> predict(const DataPoint& point) const;
+
+    // Batched predict: n x features in, n x targets out
+    Matrix predict(const Matrix& X) const;
+    Matrix predict(const Dataset& data) const;
+
+    // Actual target values of a dataset (n x targets), matching predict()
+    static Matrix createTargetMatrix(const Dataset& data);
+    static Matrix createDesignMatrix(const Dataset& data);
+
+    // Getters
+    size_t getTargetCount() const { return targetNames.size(); }
+    const std::vector<std::string>& getTargetNames() const { return targetNames; }
+    std::vector<double> getCoefficients(size_t target) const;
+    const std::vector<double>& getTrainRMSE() const { return trainRMSE; }
+    bool getIsTrained() const { return isTrained; }
+
+    // Display model information
+    void displayModel() const;
+};
+
+#endif // MULTI_TARGET_REGRESSION_H
@@ -0,0 +1,70 @@
+#ifndef NORMAL_EQUATIONS_H
+#define NORMAL_EQUATIONS_H
+
+#include "Matrix.h"
+#include "Summation.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Sufficient statistics of a least-squares problem
+ *
+ * Accumulates X^T X, X^T y, y^T y, sum(y) and the (weighted) row count so
+ * that rows can be streamed in batches and partial results merged. The
+ * coefficients and the RSS/TSS of any coefficient vector follow from these
+ * without revisiting the data. Every statistic is a compensated running
+ * sum (Summation::KahanBabuska) and each batch adds compensated dot
+ * products, so the rounding error does not grow with the number of rows
+ * or batches.
+ */
+class NormalEquations {
+private:
+    size_t features;
+    std::vector<Summation::KahanBabuska> xtx;    // features x features, row-major
+    std::vector<Summation::KahanBabuska> xty;
+    Summation::KahanBabuska yty;
+    Summation::KahanBabuska sumY;
+    Summation::KahanBabuska count;               // sum of row weights
+
+public:
+    // Constructor
+    explicit NormalEquations(size_t features = 6);
+
+    // Add a single row
+    void addRow(const double* x, double y, double weight = 1.0);
+
+    // Add a batch stored column-wise (columns[j][i] is feature j of row i).
+    // weights may be null (all ones); rows with weight 0 are skipped.
+    void addColumns(const double* const* columns, const double* target, size_t rows,
+                    const double* weights = nullptr);
+
+    // Combine with statistics gathered over other rows
+    void merge(const NormalEquations& other);
+
+    // Reset to zero rows
+    void clear();
+
+    // Flat form for sending to another process: feature count, then the sum
+    // and compensation of every statistic. deserialize() throws
+    // std::invalid_argument if the length does not match the feature count.
+    std::vector<double> serialize() const;
+    static NormalEquations deserialize(const double* data, size_t length);
+
+    // Solve (X^T X + lambda * I) theta = X^T y
+    std::vector<double> solve(double lambda = 0.0) const;
+
+    // Residual and total sum of squares for the accumulated rows
+    double residualSumSquares(const std::vector<double>& coefficients) const;
+    double totalSumSquares() const;
+
+    // Getters
+    size_t getFeatures() const { return features; }
+    double getCount() const { return count.value(); }
+    double getYty() const { return yty.value(); }
+    double getSumY() const { return sumY.value(); }
+    std::vector<double> getXty() const;
+    Matrix getGram() const;
+};
+
+#endif // NORMAL_EQUATIONS_H
@@ -0,0 +1,66 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief NUMA topology, thread pinning and page placement
+ *
+ * The topology comes from /sys/devices/system/node, restricted to the CPUs
+ * this process may run on; without it (or off Linux) there is one node
+ * holding every CPU and placement calls are no-ops that report false.
+ * Page placement uses the mbind system call directly, so no libnuma is
+ * needed.
+ *
+ * cpuForBlock() maps block b of a parallel loop to a CPU such that
+ * consecutive blocks share a node and the nodes get equal numbers of
+ * blocks. Memory first touched by block b therefore sits on the node that
+ * block b scans from, as long as both loops use the same partition and
+ * pinning (see Parallel::setPinning).
+ */
+namespace Numa {
+
+// Nodes with at least one usable CPU, and their CPUs
+size_t nodeCount();
+const std::vector<int>& nodeCpus(size_t node);
+
+// Node and CPU of block `block` out of `blocks`
+size_t nodeForBlock(size_t block, size_t blocks);
+int cpuForBlock(size_t block, size_t blocks);
+
+// Restrict the calling thread to one CPU; false if unsupported
+bool pinCurrentThread(int cpu);
+
+// Pins the calling thread for its lifetime, then restores the old affinity
+class ScopedPin {
+public:
+    explicit ScopedPin(int cpu);
+    ~ScopedPin();
+
+    ScopedPin(const ScopedPin&) = delete;
+    ScopedPin& operator=(const ScopedPin&) = delete;
+
+private:
+    std::vector<int> previous;   // CPUs allowed before pinning
+    bool pinned;
+};
+
+// Memory whose pages are placed on first touch: HugePages::allocate, so
+// buffers of 2 MB and more are their own mapping and, with huge pages,
+// are placed in 2 MB units
+void* allocatePages(size_t bytes);
+void freePages(void* pages, size_t bytes);
+
+// Policies for the whole pages inside [address, address + bytes); take
+// effect for pages not yet touched
+bool bindToNode(void* address, size_t bytes, size_t node);
+bool interleave(void* address, size_t bytes);
+
+// Index (as for nodeCpus) of the node holding the touched page at
+// `address`; -1 if unknown
+int nodeOfAddress(const void* address);
+
+} // namespace Numa
+
+#endif // NUMA_H
@@ -0,0 +1,333 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "Numa.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Minimal fork-join helpers for the numeric kernels
+ *
+ * parallelFor splits [0, count) into contiguous blocks of at least `grain`
+ * items, one block per worker, and calls fn(block, begin, end) for each.
+ * Block 0 runs on the calling thread. The worker count defaults to the
+ * hardware concurrency and can be overridden with CPUPERF_THREADS.
+ *
+ * With pinning on (CPUPERF_PIN_THREADS=1 or setPinning), block b runs on
+ * Numa::cpuForBlock(b, blocks): two loops over the same count and grain put
+ * each block on the same CPU, so memory the first loop touches is local to
+ * the thread of the second. NodeLocalArray packages that pattern.
+ *
+ * An exception thrown by a block is rethrown on the calling thread once
+ * every block has finished (the lowest block's, if several throw).
+ *
+ * Each parallelFor starts its own threads. Loops that call the kernels
+ * many times (iterative solvers) open a Team::Scope so the calls share one
+ * set of workers instead.
+ */
+namespace Parallel {
+
+// Number of worker threads the kernels may use
+inline unsigned threadCount() {
+    static const unsigned count = []() {
+        unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+        if (const char* env = std::getenv("CPUPERF_THREADS")) {
+            long requested = std::strtol(env, nullptr, 10);
+            if (requested > 0) {
+                return static_cast<unsigned>(requested);
+            }
+        }
+        return hardware;
+    }();
+    return count;
+}
+
+// Whether parallelFor pins blocks to CPUs
+inline std::atomic<bool>& pinningFlag() {
+    static std::atomic<bool> flag([]() {
+        const char* env = std::getenv("CPUPERF_PIN_THREADS");
+        return env != nullptr && std::strtol(env, nullptr, 10) > 0;
+    }());
+    return flag;
+}
+
+inline bool pinning() { return pinningFlag().load(std::memory_order_relaxed); }
+inline void setPinning(bool enabled) { pinningFlag().store(enabled, std::memory_order_relaxed); }
+
+// Number of blocks parallelFor will use for `count` items
+inline size_t blockCount(size_t count, size_t grain) {
+    if (count == 0) {
+        return 0;
+    }
+    size_t byGrain = (count + std::max<size_t>(grain, 1) - 1) / std::max<size_t>(grain, 1);
+    return std::max<size_t>(1, std::min<size_t>(threadCount(), byGrain));
+}
+
+class Team;
+
+// Rethrow the first captured exception, if any
+inline void rethrowFirst(const std::vector<std::exception_ptr>& errors) {
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+// Team that parallelFor on this thread hands its blocks to, if any
+inline Team*& activeTeam() {
+    thread_local Team* team = nullptr;
+    return team;
+}
+
+/**
+ * @brief Worker threads kept alive across parallelFor calls
+ *
+ * While a Scope is open, parallelFor calls made on that thread run block 0
+ * themselves and hand block b to worker b, pinned as a fresh thread would
+ * be. Workers start on first use, so a team around loops that never split
+ * costs nothing. Calls made from inside a block start their own threads as
+ * usual.
+ */
+class Team {
+public:
+    Team() = default;
+
+    ~Team() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    Team(const Team&) = delete;
+    Team& operator=(const Team&) = delete;
+
+    // Routes parallelFor on the calling thread to `team` for its lifetime
+    class Scope {
+    public:
+        explicit Scope(Team& team) : previous(activeTeam()) { activeTeam() = &team; }
+        ~Scope() { activeTeam() = previous; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Team* previous;
+    };
+
+    // block(b) for every b < blocks, block 0 on the caller; false (nothing
+    // run) if the team is already inside a loop. Rethrows the first
+    // exception of any block once all of them have finished.
+    bool run(size_t blocks, const std::function<void(size_t)>& block) {
+        if (busy.exchange(true)) {
+            return false;
+        }
+        struct Release {
+            std::atomic<bool>& flag;
+            ~Release() { flag.store(false); }
+        } release{busy};
+
+        std::vector<std::exception_ptr> errors(blocks);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            while (workers.size() + 1 < blocks) {
+                size_t index = workers.size() + 1;
+                workers.emplace_back([this, index, seen = generation]() { work(index, seen); });
+            }
+            job = &block;
+            jobErrors = &errors;
+            jobBlocks = blocks;
+            pending = blocks - 1;
+            ++generation;
+        }
+        wake.notify_all();
+        try {
+            block(0);
+        } catch (...) {
+            errors[0] = std::current_exception();
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [this]() { return pending == 0; });
+            job = nullptr;
+            jobErrors = nullptr;
+        }
+        rethrowFirst(errors);
+        return true;
+    }
+
+private:
+    void work(size_t index, size_t seen) {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            if (job == nullptr || index >= jobBlocks) {
+                continue;
+            }
+            const std::function<void(size_t)>& block = *job;
+            std::exception_ptr& error = (*jobErrors)[index];
+            lock.unlock();
+            try {
+                block(index);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (--pending == 0) {
+                finished.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers;   // worker w - 1 runs block w
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    const std::function<void(size_t)>* job = nullptr;
+    std::vector<std::exception_ptr>* jobErrors = nullptr;   // one per block of job
+    size_t jobBlocks = 0;
+    size_t pending = 0;
+    size_t generation = 0;
+    bool stopping = false;
+    std::atomic<bool> busy{false};
+};
+
+// Run fn(block, begin, end) over contiguous blocks of [0, count)
+template <typename Fn>
+void parallelFor(size_t count, size_t grain, Fn fn) {
+    size_t blocks = blockCount(count, grain);
+    if (blocks <= 1) {
+        if (count > 0) {
+            fn(size_t(0), size_t(0), count);
+        }
+        return;
+    }
+
+    size_t perBlock = (count + blocks - 1) / blocks;
+    bool pinned = pinning();
+    auto runBlock = [&fn, count, perBlock, blocks, pinned](size_t b) {
+        size_t begin = std::min(count, b * perBlock);
+        size_t end = std::min(count, begin + perBlock);
+        if (!pinned) {
+            fn(b, begin, end);
+        } else if (b == 0) {
+            Numa::ScopedPin pin(Numa::cpuForBlock(0, blocks));
+            fn(b, begin, end);
+        } else {
+            Numa::pinCurrentThread(Numa::cpuForBlock(b, blocks));
+            fn(b, begin, end);
+        }
+    };
+
+    Team* team = activeTeam();
+    if (team != nullptr && team->run(blocks, runBlock)) {
+        return;
+    }
+
+    // Blocks whose thread could not be started run on the caller
+    std::vector<std::exception_ptr> errors(blocks);
+    auto guardedBlock = [&runBlock, &errors](size_t b) {
+        try {
+            runBlock(b);
+        } catch (...) {
+            errors[b] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    size_t started = 1;
+    try {
+        workers.reserve(blocks - 1);
+        for (; started < blocks; ++started) {
+            workers.emplace_back([&guardedBlock, started]() { guardedBlock(started); });
+        }
+    } catch (...) {
+    }
+    guardedBlock(0);
+    for (size_t b = started; b < blocks; ++b) {
+        guardedBlock(b);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    rethrowFirst(errors);
+}
+
+/**
+ * @brief Array whose pages live on the node of the block that scans them
+ *
+ * The storage is untouched anonymous pages; the constructor initializes it
+ * with parallelFor(count, grain), so every page is first touched (or, with
+ * BIND, explicitly bound) by the block that owns it. forEachBlock() runs a
+ * loop with the same partition. Placement only holds with pinning on;
+ * without it the array behaves like an ordinary parallel-initialized buffer.
+ * T must be trivially destructible.
+ */
+template <typename T>
+class NodeLocalArray {
+    static_assert(std::is_trivially_destructible<T>::value, "NodeLocalArray never runs destructors");
+
+public:
+    enum Placement { FIRST_TOUCH, BIND };
+
+    NodeLocalArray(size_t count, size_t grain, Placement placement = FIRST_TOUCH, const T& value = T())
+        : values(nullptr), count(count), grain(grain), bytes(count * sizeof(T)) {
+        values = static_cast<T*>(Numa::allocatePages(bytes));
+        if (values == nullptr && count > 0) {
+            throw std::bad_alloc();
+        }
+        size_t blocks = blockCount(count, grain);
+        parallelFor(count, grain, [&](size_t block, size_t begin, size_t end) {
+            if (placement == BIND) {
+                Numa::bindToNode(values + begin, (end - begin) * sizeof(T), Numa::nodeForBlock(block, blocks));
+            }
+            std::fill(values + begin, values + end, value);
+        });
+    }
+
+    ~NodeLocalArray() { Numa::freePages(values, bytes); }
+
+    NodeLocalArray(const NodeLocalArray&) = delete;
+    NodeLocalArray& operator=(const NodeLocalArray&) = delete;
+
+    T* data() { return values; }
+    const T* data() const { return values; }
+    size_t size() const { return count; }
+    T& operator[](size_t index) { return values[index]; }
+    const T& operator[](size_t index) const { return values[index]; }
+
+    // fn(block, begin, end) over the partition the pages were placed by
+    template <typename Fn>
+    void forEachBlock(Fn fn) const {
+        parallelFor(count, grain, fn);
+    }
+
+private:
+    T* values;
+    size_t count;
+    size_t grain;
+    size_t bytes;
+};
+
+} // namespace Parallel
+
+#endif // PARALLEL_H
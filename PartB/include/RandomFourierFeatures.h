@@ -0,0 +1,49 @@
+#ifndef RANDOM_FOURIER_FEATURES_H
+#define RANDOM_FOURIER_FEATURES_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Random Fourier feature map approximating the RBF kernel
+ *
+ * k(x, y) = exp(-gamma * ||x - y||^2) is approximated by z(x)^T z(y) with
+ * z(x) = sqrt(1/m) * [cos(w_1.x) .. cos(w_m.x), sin(w_1.x) .. sin(w_m.x)]
+ * and w_j ~ N(0, 2 * gamma * I). The frequencies are regenerated from the
+ * seed with a portable generator (splitmix64 + Box-Muller), so a model only
+ * needs to store the seed to rebuild the same map.
+ *
+ * transform() works on a batch and writes the output column by column:
+ * each frequency's projections are computed for the whole batch and then
+ * passed through the vectorized sin/cos kernel.
+ */
+class RandomFourierFeatures {
+private:
+    size_t inputs;
+    size_t frequencies;
+    double gamma;
+    uint64_t seed;
+    std::vector<double> weights;    // frequencies x inputs, row-major
+
+public:
+    // Constructor
+    RandomFourierFeatures();
+    RandomFourierFeatures(size_t inputs, size_t frequencies, double gamma, uint64_t seed);
+
+    // Getters
+    size_t getInputs() const { return inputs; }
+    size_t getFrequencies() const { return frequencies; }
+    size_t getOutputs() const { return 2 * frequencies; }
+    double getGamma() const { return gamma; }
+    uint64_t getSeed() const { return seed; }
+
+    // Map a row-major batch (rows x inputs) to column-major features:
+    // out[c * rows + i] is feature c of row i, for c < getOutputs()
+    void transform(const double* batch, size_t rows, std::vector<double>& out) const;
+
+    // Vectorized sin and cos of n angles (AVX-512 / AVX2 / SSE, picked at run time)
+    static void sinCos(const double* angles, size_t n, double* sines, double* cosines);
+};
+
+#endif // RANDOM_FOURIER_FEATURES_H
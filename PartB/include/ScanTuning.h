@@ -0,0 +1,72 @@
+#ifndef SCAN_TUNING_H
+#define SCAN_TUNING_H
+
+#include <cstddef>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Software prefetch and streaming-store settings per scan kernel
+ *
+ * Each kernel that streams through memory reads its settings once per
+ * call: prefetchBytes is how far ahead of the current position it issues
+ * prefetches (0 leaves it to the hardware prefetcher), and streamingStores
+ * writes its output with non-temporal stores that bypass the caches, for
+ * bulk outputs that will not be reread soon. PREDICT and METRICS prefetch
+ * 4 KB ahead by default, GRAM does not prefetch, and streaming stores are
+ * off (scan_bench measures the alternatives). Settings are changed per
+ * kernel with set() or CPUPERF_PREFETCH_<KERNEL>=<bytes> (0 = off) and
+ * CPUPERF_STREAM_<KERNEL>=1, where <KERNEL> is PREDICT, METRICS or GRAM.
+ * Only PREDICT writes a bulk output, so only it honours streamingStores.
+ */
+namespace ScanTuning {
+
+enum Kernel { PREDICT, METRICS, GRAM, KERNEL_COUNT };
+
+// Value-initialized: no prefetching, ordinary stores
+struct Settings {
+    size_t prefetchBytes = 0;
+    bool streamingStores = false;
+};
+
+Settings get(Kernel kernel);
+void set(Kernel kernel, const Settings& settings);
+const char* kernelName(Kernel kernel);
+
+// Read prefetch into all cache levels; a no-op where unsupported
+inline void prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    (void)address;
+#endif
+}
+
+// Copy with non-temporal stores where available; call fence() before the
+// data is handed to another thread
+inline void streamCopy(double* destination, const double* source, size_t count) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i < count && (reinterpret_cast<size_t>(destination + i) & 15) != 0; ++i) {
+        destination[i] = source[i];
+    }
+    for (; i + 2 <= count; i += 2) {
+        _mm_stream_pd(destination + i, _mm_loadu_pd(source + i));
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = source[i];
+    }
+}
+
+inline void fence() {
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
+}
+
+} // namespace ScanTuning
+
+#endif // SCAN_TUNING_H
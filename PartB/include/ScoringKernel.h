@@ -0,0 +1,61 @@
+#ifndef SCORING_KERNEL_H
+#define SCORING_KERNEL_H
+
+#include "Matrix.h"
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Batched linear scoring specialized on the feature count
+ *
+ * The kernel is chosen once, when the coefficients are set: feature counts
+ * 1..MAX_SPECIALIZED map to template instantiations with the column loop
+ * fully unrolled and the coefficients copied into locals shared by four
+ * interleaved rows. Past that the unrolled bodies measured slower than the
+ * plain row loop, so models up to MAX_ROW_LOOP features use scoreGeneric
+ * and wider ones a blocked GEMV. Every path adds the terms of a row in
+ * column order, starting from the intercept, so results match the scalar
+ * loop bit for bit.
+ */
+class ScoringKernel {
+public:
+    static constexpr size_t MAX_SPECIALIZED = 16;
+    static constexpr size_t MAX_ROW_LOOP = 256;
+
+    // Kernel signature: coefficients, feature count, intercept, row-major
+    // batch (count x features), output
+    using Kernel = void (*)(const double*, size_t, double, const double*, size_t, double*);
+
+private:
+    std::vector<double> coefficients;
+    double intercept;
+    Kernel kernel;
+
+public:
+    // Constructors
+    ScoringKernel();
+    explicit ScoringKernel(const std::vector<double>& coefficients, double intercept = 0.0);
+
+    // Getters
+    size_t featureCount() const { return coefficients.size(); }
+    double getIntercept() const { return intercept; }
+    bool isSpecialized() const;
+    const char* kernelName() const;   // "unrolled", "generic" or "blocked"
+
+    // intercept + x . coefficients for each row of a row-major batch, on the calling
+    // thread; honours the ScanTuning::PREDICT prefetch and streaming-store settings
+    void score(const double* rows, size_t count, double* out) const;
+
+    // Same over float feature columns (columns[j][i] is feature j of row i), read in
+    // place and vectorized across rows by the CpuDispatch kernel; calling thread only
+    void scoreColumns(const float* const* columns, size_t count, double* out) const;
+
+    // Same for a design matrix or view; rows are packed in batches and scored in parallel
+    std::vector<double> score(ConstMatrixView X) const;
+
+    // Reference scalar loop (the pre-dispatch code path), for benchmarks
+    static void scoreGeneric(const double* coefficients, size_t features, double intercept,
+                             const double* rows, size_t count, double* out);
+};
+
+#endif // SCORING_KERNEL_H
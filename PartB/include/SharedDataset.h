@@ -0,0 +1,83 @@
+#ifndef SHARED_DATASET_H
+#define SHARED_DATASET_H
+
+#include "Dataset.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Read-only columnar image of a Dataset in POSIX shared memory
+ *
+ * publish() lays a Dataset out in a named shared-memory segment (shm_open,
+ * so /dev/shm on Linux): one int32 column per numeric field, the six
+ * features again as a row-major double block that predictBatch() can score
+ * in place, and vendor/model codes into a deduplicated string dictionary.
+ * attach() maps the segment read-only; every accessor points into the
+ * mapping, so processes attached to one segment share its pages and memory
+ * per host does not grow with the number of processes.
+ *
+ * The header magic is written last, so a segment is never attached half
+ * built. A segment lives until unpublish() (or reboot), independently of
+ * the publishing process.
+ */
+class SharedDataset {
+public:
+    // Numeric columns, in file order
+    enum Column { MYCT, MMIN, MMAX, CACH, CHMIN, CHMAX, PRP, ERP, COLUMN_COUNT };
+    static constexpr size_t FEATURE_COUNT = 6;
+
+    // Constructor / destructor (detaches)
+    SharedDataset();
+    ~SharedDataset();
+
+    SharedDataset(const SharedDataset&) = delete;
+    SharedDataset& operator=(const SharedDataset&) = delete;
+    SharedDataset(SharedDataset&& other) noexcept;
+    SharedDataset& operator=(SharedDataset&& other) noexcept;
+
+    // Write a dataset to the named segment ("/name"), replacing any previous
+    // segment of that name; remove a segment. Both report errors on std::cerr.
+    static bool publish(const Dataset& data, const std::string& name);
+    static bool unpublish(const std::string& name);
+
+    // Map a published segment read-only; false if missing or malformed
+    bool attach(const std::string& name);
+    void detach();
+    bool isAttached() const { return base != nullptr; }
+
+    // Rows and mapping size
+    size_t size() const { return rows; }
+    size_t mappedBytes() const { return length; }
+
+    // Zero-copy access (valid while attached)
+    const int32_t* column(Column c) const { return columns[c]; }
+    const double* featureRows() const { return features; }       // size() x FEATURE_COUNT
+    double getTarget(size_t row) const { return static_cast<double>(columns[PRP][row]); }
+    std::string_view getVendor(size_t row) const { return entry(vendorCodes[row]); }
+    std::string_view getModel(size_t row) const { return entry(modelCodes[row]); }
+    uint32_t getVendorCode(size_t row) const { return vendorCodes[row]; }
+    size_t dictionarySize() const { return entries; }
+    std::string_view entry(uint32_t code) const;
+
+    // Copy back into an ordinary Dataset
+    Dataset toDataset() const;
+
+private:
+    const unsigned char* base;
+    size_t length;
+    size_t rows;
+    size_t entries;
+    const int32_t* columns[COLUMN_COUNT];
+    const double* features;
+    const uint32_t* vendorCodes;
+    const uint32_t* modelCodes;
+    const uint64_t* entryOffsets;     // entries + 1 offsets into strings
+    const char* strings;
+
+    void reset();
+    void take(SharedDataset& other);
+};
+
+#endif // SHARED_DATASET_H
@@ -0,0 +1,347 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include "CpuDispatch.h"
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Kernel bodies shared by the per-level translation units
+ *
+ * Each SimdKernels*.cpp defines a lane type for its instruction set (a
+ * vector of WIDTH doubles with load/store/arithmetic, the sin/cos quadrant
+ * fix-up and the 64-byte structural classifier) and instantiates
+ * makeKernels() with it. Everything here has internal linkage and calls
+ * only intrinsics, so no AVX-encoded copy of a shared inline function can
+ * end up being the one the linker keeps for baseline callers.
+ */
+namespace SimdKernels {
+
+// Tables per level; nullptr when that translation unit was built without
+// its instruction-set flags (other compilers, other architectures). Each
+// runs code compiled for its level, so call it only once cpuid agrees
+const CpuDispatch::Kernels* baseline();
+const CpuDispatch::Kernels* sse42();
+const CpuDispatch::Kernels* avx2();
+const CpuDispatch::Kernels* avx512();
+
+namespace {
+
+// Cody-Waite split of pi/2 and the 2/pi reduction factor
+const double TWO_OVER_PI = 0.63661977236758134308;
+const double PIO2_1 = 1.57079625129699707031;
+const double PIO2_2 = 7.54978941586159635335e-8;
+const double PIO2_3 = 5.39030285815811905290e-15;
+
+// Adding 1.5 * 2^52 rounds to the nearest integer and leaves it in the low mantissa bits
+const double ROUND_MAGIC = 6755399441055744.0;
+
+// Minimax polynomials on [-pi/4, pi/4] (Cephes sin/cos coefficients)
+const double S1 = -1.66666666666666307295e-1;
+const double S2 = 8.33333333332211858878e-3;
+const double S3 = -1.98412698295895385996e-4;
+const double S4 = 2.75573136213857245213e-6;
+const double S5 = -2.50507477628578072866e-8;
+const double S6 = 1.58962301576546568060e-10;
+const double C1 = 4.16666666666665929218e-2;
+const double C2 = -1.38888888888730564116e-3;
+const double C3 = 2.48015872888517045348e-5;
+const double C4 = -2.75573141792967388112e-7;
+const double C5 = 2.08757008419747316778e-9;
+const double C6 = -1.13585365213876817300e-11;
+
+const size_t BLOCK_BYTES = 64;
+
+inline void prefetch(const double* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    (void)address;
+#endif
+}
+
+// One double per lane; the tail of every vector loop and the whole of the
+// baseline on targets without SSE2
+struct ScalarLane {
+    using Vec = double;
+    static constexpr size_t WIDTH = 1;
+
+    static Vec load(const double* p) { return *p; }
+    static Vec loadFloat(const float* p) { return static_cast<double>(*p); }
+    static void store(double* p, Vec a) { *p = a; }
+    static Vec set1(double a) { return a; }
+    static Vec zero() { return 0.0; }
+    static Vec add(Vec a, Vec b) { return a + b; }
+    static Vec sub(Vec a, Vec b) { return a - b; }
+    static Vec mul(Vec a, Vec b) { return a * b; }
+    static Vec absolute(Vec a) { return a < 0.0 ? -a : a; }
+
+    // Quadrant q from the low bits of the rounded angle:
+    // sin = {s, c, -s, -c}[q], cos = {c, -s, -c, s}[q]
+    static void quadrant(Vec shifted, Vec s, Vec c, Vec& sine, Vec& cosine) {
+        int64_t bits;
+        std::memcpy(&bits, &shifted, sizeof(bits));
+        int64_t q = bits & 3;
+        double sinValue = (q & 1) ? c : s;
+        double cosValue = (q & 1) ? s : c;
+        sine = (q & 2) ? -sinValue : sinValue;
+        cosine = ((q + 1) & 2) ? -cosValue : cosValue;
+    }
+
+    static void classify(const char* p, char delimiter, uint64_t& delimiters, uint64_t& newlines) {
+        delimiters = 0;
+        newlines = 0;
+        for (size_t i = 0; i < BLOCK_BYTES; ++i) {
+            delimiters |= static_cast<uint64_t>(p[i] == delimiter) << i;
+            newlines |= static_cast<uint64_t>(p[i] == '\n') << i;
+        }
+    }
+};
+
+#if defined(__SSE2__)
+// Two doubles per lane; shared by the x86-64 baseline and the SSE4.2 level
+struct Sse2Lane {
+    using Vec = __m128d;
+    static constexpr size_t WIDTH = 2;
+
+    static Vec load(const double* p) { return _mm_loadu_pd(p); }
+    static Vec loadFloat(const float* p) {
+        return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+    }
+    static void store(double* p, Vec a) { _mm_storeu_pd(p, a); }
+    static Vec set1(double a) { return _mm_set1_pd(a); }
+    static Vec zero() { return _mm_setzero_pd(); }
+    static Vec add(Vec a, Vec b) { return _mm_add_pd(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm_sub_pd(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm_mul_pd(a, b); }
+    static Vec absolute(Vec a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+
+    // Swap mask and sign bits from the quadrant; SSE2 has no blendv
+    static void quadrant(Vec shifted, Vec s, Vec c, Vec& sine, Vec& cosine) {
+        const __m128i oneBit = _mm_set1_epi64x(1);
+        const __m128i twoBit = _mm_set1_epi64x(2);
+        __m128i q = _mm_castpd_si128(shifted);
+        __m128d swap = _mm_castsi128_pd(_mm_sub_epi64(_mm_setzero_si128(), _mm_and_si128(q, oneBit)));
+        __m128d sinSign = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(q, twoBit), 62));
+        __m128d cosSign = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(_mm_add_epi64(q, oneBit), twoBit), 62));
+        sine = _mm_xor_pd(_mm_or_pd(_mm_and_pd(swap, c), _mm_andnot_pd(swap, s)), sinSign);
+        cosine = _mm_xor_pd(_mm_or_pd(_mm_and_pd(swap, s), _mm_andnot_pd(swap, c)), cosSign);
+    }
+
+    static void classify(const char* p, char delimiter, uint64_t& delimiters, uint64_t& newlines) {
+        const __m128i delim = _mm_set1_epi8(delimiter);
+        const __m128i newline = _mm_set1_epi8('\n');
+        delimiters = 0;
+        newlines = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * lane));
+            uint64_t d = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, delim)));
+            uint64_t n = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)));
+            delimiters |= d << (16 * lane);
+            newlines |= n << (16 * lane);
+        }
+    }
+};
+#endif
+
+// Terms of the reductions, for one lane of elements
+struct Values {
+    template <typename V> static typename V::Vec term(typename V::Vec a, typename V::Vec) { return a; }
+};
+struct Products {
+    template <typename V> static typename V::Vec term(typename V::Vec a, typename V::Vec b) {
+        return V::mul(a, b);
+    }
+};
+struct SquaredDifferences {
+    template <typename V> static typename V::Vec term(typename V::Vec a, typename V::Vec b) {
+        typename V::Vec d = V::sub(a, b);
+        return V::mul(d, d);
+    }
+};
+struct AbsoluteDifferences {
+    template <typename V> static typename V::Vec term(typename V::Vec a, typename V::Vec b) {
+        return V::absolute(V::sub(a, b));
+    }
+};
+
+// Knuth's TwoSum: sum + value exactly equals total + error, without branches
+template <typename V>
+inline void twoSum(typename V::Vec& sum, typename V::Vec& compensation, typename V::Vec value) {
+    typename V::Vec total = V::add(sum, value);
+    typename V::Vec z = V::sub(total, sum);
+    typename V::Vec error = V::add(V::sub(sum, V::sub(total, z)), V::sub(value, z));
+    sum = total;
+    compensation = V::add(compensation, error);
+}
+
+// REDUCE_LANES running sums and errors held in REDUCE_LANES / WIDTH
+// registers each, so the lane of every element is the same at any width.
+// termAt(i) is the vector of terms starting at element i; b may be null
+template <typename V, typename TermAt>
+size_t reduceTerms(TermAt termAt, const double* a, const double* b, size_t n, size_t ahead, double* lanes) {
+    const size_t LANES = CpuDispatch::REDUCE_LANES;
+    const size_t REGISTERS = LANES / V::WIDTH;
+    typename V::Vec sums[REGISTERS], errors[REGISTERS];
+    for (size_t r = 0; r < REGISTERS; ++r) {
+        sums[r] = V::zero();
+        errors[r] = V::zero();
+    }
+
+    size_t i = 0;
+    auto step = [&](size_t at) {
+        for (size_t r = 0; r < REGISTERS; ++r) {
+            size_t offset = at + r * V::WIDTH;
+            twoSum<V>(sums[r], errors[r], termAt(offset));
+        }
+    };
+    if (ahead == 0) {
+        for (; i + LANES <= n; i += LANES) {
+            step(i);
+        }
+    } else {
+        for (; i + LANES <= n; i += LANES) {
+            prefetch(a + i + ahead);
+            if (b != nullptr && b != a) {
+                prefetch(b + i + ahead);
+            }
+            step(i);
+        }
+    }
+
+    for (size_t r = 0; r < REGISTERS; ++r) {
+        V::store(lanes + r * V::WIDTH, sums[r]);
+        V::store(lanes + LANES + r * V::WIDTH, errors[r]);
+    }
+    return i;
+}
+
+template <typename V, typename Term>
+size_t reduce(const double* a, const double* b, size_t n, size_t ahead, double* lanes) {
+    return reduceTerms<V>([a, b](size_t at) { return Term::template term<V>(V::load(a + at), V::load(b + at)); },
+                          a, b, n, ahead, lanes);
+}
+
+// Same lanes and operations as reduce<V, SquaredDifferences> against a
+// vector filled with center, so the two agree bit for bit
+template <typename V>
+size_t squaredDeviations(const double* a, double center, size_t n, size_t ahead, double* lanes) {
+    typename V::Vec c = V::set1(center);
+    return reduceTerms<V>([a, c](size_t at) { return SquaredDifferences::term<V>(V::load(a + at), c); },
+                          a, nullptr, n, ahead, lanes);
+}
+
+// Quadrant reduction followed by the two polynomials, WIDTH angles at a time
+template <typename V>
+inline void sinCosStep(const double* angles, double* sines, double* cosines) {
+    typename V::Vec angle = V::load(angles);
+    typename V::Vec shifted = V::add(V::mul(angle, V::set1(TWO_OVER_PI)), V::set1(ROUND_MAGIC));
+    typename V::Vec k = V::sub(shifted, V::set1(ROUND_MAGIC));
+
+    typename V::Vec r = V::sub(angle, V::mul(k, V::set1(PIO2_1)));
+    r = V::sub(r, V::mul(k, V::set1(PIO2_2)));
+    r = V::sub(r, V::mul(k, V::set1(PIO2_3)));
+    typename V::Vec z = V::mul(r, r);
+
+    typename V::Vec ps = V::add(V::set1(S5), V::mul(z, V::set1(S6)));
+    ps = V::add(V::set1(S4), V::mul(z, ps));
+    ps = V::add(V::set1(S3), V::mul(z, ps));
+    ps = V::add(V::set1(S2), V::mul(z, ps));
+    ps = V::add(V::set1(S1), V::mul(z, ps));
+    typename V::Vec s = V::add(r, V::mul(V::mul(r, z), ps));
+
+    typename V::Vec pc = V::add(V::set1(C5), V::mul(z, V::set1(C6)));
+    pc = V::add(V::set1(C4), V::mul(z, pc));
+    pc = V::add(V::set1(C3), V::mul(z, pc));
+    pc = V::add(V::set1(C2), V::mul(z, pc));
+    pc = V::add(V::set1(C1), V::mul(z, pc));
+    typename V::Vec c = V::add(V::sub(V::set1(1.0), V::mul(V::set1(0.5), z)), V::mul(V::mul(z, z), pc));
+
+    typename V::Vec sine, cosine;
+    V::quadrant(shifted, s, c, sine, cosine);
+    V::store(sines, sine);
+    V::store(cosines, cosine);
+}
+
+template <typename V>
+void sinCos(const double* angles, size_t n, double* sines, double* cosines) {
+    size_t i = 0;
+    for (; i + V::WIDTH <= n; i += V::WIDTH) {
+        sinCosStep<V>(angles + i, sines + i, cosines + i);
+    }
+    for (; i < n; ++i) {
+        sinCosStep<ScalarLane>(angles + i, sines + i, cosines + i);
+    }
+}
+
+template <typename V>
+void classify(const char* data, size_t blocks, char delimiter, uint64_t* delimiters, uint64_t* newlines) {
+    for (size_t b = 0; b < blocks; ++b) {
+        V::classify(data + b * BLOCK_BYTES, delimiter, delimiters[b], newlines[b]);
+    }
+}
+
+// SCORE_UNROLL vectors of rows in flight, so the per-row chains of adds overlap
+const size_t SCORE_UNROLL = 4;
+
+template <typename V>
+void scoreColumns(const double* coefficients, size_t features, double intercept,
+                  const float* const* columns, size_t n, double* out) {
+    const size_t STEP = SCORE_UNROLL * V::WIDTH;
+    size_t i = 0;
+    for (; i + STEP <= n; i += STEP) {
+        typename V::Vec sums[SCORE_UNROLL];
+        for (size_t u = 0; u < SCORE_UNROLL; ++u) {
+            sums[u] = V::set1(intercept);
+        }
+        for (size_t j = 0; j < features; ++j) {
+            typename V::Vec c = V::set1(coefficients[j]);
+            for (size_t u = 0; u < SCORE_UNROLL; ++u) {
+                sums[u] = V::add(sums[u], V::mul(c, V::loadFloat(columns[j] + i + u * V::WIDTH)));
+            }
+        }
+        for (size_t u = 0; u < SCORE_UNROLL; ++u) {
+            V::store(out + i + u * V::WIDTH, sums[u]);
+        }
+    }
+    for (; i + V::WIDTH <= n; i += V::WIDTH) {
+        typename V::Vec sum = V::set1(intercept);
+        for (size_t j = 0; j < features; ++j) {
+            sum = V::add(sum, V::mul(V::set1(coefficients[j]), V::loadFloat(columns[j] + i)));
+        }
+        V::store(out + i, sum);
+    }
+    for (; i < n; ++i) {
+        double sum = intercept;
+        for (size_t j = 0; j < features; ++j) {
+            sum = ScalarLane::add(sum, ScalarLane::mul(coefficients[j], ScalarLane::loadFloat(columns[j] + i)));
+        }
+        out[i] = sum;
+    }
+}
+
+template <typename V>
+CpuDispatch::Kernels makeKernels(CpuDispatch::Level level) {
+    static_assert(CpuDispatch::REDUCE_LANES % V::WIDTH == 0, "Lane count must be a multiple of the width");
+    CpuDispatch::Kernels kernels;
+    kernels.level = level;
+    kernels.width = V::WIDTH;
+    kernels.values = &reduce<V, Values>;
+    kernels.products = &reduce<V, Products>;
+    kernels.squaredDifferences = &reduce<V, SquaredDifferences>;
+    kernels.absoluteDifferences = &reduce<V, AbsoluteDifferences>;
+    kernels.squaredDeviations = &squaredDeviations<V>;
+    kernels.sinCos = &sinCos<V>;
+    kernels.classify = &classify<V>;
+    kernels.scoreColumns = &scoreColumns<V>;
+    return kernels;
+}
+
+} // namespace
+
+} // namespace SimdKernels
+
+#endif // SIMD_KERNELS_H
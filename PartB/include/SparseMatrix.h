@@ -0,0 +1,89 @@
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include "Matrix.h"
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Compressed sparse matrix in CSR or CSC layout
+ *
+ * CSR stores each row's nonzeros contiguously (pointers has rows + 1
+ * entries, indices are column numbers); CSC stores columns the same way.
+ * Kernels pick the layout-friendly loop: gathers (one dot product per
+ * output) run in parallel by row blocks, scatters accumulate per-block
+ * partial vectors that are summed at the end. Column indices within a row
+ * (or row indices within a column) are kept sorted.
+ */
+class SparseMatrix {
+public:
+    enum class Format { CSR, CSC };
+
+    struct Triplet {
+        size_t row;
+        size_t col;
+        double value;
+    };
+
+private:
+    size_t rows;
+    size_t cols;
+    Format format;
+    std::vector<size_t> pointers;   // start of each row (CSR) or column (CSC)
+    std::vector<size_t> indices;    // column (CSR) or row (CSC) of each entry
+    std::vector<double> values;
+
+    // Outer dimension of the storage: rows for CSR, columns for CSC
+    size_t majorSize() const { return format == Format::CSR ? rows : cols; }
+    size_t minorSize() const { return format == Format::CSR ? cols : rows; }
+
+    // y[major] = sum over the major slice of value * x[minor]
+    std::vector<double> gatherMultiply(const std::vector<double>& x) const;
+    // y[minor] += value * x[major] for every entry
+    std::vector<double> scatterMultiply(const std::vector<double>& x) const;
+    // Same matrix with the other layout
+    SparseMatrix convert() const;
+
+public:
+    // Constructors
+    SparseMatrix();
+    SparseMatrix(size_t rows, size_t cols, Format format = Format::CSR);
+
+    // Build from (row, col, value) entries; duplicates are summed, zeros dropped
+    static SparseMatrix fromTriplets(size_t rows, size_t cols, std::vector<Triplet> triplets,
+                                     Format format = Format::CSR);
+
+    // Build from a dense matrix, keeping the nonzero entries
+    static SparseMatrix fromDense(const Matrix& dense, Format format = Format::CSR);
+
+    // Getters
+    size_t getRows() const { return rows; }
+    size_t getCols() const { return cols; }
+    Format getFormat() const { return format; }
+    size_t nonZeros() const { return values.size(); }
+    double density() const;
+
+    // Element lookup (binary search within the row or column)
+    double at(size_t row, size_t col) const;
+
+    // Layout conversions; transpose() reuses the arrays with the other layout
+    SparseMatrix toCSR() const;
+    SparseMatrix toCSC() const;
+    SparseMatrix transpose() const;
+    Matrix toDense() const;
+
+    // SpMV: A * x and A^T * x
+    std::vector<double> multiply(const std::vector<double>& x) const;
+    std::vector<double> transposeMultiply(const std::vector<double>& x) const;
+
+    // Sparse * dense
+    Matrix multiply(const Matrix& dense) const;
+
+    // Sparse Gram matrix A^T * A (CSR, cols x cols)
+    SparseMatrix gram() const;
+
+    // Diagonal of A^T * A (squared column norms)
+    std::vector<double> columnSquaredNorms() const;
+};
+
+#endif // SPARSE_MATRIX_H
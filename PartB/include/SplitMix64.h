@@ -0,0 +1,48 @@
+#ifndef SPLIT_MIX64_H
+#define SPLIT_MIX64_H
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief Small seedable generator with a fixed, platform-independent stream
+ *
+ * Used wherever a result must be reproducible from a stored seed (random
+ * feature maps, bootstrap weights); the standard distributions are not
+ * guaranteed to produce the same values across library implementations.
+ */
+class SplitMix64 {
+private:
+    uint64_t state;
+
+public:
+    // Constructor
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    // Next 64 random bits
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in (0, 1]
+    double uniform() {
+        return ((next() >> 11) + 1) * (1.0 / 9007199254740992.0);
+    }
+
+    // Poisson count by inversion (intended for small means such as 1)
+    unsigned poisson(double mean) {
+        double threshold = std::exp(-mean);
+        double product = uniform();
+        unsigned count = 0;
+        while (product > threshold) {
+            product *= uniform();
+            ++count;
+        }
+        return count;
+    }
+};
+
+#endif // SPLIT_MIX64_H
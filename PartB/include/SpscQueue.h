@@ -0,0 +1,100 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free single-producer / single-consumer ring buffer
+ *
+ * The producer blocks while the ring is full (backpressure) and the consumer
+ * blocks while it is empty; both back off from spinning to yielding to short
+ * sleeps so an idle stage does not burn a core. close() marks end of stream.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    // Capacity is rounded up to a power of two
+    explicit SpscQueue(size_t capacity) : head(0), tail(0), closed(false) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Non-blocking push; false if the ring is full
+    bool tryPush(T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) > mask) {
+            return false;
+        }
+        slots[t & mask] = std::move(item);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Non-blocking pop; false if the ring is empty
+    bool tryPop(T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(slots[h & mask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Blocking push (waits while full)
+    void push(T item) {
+        for (unsigned attempt = 0; !tryPush(item); ++attempt) {
+            backoff(attempt);
+        }
+    }
+
+    // Blocking pop; returns false once the queue is closed and drained
+    bool pop(T& item) {
+        for (unsigned attempt = 0;; ++attempt) {
+            if (tryPop(item)) {
+                return true;
+            }
+            if (closed.load(std::memory_order_acquire)) {
+                return tryPop(item);  // items pushed right before close()
+            }
+            backoff(attempt);
+        }
+    }
+
+    // Signal end of stream to the consumer
+    void close() { closed.store(true, std::memory_order_release); }
+
+    size_t capacity() const { return mask + 1; }
+
+private:
+    static void backoff(unsigned attempt) {
+        if (attempt < 64) {
+            return;  // spin
+        }
+        if (attempt < 256) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+    std::vector<T> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head;   // next slot to pop (consumer)
+    alignas(64) std::atomic<size_t> tail;   // next slot to fill (producer)
+    alignas(64) std::atomic<bool> closed;
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,83 @@
+#ifndef STREAMING_PIPELINE_H
+#define STREAMING_PIPELINE_H
+
+#include "LinearRegression.h"
+#include "NormalEquations.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Settings for StreamingPipeline
+ */
+struct PipelineConfig {
+    double trainRatio = 0.8;      // fraction of rows routed to training
+    double lambda = 0.0;          // ridge parameter (0 = ordinary least squares)
+    uint64_t seed = 42;           // seed of the per-row train/test assignment
+    size_t batchRows = 4096;      // rows per column batch
+    size_t queueCapacity = 8;     // batches buffered between two stages
+};
+
+/**
+ * @brief Single-pass ingest -> train -> evaluate dataflow
+ *
+ * Four stages run on their own threads, connected by bounded SPSC queues:
+ *   reader    - streams the file (FileReader) as line-aligned text chunks
+ *   parser    - structural scan + integer parsing into record batches
+ *   transform - converts records to feature columns and assigns train/test
+ *   accumulate- folds each batch into train and test NormalEquations
+ * A full queue stalls its producer, so memory stays bounded by the queue
+ * capacities. Test RMSE/MSE/R-squared follow from the test statistics once the
+ * coefficients are solved, so evaluation needs no second pass over the file.
+ */
+class StreamingPipeline {
+public:
+    // Throughput counters of one stage
+    struct StageMetrics {
+        std::string name;
+        uint64_t batches = 0;
+        uint64_t rows = 0;
+        uint64_t bytes = 0;
+        double busySeconds = 0.0;      // time spent doing work
+        double inputWaitSeconds = 0.0; // starved by the upstream stage
+        double outputWaitSeconds = 0.0;// blocked by a full downstream queue
+    };
+
+    struct Result {
+        std::vector<double> coefficients;
+        double trainRows = 0.0;
+        double testRows = 0.0;
+        double trainRMSE = 0.0;
+        double testRMSE = 0.0;
+        double testMSE = 0.0;
+        double testRSquared = 0.0;
+        double wallSeconds = 0.0;
+        std::vector<StageMetrics> stages;
+    };
+
+    // Constructor
+    StreamingPipeline();
+    explicit StreamingPipeline(const PipelineConfig& config);
+
+    // Stream the file once, train the model and evaluate on the held-out rows
+    bool run(const std::string& filename, LinearRegression& model);
+
+    // Results of the last run
+    const Result& getResult() const { return result; }
+    const NormalEquations& getTrainStatistics() const { return trainStats; }
+    const NormalEquations& getTestStatistics() const { return testStats; }
+
+    // Display per-stage metrics and evaluation results
+    void displayResults() const;
+
+private:
+    PipelineConfig config;
+    NormalEquations trainStats;
+    NormalEquations testStats;
+    Result result;
+
+    // Deterministic train/test assignment of a row
+    bool isTrainingRow(uint64_t rowIndex) const;
+};
+
+#endif // STREAMING_PIPELINE_H
@@ -0,0 +1,101 @@
+#ifndef SUMMATION_H
+#define SUMMATION_H
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @brief Floating-point reductions with bounded rounding error
+ *
+ * naive() is the plain left-to-right loop, whose error grows with n.
+ * pairwise() halves the range recursively (error grows with log n).
+ * kahanBabuska() carries the rounding error of every addition in a second
+ * accumulator (Neumaier's variant, exact up to a final rounding for most
+ * inputs). compensated() does the same with one error-free TwoSum per SIMD
+ * lane and merges the lanes at the end; it keeps up with the naive loop on
+ * memory-bound inputs and is what metrics and Gram accumulation use. Its
+ * lane kernels are dispatched at run time (CpuDispatch) and always keep
+ * the same number of lanes, so results do not depend on the host's SIMD.
+ *
+ * The dot(), squaredDifferences(), absoluteDifferences() and
+ * squaredDeviations() forms apply compensated() to a * b, (a - b)^2,
+ * |a - b| and (a - center)^2 without a temporary.
+ * parallelSum() splits into fixed-size chunks, so its result does not
+ * depend on the thread count.
+ */
+namespace Summation {
+
+/**
+ * @brief Running compensated sum (Kahan-Babuska / Neumaier)
+ *
+ * Used for sums that arrive one term at a time, such as merging per-block
+ * partials or accumulating statistics across batches.
+ */
+class KahanBabuska {
+private:
+    double sum;
+    double compensation;
+
+public:
+    KahanBabuska() : sum(0.0), compensation(0.0) {}
+    explicit KahanBabuska(double value) : sum(value), compensation(0.0) {}
+    KahanBabuska(double sum, double compensation) : sum(sum), compensation(compensation) {}
+
+    // Add one term; the low-order bits lost by sum + value go to compensation
+    void add(double value) {
+        double total = sum + value;
+        if (std::abs(sum) >= std::abs(value)) {
+            compensation += (sum - total) + value;
+        } else {
+            compensation += (value - total) + sum;
+        }
+        sum = total;
+    }
+
+    // Add another running sum, keeping both parts
+    void merge(const KahanBabuska& other) {
+        add(other.sum);
+        compensation += other.compensation;
+    }
+
+    void clear() { sum = compensation = 0.0; }
+
+    KahanBabuska& operator+=(double value) {
+        add(value);
+        return *this;
+    }
+
+    // Rounded result, and its two parts (for shipping a sum elsewhere)
+    double value() const { return sum + compensation; }
+    double getSum() const { return sum; }
+    double getCompensation() const { return compensation; }
+};
+
+// Reference and alternative algorithms
+double naive(const double* values, size_t n);
+double pairwise(const double* values, size_t n);
+double kahanBabuska(const double* values, size_t n);
+
+// SIMD-lane compensated sums
+double compensated(const double* values, size_t n);
+double dot(const double* a, const double* b, size_t n);
+double squaredDifferences(const double* a, const double* b, size_t n);
+double absoluteDifferences(const double* a, const double* b, size_t n);
+double squaredDeviations(const double* values, size_t n, double center);
+
+// compensated() over fixed chunks summed in parallel, merged in chunk order
+double parallelSum(const double* values, size_t n);
+
+// Vector conveniences
+inline double compensated(const std::vector<double>& values) {
+    return compensated(values.data(), values.size());
+}
+
+inline double mean(const std::vector<double>& values) {
+    return values.empty() ? 0.0 : compensated(values) / values.size();
+}
+
+} // namespace Summation
+
+#endif // SUMMATION_H
@@ -0,0 +1,116 @@
+#ifndef CPUPERF_H
+#define CPUPERF_H
+
+/*
+ * Stable C API for the predict path of libcpuperf
+ *
+ * Lets a service score rows in-process (link libcpuperf.a or libcpuperf.so)
+ * instead of running the predictor per batch, from C or any runtime with a
+ * C FFI (cgo, Rust extern "C", ctypes). The interface is plain C: an opaque
+ * model handle, row-major double or columnar float buffers owned by the
+ * caller (read in place, never copied) and integer status codes, so it
+ * does not depend on the C++ standard library or compiler the library was
+ * built with. Functions never throw or print; on failure they return NULL
+ * or a non-zero status and cpuperf_last_error() describes the last failure
+ * on the calling thread.
+ *
+ * A model is immutable once created; any number of threads may predict
+ * with the same handle concurrently. cpuperf_model_free() and
+ * cpuperf_model_monitor_drift() must not race with other calls on that
+ * handle.
+ *
+ * Compatibility: functions are only ever added. CPUPERF_API_VERSION is
+ * bumped when they are, and cpuperf_api_version() reports the version the
+ * library was built with.
+ */
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#define CPUPERF_API
+#else
+#define CPUPERF_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CPUPERF_API_VERSION 3
+
+/* Features per row: MYCT, MMIN, MMAX, CACH, CHMIN, CHMAX */
+#define CPUPERF_FEATURES 6
+
+typedef enum cpuperf_status {
+    CPUPERF_OK = 0,
+    CPUPERF_INVALID_ARGUMENT = 1,
+    CPUPERF_IO_ERROR = 2,
+    CPUPERF_TRAINING_FAILED = 3,
+    CPUPERF_INTERNAL_ERROR = 4
+} cpuperf_status;
+
+typedef struct cpuperf_model cpuperf_model;
+
+/* Version of the API the library implements (CPUPERF_API_VERSION at build time) */
+CPUPERF_API int cpuperf_api_version(void);
+
+/* Short description of a status code */
+CPUPERF_API const char* cpuperf_status_string(int status);
+
+/* Message for the last failure on this thread ("" if none) */
+CPUPERF_API const char* cpuperf_last_error(void);
+
+/* Train on a machine.data file (lambda > 0 fits ridge); NULL on failure */
+CPUPERF_API cpuperf_model* cpuperf_model_train(const char* data_path, double lambda);
+
+/* Model from CPUPERF_FEATURES coefficients, e.g. a stored fit; NULL on failure */
+CPUPERF_API cpuperf_model* cpuperf_model_create(const double* coefficients, size_t count);
+
+/* Model file written by `cpu_performance_predictor --save-model`; NULL on failure (v2) */
+CPUPERF_API cpuperf_model* cpuperf_model_load(const char* path);
+
+/* Release a model (NULL is ignored) */
+CPUPERF_API void cpuperf_model_free(cpuperf_model* model);
+
+/* Copy the coefficients into out[0..count), count >= CPUPERF_FEATURES */
+CPUPERF_API int cpuperf_model_coefficients(const cpuperf_model* model, double* out, size_t count);
+
+/* Score n rows of a row-major n x CPUPERF_FEATURES buffer into out[0..n) */
+CPUPERF_API int cpuperf_predict(const cpuperf_model* model, const double* rows, size_t n, double* out);
+
+/*
+ * Columnar batch (v2): CPUPERF_FEATURES float columns of n values back to
+ * back, cols[j * n + i] being feature j of row i (a column-major n x 6
+ * block, as Go slices, Rust Vecs or Arrow buffers hold them). Read in
+ * place, vectorized across rows at the widest SIMD level of the host, on
+ * the calling thread; out[0..n) receives the predictions.
+ */
+CPUPERF_API int cpuperf_predict_batch(const cpuperf_model* model, const float* cols, size_t n, double* out);
+
+/* Same with one pointer per column, for columns that are not contiguous (v2) */
+CPUPERF_API int cpuperf_predict_columns(const cpuperf_model* model, const float* const* columns, size_t n,
+                                        double* out);
+
+/*
+ * Feature drift monitoring (v3): from now on every predict call on the
+ * handle samples one row in sample_stride (0 = 64) for a background
+ * thread, which compares the stream with the training distribution in
+ * baseline_path (written next to the model by --save-model as
+ * <model file>.baseline). Scoring never waits for the monitor.
+ */
+CPUPERF_API int cpuperf_model_monitor_drift(cpuperf_model* model, const char* baseline_path, size_t sample_stride);
+
+/*
+ * Drift scores of the recent sampled rows (v3): psi[j] and ks[j] for each
+ * feature, count >= CPUPERF_FEATURES; *drifted is 1 when any feature is
+ * past its PSI or KS threshold (a retrain is due), 0 otherwise. Either
+ * array may be NULL. CPUPERF_INVALID_ARGUMENT if monitoring is off.
+ */
+CPUPERF_API int cpuperf_drift_scores(const cpuperf_model* model, double* psi, double* ks, size_t count,
+                                     int* drifted);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CPUPERF_H */
@@ -0,0 +1,336 @@
+#include "include/CpuDispatch.h"
+#include "include/CsvScanner.h"
+#include "include/HugePages.h"
+#include "include/Matrix.h"
+#include "include/RandomFourierFeatures.h"
+#include "include/Summation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Benchmarks of the dense Matrix kernels against their previous versions
+ *
+ * Transpose: the original element-wise loop (result(j, i) = A[i][j] through
+ * bounds-checked access) against the cache-oblivious tiled transpose, on
+ * tall-skinny design-matrix shapes and one square matrix, plus the in-place
+ * square transpose. Gram: X.transpose() * X against the lazy view
+ * X.transposed() * X, which never forms X^T. Summation: the naive loop
+ * against pairwise, scalar Kahan-Babuska and the SIMD-lane compensated sum,
+ * in cache and streaming from memory, with the error of each on a sum
+ * whose terms cancel. Huge pages: a 256 MB buffer under each
+ * HugePages mode, scanned sequentially and gathered one value per 4 KB
+ * page in a scattered order, where TLB reach dominates. Dispatch: the
+ * compensated dot product, sin/cos and CSV structural scan at every SIMD
+ * level this CPU supports, checked bit-identical against the baseline.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Best of REPEATS runs, which filters out scheduling noise
+const int REPEATS = 5;
+
+template <typename Fn>
+double bestSeconds(Fn fn) {
+    double best = 1e300;
+    for (int r = 0; r < REPEATS; ++r) {
+        auto start = Clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+Matrix filledMatrix(size_t rows, size_t cols) {
+    Matrix A(rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            A(i, j) = static_cast<double>((i * 31 + j * 17) % 1009) * 0.001;
+        }
+    }
+    return A;
+}
+
+// Matrix::transpose() before the tiled version
+Matrix legacyTranspose(const Matrix& A) {
+    Matrix result(A.getCols(), A.getRows());
+    for (size_t i = 0; i < A.getRows(); ++i) {
+        for (size_t j = 0; j < A.getCols(); ++j) {
+            result(j, i) = A[i][j];
+        }
+    }
+    return result;
+}
+
+bool sameMatrix(const Matrix& a, const Matrix& b, double tolerance) {
+    if (a.getRows() != b.getRows() || a.getCols() != b.getCols()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.getRows(); ++i) {
+        for (size_t j = 0; j < a.getCols(); ++j) {
+            if (std::abs(a[i][j] - b[i][j]) > tolerance * (1.0 + std::abs(a[i][j]))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void printRow(const std::string& shape, double legacy, double current, double bytes, bool ok) {
+    std::cout << std::left << std::setw(16) << shape << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << legacy * 1e3 << std::setw(12) << current * 1e3
+              << std::setw(10) << bytes / current / 1e9 << std::setw(9) << legacy / current << "x"
+              << (ok ? "" : "  MISMATCH") << std::endl;
+}
+
+std::string shapeName(size_t rows, size_t cols) {
+    return std::to_string(rows) + " x " + std::to_string(cols);
+}
+
+bool benchTranspose() {
+    std::cout << "\n=== Transpose (ms, best of " << REPEATS << ") ===" << std::endl;
+    std::cout << std::left << std::setw(16) << "shape" << std::right << std::setw(12) << "legacy"
+              << std::setw(12) << "tiled" << std::setw(10) << "GB/s" << std::setw(10) << "speedup" << std::endl;
+
+    const size_t shapes[][2] = {{1000000, 6}, {250000, 32}, {100000, 64}, {20000, 300}, {2048, 2048}};
+    bool ok = true;
+    for (const auto& shape : shapes) {
+        Matrix A = filledMatrix(shape[0], shape[1]);
+        Matrix expected, actual;
+        double legacy = bestSeconds([&]() { expected = legacyTranspose(A); });
+        double current = bestSeconds([&]() { actual = A.transpose(); });
+        bool same = sameMatrix(expected, actual, 0.0);
+        ok = ok && same;
+        printRow(shapeName(shape[0], shape[1]), legacy, current, 2.0 * shape[0] * shape[1] * sizeof(double), same);
+    }
+
+    // In place: an even number of transposes restores the matrix
+    Matrix square = filledMatrix(2048, 2048);
+    Matrix original = square;
+    Matrix copied;
+    double copyTime = bestSeconds([&]() { copied = square.transpose(); });
+    double inPlace = bestSeconds([&]() { square.transposeInPlace(); });
+    if (REPEATS % 2 != 0) {
+        square.transposeInPlace();
+    }
+    bool same = sameMatrix(original, square, 0.0);
+    ok = ok && same;
+    std::cout << "In place 2048 x 2048 (tiled copy vs in place):" << std::endl;
+    printRow("2048 x 2048", copyTime, inPlace, 2.0 * 2048 * 2048 * sizeof(double), same);
+    return ok;
+}
+
+bool benchGram() {
+    std::cout << "\n=== X^T X (ms, best of " << REPEATS << ") ===" << std::endl;
+    std::cout << std::left << std::setw(16) << "shape" << std::right << std::setw(12) << "materialized"
+              << std::setw(12) << "view" << std::setw(10) << "GB/s" << std::setw(10) << "speedup" << std::endl;
+
+    const size_t shapes[][2] = {{1000000, 6}, {100000, 64}};
+    bool ok = true;
+    for (const auto& shape : shapes) {
+        Matrix X = filledMatrix(shape[0], shape[1]);
+        Matrix expected, actual;
+        double legacy = bestSeconds([&]() { expected = X.transpose() * X; });
+        double current = bestSeconds([&]() { actual = X.transposed() * X; });
+        bool same = sameMatrix(expected, actual, 1e-12);
+        ok = ok && same;
+        printRow(shapeName(shape[0], shape[1]), legacy, current, double(shape[0]) * shape[1] * sizeof(double), same);
+    }
+    return ok;
+}
+
+// Pairs (x + 1, -x) with |x| around 1e10: the exact sum is n / 2, and the
+// naive loop loses the ones in the rounding of the running total
+std::vector<double> cancellingTerms(size_t n) {
+    std::vector<double> values(n);
+    std::mt19937_64 generator(7);
+    std::normal_distribution<double> normal(0.0, 1e10);
+    for (size_t i = 0; i + 1 < n; i += 2) {
+        double x = normal(generator);
+        values[i] = x + 1.0;
+        values[i + 1] = -x;
+    }
+    return values;
+}
+
+bool benchSummation() {
+    std::cout << "\n=== Summation (ms, best of " << REPEATS << ") ===" << std::endl;
+    std::cout << std::left << std::setw(18) << "terms x passes" << std::right << std::setw(10) << "naive"
+              << std::setw(10) << "pairwise" << std::setw(10) << "kahan" << std::setw(10) << "lanes"
+              << std::setw(12) << "lanes cost" << std::endl;
+
+    using Sum = double (*)(const double*, size_t);
+    const Sum methods[] = {&Summation::naive, &Summation::pairwise, &Summation::kahanBabuska,
+                           static_cast<Sum>(&Summation::compensated)};
+    // 256 KB stays in L2; 128 MB streams from memory
+    const size_t shapes[][2] = {{1 << 15, 512}, {1 << 24, 1}};
+    volatile double sink = 0.0;
+    bool ok = true;
+    for (const auto& shape : shapes) {
+        std::vector<double> values = cancellingTerms(shape[0]);
+        double exact = static_cast<double>(shape[0] / 2);
+        double seconds[4], errors[4];
+        for (int m = 0; m < 4; ++m) {
+            seconds[m] = bestSeconds([&]() {
+                for (size_t pass = 0; pass < shape[1]; ++pass) {
+                    sink = methods[m](values.data(), values.size());
+                }
+            });
+            errors[m] = std::abs(methods[m](values.data(), values.size()) - exact);
+        }
+        std::cout << std::left << std::setw(18) << (std::to_string(shape[0]) + " x " + std::to_string(shape[1]))
+                  << std::right << std::fixed << std::setprecision(2);
+        for (double s : seconds) {
+            std::cout << std::setw(10) << s * 1e3;
+        }
+        std::cout << std::setw(11) << std::showpos << (seconds[3] / seconds[0] - 1.0) * 100.0 << std::noshowpos
+                  << "%" << std::endl;
+        std::cout << std::left << std::setw(18) << "  abs error" << std::right << std::scientific << std::setprecision(1);
+        for (double e : errors) {
+            std::cout << std::setw(10) << e;
+        }
+        std::cout << std::fixed << std::endl;
+        ok = ok && errors[2] == 0.0 && errors[3] == 0.0;
+    }
+
+    // Chunked parallel sum: same value for any thread count
+    std::vector<double> values = cancellingTerms(1 << 24);
+    double parallelSeconds = bestSeconds([&]() { sink = Summation::parallelSum(values.data(), values.size()); });
+    double parallelError = std::abs(Summation::parallelSum(values.data(), values.size()) - (1 << 23));
+    std::cout << "parallelSum 16777216: " << std::setprecision(2) << parallelSeconds * 1e3 << " ms, abs error "
+              << std::scientific << std::setprecision(1) << parallelError << std::fixed << std::endl;
+    return ok && parallelError == 0.0;
+}
+
+bool benchHugePages() {
+    std::cout << "\n=== Huge pages, 256 MB buffer (ms, best of " << REPEATS << ") ===" << std::endl;
+    std::cout << std::left << std::setw(14) << "mode" << std::right << std::setw(10) << "scan"
+              << std::setw(10) << "gather" << std::setw(12) << "coverage" << std::endl;
+
+    using Buffer = std::vector<double, HugePages::Allocator<double>>;
+    const size_t count = size_t(1) << 25;
+    const size_t pageValues = 4096 / sizeof(double);
+    const size_t gathers = size_t(1) << 22;
+    volatile double sink = 0.0;
+    double reference = 0.0;
+    bool ok = true;
+    HugePages::Mode previous = HugePages::mode();
+    for (HugePages::Mode mode : {HugePages::OFF, HugePages::TRANSPARENT, HugePages::EXPLICIT}) {
+        HugePages::setMode(mode);
+        HugePages::Coverage before = HugePages::coverage();
+        Buffer values(count);
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = static_cast<double>(i % 1024);
+        }
+        HugePages::Coverage after = HugePages::coverage();
+        double share = after.bytes > before.bytes
+                           ? static_cast<double>(after.hugeBytes - before.hugeBytes) / (after.bytes - before.bytes)
+                           : 0.0;
+
+        double scan = bestSeconds([&]() { sink = Summation::compensated(values.data(), count); });
+        double gathered = 0.0;
+        double gather = bestSeconds([&]() {
+            // Odd multiplier: visits pages in a scattered but repeatable order
+            double total = 0.0;
+            size_t pages = count / pageValues;
+            for (size_t k = 0; k < gathers; ++k) {
+                size_t page = (k * 40503) & (pages - 1);
+                total += values[page * pageValues + (k & (pageValues - 1))];
+            }
+            gathered = total;
+        });
+        double checksum = Summation::compensated(values.data(), count) + gathered;
+        if (mode == HugePages::OFF) {
+            reference = checksum;
+        }
+        ok = ok && checksum == reference;
+        std::cout << std::left << std::setw(14) << HugePages::modeName(mode) << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(10) << scan * 1e3 << std::setw(10) << gather * 1e3
+                  << std::setw(11) << std::setprecision(1) << share * 100.0 << "%" << std::endl;
+    }
+    HugePages::setMode(previous);
+    std::cout << "Total: " << HugePages::describe(HugePages::coverage()) << std::endl;
+    return ok;
+}
+
+bool benchDispatch() {
+    std::cout << "\n=== SIMD dispatch levels (ms, best of " << REPEATS << ", selected: "
+              << CpuDispatch::levelName(CpuDispatch::level()) << ") ===" << std::endl;
+    std::cout << std::left << std::setw(14) << "level" << std::right << std::setw(10) << "dot"
+              << std::setw(10) << "sin/cos" << std::setw(10) << "csv" << std::endl;
+
+    // 2 x 256 KB of doubles stays in L2; the CSV text is about 16 MB
+    const size_t n = 1 << 15;
+    const size_t passes = 256;
+    std::vector<double> a(n), b(n), sines(n), cosines(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = std::sin(static_cast<double>(i) * 0.37) * 1e3 + static_cast<double>(i);
+        b[i] = static_cast<double>(i) * 0.5 - 3.0;
+    }
+    std::string csv;
+    for (int i = 0; i < 500000; ++i) {
+        csv += std::to_string(i) + ",ibm,3033," + std::to_string(i % 997) + ",32000,\n";
+    }
+
+    CpuDispatch::Level previous = CpuDispatch::level();
+    volatile double sink = 0.0;
+    double referenceDot = 0.0;
+    std::vector<double> referenceSines, referenceCosines;
+    std::vector<uint32_t> offsets, referenceOffsets;
+    bool ok = true;
+    for (int l = 0; l < CpuDispatch::LEVEL_COUNT; ++l) {
+        CpuDispatch::Level level = static_cast<CpuDispatch::Level>(l);
+        if (!CpuDispatch::setLevel(level)) {
+            continue;
+        }
+        double dot = bestSeconds([&]() {
+            for (size_t pass = 0; pass < passes; ++pass) {
+                sink = Summation::dot(a.data(), b.data(), n);
+            }
+        });
+        double sinCos = bestSeconds([&]() {
+            for (size_t pass = 0; pass < passes; ++pass) {
+                RandomFourierFeatures::sinCos(a.data(), n, sines.data(), cosines.data());
+            }
+        });
+        double scan = bestSeconds([&]() {
+            offsets.clear();
+            CsvScanner::findStructurals(csv.data(), csv.size(), offsets);
+        });
+
+        double value = Summation::dot(a.data(), b.data(), n);
+        if (level == CpuDispatch::BASELINE) {
+            referenceDot = value;
+            referenceSines = sines;
+            referenceCosines = cosines;
+            referenceOffsets = offsets;
+        }
+        bool same = value == referenceDot && sines == referenceSines && cosines == referenceCosines &&
+                    offsets == referenceOffsets;
+        ok = ok && same;
+        std::cout << std::left << std::setw(14) << CpuDispatch::levelName(level) << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(10) << dot * 1e3 << std::setw(10) << sinCos * 1e3
+                  << std::setw(10) << scan * 1e3 << (same ? "" : "  MISMATCH") << std::endl;
+    }
+    CpuDispatch::setLevel(previous);
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    bool ok = benchTranspose();
+    ok = benchGram() && ok;
+    ok = benchSummation() && ok;
+    ok = benchHugePages() && ok;
+    ok = benchDispatch() && ok;
+    std::cout << (ok ? "\nAll results match" : "\nResults DIFFER") << std::endl;
+    return ok ? 0 : 1;
+}
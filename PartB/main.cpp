@@ -1,9 +1,20 @@
 #include "include/Dataset.h"
 #include "include/LinearRegression.h"
 #include "include/Evaluator.h"
+#include "include/StreamingPipeline.h"
+#include "include/DistributedTrainer.h"
+#include "include/SharedDataset.h"
+#include "include/CpuDispatch.h"
+#include "include/AsyncWorkflow.h"
+#include "include/MultiTargetRegression.h"
+#include "include/KernelRidgeRegression.h"
+#include "include/Ensemble.h"
+#include "include/DriftMonitor.h"
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <chrono>
+#include <cstdlib>
 
 /**
  * @brief Main application for CPU Performance Linear Regression Prediction
@@ -46,6 +57,13 @@ void displayMenu() {
     std::cout << "7. Generate detailed evaluation report" << std::endl;
     std::cout << "8. Display model equation" << std::endl;
     std::cout << "9. Residual analysis" << std::endl;
+    std::cout << "10. Streaming train + evaluate (single-pass pipeline)" << std::endl;
+    std::cout << "11. Asynchronous train / cross-validate / report workflow" << std::endl;
+    std::cout << "12. Train and evaluate multi-target model (PRP + ERP)" << std::endl;
+    std::cout << "13. Train kernel ridge model (random Fourier features)" << std::endl;
+    std::cout << "14. Train bagged and stacked ensembles" << std::endl;
+    std::cout << "15. Export trained model as a C++ header" << std::endl;
+    std::cout << "16. Distributed train + evaluate (worker processes)" << std::endl;
     std::cout << "0. Exit" << std::endl;
     std::cout << "Choose an option: ";
 }
@@ -73,22 +91,196 @@ void makeIndividualPrediction(const LinearRegression& model) {
         double prediction = model.predict(features);
         std::cout << "\nPredicted Relative Performance: " << std::fixed << std::setprecision(2) 
                   << prediction << std::endl;
+        
+        if (model.getHasInference()) {
+            Matrix X(1, 6);
+            X[0] = features;
+            LinearRegression::PredictionInterval interval = model.predictIntervals(X)[0];
+            std::cout << "Standard error: " << interval.standardError << std::endl;
+            std::cout << "95% prediction interval: [" << interval.lower << ", " 
+                      << interval.upper << "]" << std::endl;
+        }
     }
     catch (const std::exception& e) {
         std::cout << "Error making prediction: " << e.what() << std::endl;
     }
 }
 
-int main() {
+// Non-interactive: train on the whole dataset and write the model header
+int emitHeader(const std::string& headerPath, const std::string& dataPath) {
+    Dataset dataset;
+    LinearRegression model;
+    if (!dataset.loadFromFile(dataPath) || !model.train(dataset)) {
+        std::cerr << "Error: Could not train a model from " << dataPath << std::endl;
+        return 1;
+    }
+    if (!model.exportHeader(headerPath)) {
+        return 1;
+    }
+    std::cout << "Model header written to: " << headerPath << std::endl;
+    return 0;
+}
+
+// Non-interactive: train on the whole dataset and write the model file
+// that cpuperf_model_load() reads, with the training distribution next to it
+// (<model file>.baseline) for cpuperf_model_monitor_drift()
+int saveModel(const std::string& modelPath, const std::string& dataPath) {
+    Dataset dataset;
+    LinearRegression model;
+    DriftBaseline baseline;
+    if (!dataset.loadFromFile(dataPath) || !model.train(dataset) || !baseline.capture(dataset)) {
+        std::cerr << "Error: Could not train a model from " << dataPath << std::endl;
+        return 1;
+    }
+    if (!model.save(modelPath) || !baseline.save(modelPath + ".baseline")) {
+        return 1;
+    }
+    std::cout << "Model written to: " << modelPath << " (drift baseline " << modelPath << ".baseline)" << std::endl;
+    return 0;
+}
+
+// Non-interactive: score one file in batches with a model trained on another,
+// feeding the scored rows to a drift monitor against the training distribution
+int driftCheck(const std::string& trainPath, const std::string& scorePath) {
+    Dataset training, scoring;
+    LinearRegression model;
+    DriftBaseline baseline;
+    if (!training.loadFromFile(trainPath) || !model.train(training) || !baseline.capture(training)) {
+        std::cerr << "Error: Could not train a model from " << trainPath << std::endl;
+        return 1;
+    }
+    if (!scoring.loadFromFile(scorePath)) {
+        std::cerr << "Error: Could not load " << scorePath << std::endl;
+        return 1;
+    }
+    std::vector<double> rows;
+    rows.reserve(scoring.size() * 6);
+    for (size_t i = 0; i < scoring.size(); ++i) {
+        for (double value : scoring[i].getFeatureVector()) {
+            rows.push_back(value);
+        }
+    }
+
+    // A short file is replayed until the stream yields minWindowRows sampled
+    // rows at the monitor's stride; otherwise the report could never judge
+    DriftMonitor monitor(baseline);
+    const DriftConfig& config = monitor.getConfig();
+    size_t passes = std::max<size_t>(1, (config.minWindowRows * config.sampleStride + scoring.size() - 1) /
+                                            scoring.size());
+
+    // Same batches with and without the monitor, to show what sampling costs
+    const size_t BATCH = 256;
+    std::vector<double> out(BATCH);
+    double seconds[2];
+    for (int monitored = 0; monitored < 2; ++monitored) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t pass = 0; pass < passes; ++pass) {
+            for (size_t first = 0; first < scoring.size(); first += BATCH) {
+                size_t n = std::min(BATCH, scoring.size() - first);
+                model.predictBatch(rows.data() + first * 6, n, out.data());
+                if (monitored) {
+                    monitor.observe(rows.data() + first * 6, n);
+                }
+            }
+        }
+        seconds[monitored] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::cout << "Scored " << scoring.size() * passes << " rows (" << passes
+              << (passes == 1 ? " pass" : " passes") << " over " << scorePath << ") in batches of " << BATCH << ": "
+              << std::fixed << std::setprecision(3) << seconds[0] * 1000.0 << " ms, "
+              << seconds[1] * 1000.0 << " ms with drift sampling (1 row in "
+              << monitor.getConfig().sampleStride << ")" << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    DriftMonitor::display(monitor.report());
+    return 0;
+}
+
+// Non-interactive: sharded training and evaluation over worker processes
+int runDistributed(size_t workers, const std::string& dataPath) {
+    DistributedConfig config;
+    config.workers = workers;
+    DistributedTrainer trainer(config);
+    LinearRegression model;
+    if (!trainer.run(dataPath, model)) {
+        std::cerr << "Error: Distributed training failed on " << dataPath << std::endl;
+        return 1;
+    }
+    trainer.displayResults();
+    model.displayEquation();
+    return 0;
+}
+
+int publishDataset(const std::string& name, const std::string& dataPath) {
+    Dataset dataset;
+    if (!dataset.loadFromFile(dataPath) || !SharedDataset::publish(dataset, name)) {
+        std::cerr << "Error: Could not publish " << dataPath << " as " << name << std::endl;
+        return 1;
+    }
+    SharedDataset shared;
+    if (!shared.attach(name)) {
+        return 1;
+    }
+    std::cout << "Published " << shared.size() << " rows (" << shared.dictionarySize()
+              << " dictionary entries, " << shared.mappedBytes() << " bytes) as " << name << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // cpu_performance_predictor --print-dispatch
+    if (argc > 1 && std::string(argv[1]) == "--print-dispatch") {
+        std::cout << CpuDispatch::describe() << std::endl;
+        return 0;
+    }
+    
+    // cpu_performance_predictor --emit-header [header] [data file]
+    if (argc > 1 && std::string(argv[1]) == "--emit-header") {
+        return emitHeader(argc > 2 ? argv[2] : "cpuperf_model.h",
+                          argc > 3 ? argv[3] : "Data/machine.data");
+    }
+    
+    // cpu_performance_predictor --save-model [model file] [data file]
+    if (argc > 1 && std::string(argv[1]) == "--save-model") {
+        return saveModel(argc > 2 ? argv[2] : "cpuperf_model.txt",
+                         argc > 3 ? argv[3] : "Data/machine.data");
+    }
+    
+    // cpu_performance_predictor --drift-check [training data] [scored data]
+    if (argc > 1 && std::string(argv[1]) == "--drift-check") {
+        return driftCheck(argc > 2 ? argv[2] : "Data/machine.data",
+                          argc > 3 ? argv[3] : "Data/machine.data");
+    }
+    
+    // cpu_performance_predictor --distributed [workers] [data file]
+    if (argc > 1 && std::string(argv[1]) == "--distributed") {
+        long workers = argc > 2 ? std::strtol(argv[2], nullptr, 10) : 4;
+        if (workers <= 0) {
+            std::cerr << "Error: Worker count must be positive" << std::endl;
+            return 1;
+        }
+        return runDistributed(static_cast<size_t>(workers), argc > 3 ? argv[3] : "Data/machine.data");
+    }
+    
+    // cpu_performance_predictor --publish-dataset [name] [data file]
+    // cpu_performance_predictor --unpublish-dataset [name]
+    if (argc > 1 && std::string(argv[1]) == "--publish-dataset") {
+        return publishDataset(argc > 2 ? argv[2] : "cpuperf_dataset",
+                              argc > 3 ? argv[3] : "Data/machine.data");
+    }
+    if (argc > 1 && std::string(argv[1]) == "--unpublish-dataset") {
+        return SharedDataset::unpublish(argc > 2 ? argv[2] : "cpuperf_dataset") ? 0 : 1;
+    }
+    
+    // cpu_performance_predictor [data file]: the interactive menu
     printHeader();
     
     // Initialize components
     Dataset fullDataset, trainDataset, testDataset;
     LinearRegression model;
     
-    std::string dataFilePath = "Data/machine.data";
+    std::string dataFilePath = argc > 1 ? argv[1] : "Data/machine.data";
     bool dataLoaded = false;
     bool modelTrained = false;
+    bool modelOnSplit = false;   // trained on option 1's training split, so its test split is held out
     
     int choice;
     
@@ -111,6 +303,7 @@ int main() {
                     // Split into train/test sets (80/20)
                     std::cout << "\nSplitting dataset (80% train, 20% test)..." << std::endl;
                     fullDataset.split(0.8, trainDataset, testDataset);
+                    modelOnSplit = false;
                 } else {
                     std::cout << "Failed to load dataset!" << std::endl;
                 }
@@ -127,6 +320,7 @@ int main() {
                 std::cout << "\nTraining linear regression model..." << std::endl;
                 if (model.train(trainDataset)) {
                     modelTrained = true;
+                    modelOnSplit = true;
                     model.displayModel();
                     model.displayEquation();
                 } else {
@@ -149,6 +343,7 @@ int main() {
                 std::cout << "\nTraining Ridge regression model..." << std::endl;
                 if (model.trainWithRegularization(trainDataset, lambda)) {
                     modelTrained = true;
+                    modelOnSplit = true;
                     model.displayModel();
                     model.displayEquation();
                 } else {
@@ -159,8 +354,8 @@ int main() {
             
             case 4: {
                 // Evaluate model on test set
-                if (!modelTrained) {
-                    std::cout << "Please train the model first (option 2 or 3)!" << std::endl;
+                if (!modelOnSplit) {
+                    std::cout << "Please train the model on option 1's split first (option 2 or 3)!" << std::endl;
                     break;
                 }
                 
@@ -203,8 +398,8 @@ int main() {
             
             case 7: {
                 // Generate detailed evaluation report
-                if (!modelTrained) {
-                    std::cout << "Please train the model first (option 2 or 3)!" << std::endl;
+                if (!modelOnSplit) {
+                    std::cout << "Please train the model on option 1's split first (option 2 or 3)!" << std::endl;
                     break;
                 }
                 
@@ -230,8 +425,8 @@ int main() {
             
             case 9: {
                 // Residual analysis
-                if (!modelTrained) {
-                    std::cout << "Please train the model first (option 2 or 3)!" << std::endl;
+                if (!modelOnSplit) {
+                    std::cout << "Please train the model on option 1's split first (option 2 or 3)!" << std::endl;
                     break;
                 }
                 
@@ -240,13 +435,155 @@ int main() {
                 break;
             }
             
+            case 10: {
+                // Streaming train + evaluate over one read of the file
+                std::cout << "\nRunning streaming pipeline on: " << dataFilePath << std::endl;
+                
+                StreamingPipeline pipeline;
+                if (pipeline.run(dataFilePath, model)) {
+                    pipeline.displayResults();
+                    model.displayEquation();
+                    // The pipeline's own held-out rows were scored above; option 1's
+                    // test split overlaps its training rows, so options 4, 7 and 9 stay off
+                    modelTrained = true;
+                    modelOnSplit = false;
+                } else {
+                    std::cout << "Streaming pipeline failed!" << std::endl;
+                }
+                break;
+            }
+            
+            case 11: {
+                // Coroutine workflow: folds run in parallel with the report write
+                std::cout << "\nRunning asynchronous workflow on: " << dataFilePath << std::endl;
+                
+                AsyncWorkflow workflow;
+                AsyncWorkflow::Result result = workflow.run(dataFilePath, "async_report.txt");
+                if (!result.success) {
+                    std::cout << "Asynchronous workflow failed: " << result.error << std::endl;
+                    break;
+                }
+                
+                std::cout << std::fixed << std::setprecision(4);
+                std::cout << "Rows loaded: " << result.rows << std::endl;
+                std::cout << "Test RMSE: " << result.testRMSE << std::endl;
+                double meanRMSE = 0.0;
+                for (size_t i = 0; i < result.foldRMSEs.size(); ++i) {
+                    std::cout << "Fold " << (i + 1) << " RMSE: " << result.foldRMSEs[i] << std::endl;
+                    meanRMSE += result.foldRMSEs[i];
+                }
+                std::cout << "Mean CV RMSE: " << meanRMSE / result.foldRMSEs.size() << std::endl;
+                std::cout << "Report: async_report.txt (" << result.reportBytes << " bytes)" << std::endl;
+                std::cout << "Wall time: " << result.wallSeconds * 1000.0 << " ms" << std::endl;
+                break;
+            }
+            
+            case 12: {
+                // Both targets from one Gram matrix and one factorization
+                if (!dataLoaded) {
+                    std::cout << "Please load the dataset first (option 1)!" << std::endl;
+                    break;
+                }
+                
+                MultiTargetRegression multiModel;
+                if (multiModel.train(trainDataset)) {
+                    multiModel.displayModel();
+                    Evaluator::displayTargetMetrics(Evaluator::evaluateTargets(multiModel, testDataset));
+                } else {
+                    std::cout << "Multi-target training failed!" << std::endl;
+                }
+                break;
+            }
+            
+            case 13: {
+                // Non-linear RBF ridge on a seeded random feature map
+                if (!dataLoaded) {
+                    std::cout << "Please load the dataset first (option 1)!" << std::endl;
+                    break;
+                }
+                
+                KernelRidgeRegression kernelModel(512, 1.0);
+                if (kernelModel.fit(trainDataset)) {
+                    kernelModel.displayModel();
+                    std::cout << "Test RMSE: " << std::fixed << std::setprecision(4)
+                              << kernelModel.calculateRMSE(testDataset) << std::endl;
+                    
+                    std::string modelFile = "kernel_model.txt";
+                    if (kernelModel.save(modelFile)) {
+                        std::cout << "Model saved to: " << modelFile << std::endl;
+                    }
+                } else {
+                    std::cout << "Kernel ridge training failed!" << std::endl;
+                }
+                break;
+            }
+            
+            case 14: {
+                // Bootstrap-averaged and stacked ensembles
+                if (!dataLoaded) {
+                    std::cout << "Please load the dataset first (option 1)!" << std::endl;
+                    break;
+                }
+                
+                Ensemble bagged;
+                if (bagged.fitBagged(trainDataset, 64)) {
+                    bagged.displayModel();
+                    std::cout << "Bagged test RMSE: " << std::fixed << std::setprecision(4)
+                              << bagged.calculateRMSE(testDataset) << std::endl;
+                } else {
+                    std::cout << "Bagged ensemble training failed!" << std::endl;
+                }
+                
+                Ensemble stacked;
+                if (stacked.fitStacked(trainDataset)) {
+                    stacked.displayModel();
+                    std::cout << "Stacked test RMSE: " << std::fixed << std::setprecision(4)
+                              << stacked.calculateRMSE(testDataset) << std::endl;
+                } else {
+                    std::cout << "Stacked ensemble training failed!" << std::endl;
+                }
+                break;
+            }
+            
+            case 15: {
+                // constexpr coefficients and an unrolled predict for embedding
+                if (!modelTrained) {
+                    std::cout << "Please train the model first (option 2 or 3)!" << std::endl;
+                    break;
+                }
+                
+                std::string headerFile = "cpuperf_model.h";
+                if (model.exportHeader(headerFile)) {
+                    std::cout << "Model header written to: " << headerFile << std::endl;
+                }
+                break;
+            }
+            
+            case 16: {
+                // Shards trained in worker processes, merged by this process
+                std::cout << "\nRunning 4 worker processes on: " << dataFilePath << std::endl;
+                
+                DistributedTrainer trainer;
+                if (trainer.run(dataFilePath, model)) {
+                    trainer.displayResults();
+                    model.displayEquation();
+                    // Only the workers' held-out metrics apply: option 1's test split
+                    // overlaps the hash split the workers trained on
+                    modelTrained = true;
+                    modelOnSplit = false;
+                } else {
+                    std::cout << "Distributed training failed!" << std::endl;
+                }
+                break;
+            }
+            
             case 0: {
                 std::cout << "\nThank you for using CPU Performance Predictor!" << std::endl;
                 return 0;
             }
             
             default: {
-                std::cout << "Invalid option! Please choose 0-9." << std::endl;
+                std::cout << "Invalid option! Please choose 0-16." << std::endl;
                 break;
             }
         }
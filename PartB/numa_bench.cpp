@@ -0,0 +1,206 @@
+#include "include/HugePages.h"
+#include "include/Matrix.h"
+#include "include/Numa.h"
+#include "include/Parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Per-node scan bandwidth under different page placements
+ *
+ * One array is scanned by pinned parallelFor blocks after four placements:
+ * filled by the calling thread (every page on one node), first touched by
+ * the owning blocks (NodeLocalArray), bound per block with mbind, and
+ * interleaved across nodes. For each placement it reports the bandwidth
+ * each node's blocks reach and the share of sampled pages that are local to
+ * the block scanning them. A Gram build over a tall matrix then compares
+ * pinned and unpinned threads. On a single-node host all placements are
+ * equivalent and the numbers only show the pinning overhead.
+ *
+ * Usage: numa_bench [megabytes]   (default 512)
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+const int REPEATS = 5;
+// Elements per block at least; large enough that every block spans many pages
+const size_t GRAIN = 1 << 20;
+// Page placement is sampled every SAMPLE_STRIDE pages
+const size_t PAGE_BYTES = 4096;
+const size_t SAMPLE_STRIDE = 64;
+
+struct Placement {
+    std::string name;
+    std::vector<double> nodeBandwidth;   // GB/s reached by each node's blocks
+    double totalBandwidth = 0.0;
+    double localShare = 0.0;             // sampled pages on their block's node
+};
+
+// Scan with the NodeLocalArray partition. A node's bandwidth is its bytes
+// over the span from its first block starting to its last block finishing,
+// best of REPEATS.
+Placement scan(const std::string& name, const double* values, size_t count) {
+    size_t blocks = Parallel::blockCount(count, GRAIN);
+    size_t nodes = Numa::nodeCount();
+    std::vector<double> blockStart(blocks), blockEnd(blocks), blockSums(blocks);
+    std::vector<double> nodeSeconds(nodes, 1e300);
+    double bestWall = 1e300;
+    for (int r = 0; r < REPEATS; ++r) {
+        auto start = Clock::now();
+        Parallel::parallelFor(count, GRAIN, [&](size_t block, size_t begin, size_t end) {
+            blockStart[block] = std::chrono::duration<double>(Clock::now() - start).count();
+            double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+            size_t i = begin;
+            for (; i + 4 <= end; i += 4) {
+                sum0 += values[i];
+                sum1 += values[i + 1];
+                sum2 += values[i + 2];
+                sum3 += values[i + 3];
+            }
+            for (; i < end; ++i) {
+                sum0 += values[i];
+            }
+            blockSums[block] = sum0 + sum1 + sum2 + sum3;
+            blockEnd[block] = std::chrono::duration<double>(Clock::now() - start).count();
+        });
+        bestWall = std::min(bestWall, std::chrono::duration<double>(Clock::now() - start).count());
+        std::vector<double> first(nodes, 1e300), last(nodes, 0.0);
+        for (size_t b = 0; b < blocks; ++b) {
+            size_t node = Numa::nodeForBlock(b, blocks);
+            first[node] = std::min(first[node], blockStart[b]);
+            last[node] = std::max(last[node], blockEnd[b]);
+        }
+        for (size_t n = 0; n < nodes; ++n) {
+            if (last[n] > first[n]) {
+                nodeSeconds[n] = std::min(nodeSeconds[n], last[n] - first[n]);
+            }
+        }
+    }
+
+    Placement result;
+    result.name = name;
+    result.totalBandwidth = static_cast<double>(count * sizeof(double)) / bestWall / 1e9;
+    std::vector<double> nodeBytes(nodes, 0.0);
+    size_t perBlock = (count + blocks - 1) / blocks;
+    size_t samples = 0, local = 0;
+    const size_t pageValues = PAGE_BYTES / sizeof(double);
+    for (size_t b = 0; b < blocks; ++b) {
+        size_t begin = std::min(count, b * perBlock);
+        size_t end = std::min(count, begin + perBlock);
+        size_t node = Numa::nodeForBlock(b, blocks);
+        nodeBytes[node] += static_cast<double>((end - begin) * sizeof(double));
+        for (size_t i = begin; i < end; i += SAMPLE_STRIDE * pageValues) {
+            int where = Numa::nodeOfAddress(values + i);
+            if (where >= 0) {
+                ++samples;
+                local += static_cast<size_t>(where) == node ? 1 : 0;
+            }
+        }
+    }
+    for (size_t n = 0; n < nodes; ++n) {
+        result.nodeBandwidth.push_back(nodeBytes[n] > 0.0 ? nodeBytes[n] / nodeSeconds[n] / 1e9 : 0.0);
+    }
+    result.localShare = samples > 0 ? static_cast<double>(local) / static_cast<double>(samples) : -1.0;
+    return result;
+}
+
+void printPlacement(const Placement& placement) {
+    std::cout << std::left << std::setw(14) << placement.name << std::right << std::fixed << std::setprecision(2);
+    for (double bandwidth : placement.nodeBandwidth) {
+        std::cout << std::setw(10) << bandwidth;
+    }
+    std::cout << std::setw(10) << placement.totalBandwidth;
+    if (placement.localShare >= 0.0) {
+        std::cout << std::setw(9) << std::setprecision(0) << placement.localShare * 100.0 << "%";
+    } else {
+        std::cout << std::setw(10) << "n/a";
+    }
+    std::cout << std::endl;
+}
+
+// Fill from the calling thread only, after an optional placement policy
+Placement scanSerial(const std::string& name, size_t count, bool interleaved) {
+    size_t bytes = count * sizeof(double);
+    double* values = static_cast<double*>(Numa::allocatePages(bytes));
+    if (values == nullptr) {
+        throw std::bad_alloc();
+    }
+    if (interleaved) {
+        Numa::interleave(values, bytes);
+    }
+    std::fill(values, values + count, 1.0);
+    Placement result = scan(name, values, count);
+    Numa::freePages(values, bytes);
+    return result;
+}
+
+Placement scanLocal(const std::string& name, size_t count, Parallel::NodeLocalArray<double>::Placement placement) {
+    Parallel::NodeLocalArray<double> values(count, GRAIN, placement, 1.0);
+    return scan(name, values.data(), count);
+}
+
+double gramSeconds(size_t rows, size_t cols) {
+    Matrix X(rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            X(i, j) = static_cast<double>((i * 31 + j * 17) % 1009) * 0.001;
+        }
+    }
+    double best = 1e300;
+    for (int r = 0; r < REPEATS; ++r) {
+        auto start = Clock::now();
+        Matrix gram = X.transposed() * X;
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+        if (gram(0, 0) < 0.0) {
+            std::cout << "unexpected Gram" << std::endl;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long megabytes = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 512;
+    if (megabytes <= 0) {
+        std::cerr << "Error: Size must be a positive number of megabytes" << std::endl;
+        return 1;
+    }
+    size_t count = static_cast<size_t>(megabytes) * (1 << 20) / sizeof(double);
+
+    std::cout << "NUMA nodes: " << Numa::nodeCount() << ", threads: " << Parallel::threadCount()
+              << ", blocks: " << Parallel::blockCount(count, GRAIN) << std::endl;
+    for (size_t n = 0; n < Numa::nodeCount(); ++n) {
+        std::cout << "  node " << n << ": " << Numa::nodeCpus(n).size() << " CPUs" << std::endl;
+    }
+
+    Parallel::setPinning(true);
+    std::cout << "\nScan of " << megabytes << " MB, GB/s per node, total, local pages" << std::endl;
+    std::cout << std::left << std::setw(14) << "placement" << std::right;
+    for (size_t n = 0; n < Numa::nodeCount(); ++n) {
+        std::cout << std::setw(10) << ("node " + std::to_string(n));
+    }
+    std::cout << std::setw(10) << "total" << std::setw(10) << "local" << std::endl;
+    printPlacement(scanSerial("serial fill", count, false));
+    printPlacement(scanLocal("first touch", count, Parallel::NodeLocalArray<double>::FIRST_TOUCH));
+    printPlacement(scanLocal("bind", count, Parallel::NodeLocalArray<double>::BIND));
+    printPlacement(scanSerial("interleave", count, true));
+
+    // Matrix rows are allocated by the same blocks the Gram kernel scans with
+    size_t rows = std::max<size_t>(1 << 16, count / 8 / 4);
+    const size_t cols = 8;
+    double pinned = gramSeconds(rows, cols);
+    Parallel::setPinning(false);
+    double unpinned = gramSeconds(rows, cols);
+    std::cout << "\nGram X^T X, " << rows << " x " << cols << ": pinned " << std::setprecision(2)
+              << pinned * 1e3 << " ms, unpinned " << unpinned * 1e3 << " ms" << std::endl;
+    std::cout << "Huge pages: " << HugePages::describe(HugePages::coverage()) << std::endl;
+    return 0;
+}
@@ -0,0 +1,79 @@
+# Training run for the profile-guided build: drives the instrumented
+# binaries over synthetic data, the UCI data and the benchmark suite, then
+# (Clang only) merges the raw profiles into default.profdata.
+#
+#   cmake -DBIN_DIR=<bin> -DSOURCE_DIR=<repo> -DWORK_DIR=<scratch>
+#         -DPROFILE_DIR=<profiles> [-DLLVM_PROFDATA=<tool>] [-DROWS=<n>]
+#         -P pgo/RunWorkload.cmake
+#
+# Every input is generated from a fixed seed or checked in (the menu
+# sessions next to this file), so the profile is the same on every run.
+
+foreach(var BIN_DIR SOURCE_DIR WORK_DIR PROFILE_DIR)
+    if(NOT ${var})
+        message(FATAL_ERROR "RunWorkload.cmake: ${var} is not set")
+    endif()
+endforeach()
+if(NOT ROWS)
+    set(ROWS 200000)
+endif()
+
+# Start from an empty profile so stale counts from older builds never mix in
+file(GLOB stale_profiles ${PROFILE_DIR}/*.gcda ${PROFILE_DIR}/*.profraw ${PROFILE_DIR}/*.profdata)
+if(stale_profiles)
+    file(REMOVE ${stale_profiles})
+endif()
+file(MAKE_DIRECTORY ${WORK_DIR} ${PROFILE_DIR})
+
+set(UCI_DATA ${SOURCE_DIR}/Data/machine.data)
+set(SYNTHETIC_DATA ${WORK_DIR}/synthetic.data)
+
+# run(<label> [INPUT <file>] COMMAND <args...>): output goes to <label>.log
+function(run label)
+    cmake_parse_arguments(RUN "" "INPUT" "COMMAND" ${ARGN})
+    set(input_args)
+    if(RUN_INPUT)
+        set(input_args INPUT_FILE ${RUN_INPUT})
+    endif()
+    message(STATUS "PGO workload: ${label}")
+    execute_process(
+        COMMAND ${RUN_COMMAND}
+        WORKING_DIRECTORY ${WORK_DIR}
+        ${input_args}
+        OUTPUT_FILE ${WORK_DIR}/${label}.log
+        ERROR_FILE ${WORK_DIR}/${label}.log
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "PGO workload step '${label}' failed (${result}), see ${WORK_DIR}/${label}.log")
+    endif()
+endfunction()
+
+# Loader, trainers and evaluation on synthetic rows (also writes SYNTHETIC_DATA)
+run(train COMMAND ${BIN_DIR}/cpu_performance_pgo_train ${WORK_DIR} ${ROWS})
+
+# Menu orchestration: every option on the UCI data, the scan-heavy ones at scale
+run(menu COMMAND ${BIN_DIR}/cpu_performance_predictor ${UCI_DATA}
+    INPUT ${CMAKE_CURRENT_LIST_DIR}/menu_session.txt)
+run(menu_large COMMAND ${BIN_DIR}/cpu_performance_predictor ${SYNTHETIC_DATA}
+    INPUT ${CMAKE_CURRENT_LIST_DIR}/menu_session_large.txt)
+run(emit_header COMMAND ${BIN_DIR}/cpu_performance_predictor --emit-header ${WORK_DIR}/cpuperf_model.h ${SYNTHETIC_DATA})
+run(distributed COMMAND ${BIN_DIR}/cpu_performance_predictor --distributed 2 ${SYNTHETIC_DATA})
+
+# Benchmark suite at reduced sizes
+run(bench COMMAND ${BIN_DIR}/cpu_performance_bench 8 5000)
+run(bench_predict COMMAND ${BIN_DIR}/cpu_performance_predict_bench ${UCI_DATA} 2000000)
+run(bench_kernels COMMAND ${BIN_DIR}/cpu_performance_kernel_bench)
+run(bench_numa COMMAND ${BIN_DIR}/cpu_performance_numa_bench 64)
+run(bench_scan COMMAND ${BIN_DIR}/cpu_performance_scan_bench 64)
+run(save_model COMMAND ${BIN_DIR}/cpu_performance_predictor --save-model ${WORK_DIR}/cpuperf_model.txt ${UCI_DATA})
+run(bench_ffi COMMAND ${BIN_DIR}/cpu_performance_ffi_bench ${WORK_DIR}/cpuperf_model.txt)
+run(drift_check COMMAND ${BIN_DIR}/cpu_performance_predictor --drift-check ${UCI_DATA} ${SYNTHETIC_DATA})
+
+# GCC reads the .gcda files in place; Clang needs its raw profiles merged
+if(LLVM_PROFDATA)
+    file(GLOB raw_profiles ${PROFILE_DIR}/*.profraw)
+    run(merge COMMAND ${LLVM_PROFDATA} merge -o ${PROFILE_DIR}/default.profdata ${raw_profiles})
+endif()
+
+message(STATUS "PGO profile written to ${PROFILE_DIR}")
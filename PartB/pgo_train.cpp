@@ -0,0 +1,179 @@
+#include "include/Dataset.h"
+#include "include/Ensemble.h"
+#include "include/Evaluator.h"
+#include "include/KernelRidgeRegression.h"
+#include "include/LinearRegression.h"
+#include "include/MultiTargetRegression.h"
+#include "include/SplitMix64.h"
+#include "include/StreamingPipeline.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Training workload for the profile-guided build
+ *
+ * Writes a synthetic dataset in the machine.data layout from a fixed seed
+ * (vendor and model strings, six hardware columns drawn from ranges like
+ * the UCI data, PRP and ERP from a noisy linear law), then drives the
+ * library the way the predictor does: load, split, least squares, ridge,
+ * cross-validation, evaluation report, streaming pipeline, multi-target,
+ * kernel ridge, ensembles and per-row prediction. The instrumented build
+ * runs it (pgo/RunWorkload.cmake) next to the scripted menu session and
+ * the benchmarks, so the profile is the same on every machine.
+ *
+ * Per-stage times are printed at the end; run it against the plain and the
+ * profile-optimized builds to compare.
+ *
+ * Usage: pgo_train <work dir> [rows]   (default 200000)
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+const uint64_t SEED = 0x5EEDC0FFEEULL;
+// Kernel ridge and the ensembles refit many times; a prefix keeps them short
+const size_t HEAVY_ROWS = 2000;
+const char* const VENDORS[] = {"adviser", "amdahl", "apollo", "basf", "bti", "burroughs", "c.r.d",
+                               "cambex", "cdc", "dec", "dg", "formation", "four-phase", "gould",
+                               "harris", "honeywell", "hp", "ibm", "ipl", "magnuson", "microdata",
+                               "nas", "ncr", "nixdorf", "perkin-elmer", "prime", "siemens", "sperry",
+                               "sratus", "wang"};
+const size_t VENDOR_COUNT = sizeof(VENDORS) / sizeof(VENDORS[0]);
+
+// Integer in [low, high], skewed toward low like the memory and cache columns
+long skewed(SplitMix64& random, long low, long high) {
+    double u = random.uniform();
+    return low + static_cast<long>(u * u * static_cast<double>(high - low));
+}
+
+bool writeSynthetic(const std::string& path, size_t rows) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Error: Cannot write " << path << std::endl;
+        return false;
+    }
+    SplitMix64 random(SEED);
+    for (size_t i = 0; i < rows; ++i) {
+        long myct = skewed(random, 17, 1500);
+        long mmin = skewed(random, 64, 32000);
+        long mmax = mmin + skewed(random, 0, 64000 - mmin);
+        long cach = skewed(random, 0, 256);
+        long chmin = skewed(random, 0, 52);
+        long chmax = chmin + skewed(random, 0, 176 - chmin);
+        double law = -56.0 + 0.049 * myct + 0.015 * mmin + 0.0056 * mmax + 0.64 * cach
+                     - 0.27 * chmin + 1.48 * chmax;
+        long prp = std::max(6L, std::lround(law + (random.uniform() - 0.5) * 0.2 * std::fabs(law)));
+        long erp = std::max(15L, std::lround(law * 0.9 + (random.uniform() - 0.5) * 20.0));
+        out << VENDORS[random.next() % VENDOR_COUNT] << ',' << 'm' << (random.next() % 5000) << '/'
+            << (i % 97) << ',' << myct << ',' << mmin << ',' << mmax << ',' << cach << ','
+            << chmin << ',' << chmax << ',' << prp << ',' << erp << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+Dataset prefix(const Dataset& data, size_t rows) {
+    Dataset result;
+    for (size_t i = 0; i < std::min(rows, data.size()); ++i) {
+        result.addDataPoint(data[i]);
+    }
+    return result;
+}
+
+struct Stage {
+    std::string name;
+    double seconds;
+};
+
+// Runs fn with the library's console output discarded and records its time
+template <typename Fn>
+bool timed(std::vector<Stage>& stages, const std::string& name, Fn fn) {
+    std::streambuf* out = std::cout.rdbuf(nullptr);
+    auto start = Clock::now();
+    bool ok = fn();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout.rdbuf(out);
+    stages.push_back({name, seconds});
+    if (!ok) {
+        std::cerr << "Error: Stage failed: " << name << std::endl;
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: pgo_train <work dir> [rows]" << std::endl;
+        return 1;
+    }
+    std::string dir = argv[1];
+    size_t rows = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+    std::string dataPath = dir + "/synthetic.data";
+
+    std::vector<Stage> stages;
+    Dataset full, train, test, heavyTrain, heavyTest;
+    LinearRegression model;
+    bool ok =
+        timed(stages, "write synthetic data", [&] { return writeSynthetic(dataPath, rows); }) &&
+        timed(stages, "load", [&] { return full.loadFromFile(dataPath); }) &&
+        timed(stages, "split", [&] {
+            full.split(0.8, train, test);
+            Dataset heavy = prefix(full, HEAVY_ROWS);
+            heavy.split(0.8, heavyTrain, heavyTest);
+            return !train.empty() && !heavyTrain.empty();
+        }) &&
+        timed(stages, "least squares", [&] { return model.train(train); }) &&
+        timed(stages, "ridge", [&] { return model.trainWithRegularization(train, 0.01); }) &&
+        timed(stages, "cross-validation", [&] { return model.crossValidate(full, 5) >= 0.0; }) &&
+        timed(stages, "evaluation report", [&] {
+            Evaluator evaluator(&model);
+            Evaluator::EvaluationResults results = evaluator.evaluate(test);
+            evaluator.generateReport(test, dir + "/evaluation_report.txt");
+            evaluator.residualAnalysis(test);
+            return std::isfinite(results.rmse);
+        }) &&
+        timed(stages, "per-row predict", [&] {
+            double sum = 0.0;
+            for (size_t i = 0; i < test.size(); ++i) {
+                sum += model.predict(test[i]);
+            }
+            return std::isfinite(sum);
+        }) &&
+        timed(stages, "streaming pipeline", [&] {
+            StreamingPipeline pipeline;
+            LinearRegression streamed;
+            return pipeline.run(dataPath, streamed);
+        }) &&
+        timed(stages, "multi-target", [&] {
+            MultiTargetRegression multiModel;
+            return multiModel.train(train) && !Evaluator::evaluateTargets(multiModel, test).empty();
+        }) &&
+        timed(stages, "kernel ridge", [&] {
+            KernelRidgeRegression kernelModel(256, 1.0);
+            return kernelModel.fit(heavyTrain) && std::isfinite(kernelModel.calculateRMSE(heavyTest));
+        }) &&
+        timed(stages, "ensembles", [&] {
+            Ensemble bagged, stacked;
+            return bagged.fitBagged(heavyTrain, 16) && stacked.fitStacked(heavyTrain) &&
+                   std::isfinite(bagged.calculateRMSE(heavyTest) + stacked.calculateRMSE(heavyTest));
+        });
+
+    double total = 0.0;
+    std::cout << std::left << std::setw(24) << "stage" << std::right << std::setw(12) << "ms" << std::endl;
+    for (const Stage& stage : stages) {
+        std::cout << std::left << std::setw(24) << stage.name << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(12) << stage.seconds * 1e3 << std::endl;
+        total += stage.seconds;
+    }
+    std::cout << std::left << std::setw(24) << "total" << std::right << std::setw(12) << total * 1e3
+              << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+#include "include/Dataset.h"
+#include "include/LinearRegression.h"
+#include "include/ScoringKernel.h"
+#include "cpuperf_model.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Benchmark of the generated model header against the runtime predict
+ *
+ * cpuperf_model.h is emitted at build time by
+ * `cpu_performance_predictor --emit-header` from the full dataset. The same
+ * model is trained here, and both scoring paths run over the same rows:
+ * LinearRegression::predict(const std::vector<double>&), which validates
+ * the model state and the feature count on every call, and the generated
+ * constexpr predict() with its unrolled dot product.
+ *
+ * A second section sweeps the feature count through ScoringKernel: the
+ * generic loop over coefficients.size() against the dispatched kernel, in
+ * GB/s of rows read and scores written, next to a plain streaming read of
+ * the same buffer.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Each feature count scores this many bytes of rows, best of REPEATS runs
+const size_t SWEEP_BYTES = size_t(32) << 20;
+const int REPEATS = 5;
+
+// Best of REPEATS runs, which filters out scheduling noise
+template <typename Fn>
+double gigabytesPerSecond(size_t bytes, Fn fn) {
+    double best = 0.0;
+    for (int r = 0; r < REPEATS; ++r) {
+        auto start = Clock::now();
+        fn();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        best = std::max(best, double(bytes) / seconds / 1e9);
+    }
+    return best;
+}
+
+// Generic loop vs dispatched kernel for one feature count; false on mismatch
+bool sweepFeatureCount(size_t features, std::mt19937_64& random) {
+    size_t count = SWEEP_BYTES / (features * sizeof(double));
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::vector<double> rows(count * features);
+    std::vector<double> coefficients(features);
+    for (double& value : rows) value = uniform(random);
+    for (double& value : coefficients) value = uniform(random);
+
+    ScoringKernel kernel(coefficients, 0.5);
+    std::vector<double> generic(count);
+    std::vector<double> dispatched(count);
+    size_t bytes = rows.size() * sizeof(double);
+    size_t scoredBytes = bytes + count * sizeof(double);
+
+    double genericRate = gigabytesPerSecond(scoredBytes, [&]() {
+        ScoringKernel::scoreGeneric(coefficients.data(), features, 0.5, rows.data(), count, generic.data());
+    });
+    double kernelRate = gigabytesPerSecond(scoredBytes, [&]() {
+        kernel.score(rows.data(), count, dispatched.data());
+    });
+
+    volatile double sink = 0.0;   // keeps the streaming read alive
+    double stream = gigabytesPerSecond(bytes, [&]() {
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        for (size_t i = 0; i + 4 <= rows.size(); i += 4) {
+            s0 += rows[i];
+            s1 += rows[i + 1];
+            s2 += rows[i + 2];
+            s3 += rows[i + 3];
+        }
+        sink = s0 + s1 + s2 + s3;
+    });
+
+    bool identical = generic == dispatched;
+    std::cout << std::setw(6) << features << std::setw(14) << kernel.kernelName()
+              << std::fixed << std::setprecision(2) << std::setw(10) << genericRate
+              << std::setw(10) << kernelRate << std::setw(10) << stream
+              << std::setw(9) << std::setprecision(0) << 100.0 * kernelRate / stream << "%"
+              << (identical ? "" : "  DIFFER") << std::endl;
+    return identical;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string dataPath = argc > 1 ? argv[1] : "Data/machine.data";
+    size_t predictions = argc > 2 ? std::stoul(argv[2]) : 20000000;
+
+    Dataset dataset;
+    LinearRegression model;
+    if (!dataset.loadFromFile(dataPath) || !model.train(dataset)) {
+        std::cerr << "Error: Could not train a model from " << dataPath << std::endl;
+        return 1;
+    }
+
+    // The header must describe the model trained here
+    const std::vector<double>& coefficients = model.getCoefficients();
+    for (size_t j = 0; j < cpuperf_model::FEATURE_COUNT; ++j) {
+        if (coefficients[j] != cpuperf_model::COEFFICIENTS[j]) {
+            std::cerr << "Error: cpuperf_model.h was generated from a different model" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<std::vector<double>> rows;
+    std::vector<double> flat;
+    for (size_t i = 0; i < dataset.size(); ++i) {
+        rows.push_back(dataset[i].getFeatureVector());
+        flat.insert(flat.end(), rows.back().begin(), rows.back().end());
+    }
+    size_t passes = std::max<size_t>(1, predictions / rows.size());
+    size_t total = passes * rows.size();
+
+    std::cout << "\n=== Predict benchmark: runtime vs generated header ===" << std::endl;
+    std::cout << "Rows: " << rows.size() << ", passes: " << passes
+              << ", predictions: " << total << std::endl;
+
+    double runtimeSum = 0.0;
+    auto start = Clock::now();
+    for (size_t pass = 0; pass < passes; ++pass) {
+        for (const std::vector<double>& x : rows) {
+            runtimeSum += model.predict(x);
+        }
+    }
+    double runtimeSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    double generatedSum = 0.0;
+    start = Clock::now();
+    for (size_t pass = 0; pass < passes; ++pass) {
+        for (size_t i = 0; i < rows.size(); ++i) {
+            generatedSum += cpuperf_model::predict(flat.data() + i * cpuperf_model::FEATURE_COUNT);
+        }
+    }
+    double generatedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> batchOut(rows.size());
+    start = Clock::now();
+    for (size_t pass = 0; pass < passes; ++pass) {
+        cpuperf_model::predictBatch(flat.data(), rows.size(), batchOut.data());
+    }
+    double batchSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    bool batchIdentical = true;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        batchIdentical = batchIdentical && batchOut[i] == model.predict(rows[i]);
+    }
+
+    auto report = [total, runtimeSeconds](const std::string& name, double seconds) {
+        std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(10) << seconds * 1e9 / total << " ns/prediction"
+                  << std::setw(10) << runtimeSeconds / seconds << "x" << std::endl;
+    };
+    report("LinearRegression::predict", runtimeSeconds);
+    report("cpuperf_model::predict", generatedSeconds);
+    report("cpuperf_model::predictBatch", batchSeconds);
+
+    bool identical = runtimeSum == generatedSum && batchIdentical;
+    std::cout << "Results " << (identical ? "match" : "DIFFER") << " (" << std::setprecision(4)
+              << "checksum " << runtimeSum << ")" << std::endl;
+
+    std::cout << "\n=== Scoring kernels by feature count (GB/s read + written, "
+              << (SWEEP_BYTES >> 20) << " MB batch) ===" << std::endl;
+    std::cout << std::setw(6) << "p" << std::setw(14) << "kernel" << std::setw(10) << "generic"
+              << std::setw(10) << "dispatch" << std::setw(10) << "stream" << std::setw(10) << "of stream" << std::endl;
+    std::mt19937_64 random(42);
+    for (size_t features : {1, 2, 4, 6, 8, 16, 32, 64, 65, 128, 512}) {
+        identical = sweepFeatureCount(features, random) && identical;
+    }
+    return identical ? 0 : 1;
+}
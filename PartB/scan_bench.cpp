@@ -0,0 +1,209 @@
+#include "include/HugePages.h"
+#include "include/Matrix.h"
+#include "include/ScanTuning.h"
+#include "include/ScoringKernel.h"
+#include "include/Summation.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Prefetch distance and streaming-store sweeps for the scan kernels
+ *
+ * Runs each ScanTuning kernel over data sized well past the last-level
+ * cache: PREDICT scores a row-major 6-feature batch into a bulk output
+ * buffer, METRICS takes the compensated squared differences of two
+ * columns, and GRAM forms X^T X over a tall 8-column matrix. Every kernel
+ * is timed with prefetching off and at several distances, PREDICT also
+ * with streaming stores, and every result is checked against the untuned
+ * run. The fastest setting per kernel is printed as environment variables;
+ * the defaults in ScanTuning.cpp came from this sweep.
+ *
+ * Usage: scan_bench [megabytes]   (default 1024; pick more than the LLC)
+ */
+
+using Clock = std::chrono::steady_clock;
+using Buffer = std::vector<double, HugePages::Allocator<double>>;
+
+namespace {
+
+const int REPEATS = 3;
+const size_t DISTANCES[] = {0, 256, 1024, 4096, 16384};
+
+template <typename Fn>
+double bestSeconds(Fn fn) {
+    double best = 1e300;
+    for (int r = 0; r < REPEATS; ++r) {
+        auto start = Clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+struct Best {
+    ScanTuning::Settings settings;
+    double seconds = 1e300;
+};
+
+void printRow(const std::string& label, double seconds, double bytes, double baseline, bool same) {
+    std::cout << std::left << std::setw(22) << label << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << seconds * 1e3 << std::setw(10) << bytes / seconds / 1e9
+              << std::setw(9) << std::showpos << (baseline / seconds - 1.0) * 100.0 << std::noshowpos << "%"
+              << (same ? "" : "  MISMATCH") << std::endl;
+}
+
+void printHeader(const std::string& title) {
+    std::cout << "\n=== " << title << " ===" << std::endl;
+    std::cout << std::left << std::setw(22) << "setting" << std::right << std::setw(10) << "ms"
+              << std::setw(10) << "GB/s" << std::setw(10) << "speedup" << std::endl;
+}
+
+bool benchPredict(size_t megabytes, Best& best) {
+    ScanTuning::Settings defaults = ScanTuning::get(ScanTuning::PREDICT);
+    const size_t features = 6;
+    size_t rows = megabytes * (1 << 20) / (features * sizeof(double));
+    Buffer input(rows * features);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<double>((i * 37) % 1021) * 0.01;
+    }
+    ScoringKernel scorer({0.5, -0.25, 0.125, 1.5, -2.0, 0.75}, 3.0);
+    Buffer reference(rows), output(rows);
+    double bytes = static_cast<double>((input.size() + rows) * sizeof(double));
+
+    printHeader("PREDICT, " + std::to_string(rows) + " rows x 6");
+    double baseline = 0.0;
+    bool ok = true;
+    for (bool streaming : {false, true}) {
+        for (size_t distance : DISTANCES) {
+            ScanTuning::Settings settings;
+            settings.prefetchBytes = distance;
+            settings.streamingStores = streaming;
+            ScanTuning::set(ScanTuning::PREDICT, settings);
+            Buffer& target = baseline == 0.0 ? reference : output;
+            double seconds = bestSeconds([&]() { scorer.score(input.data(), rows, target.data()); });
+            bool same = &target == &reference || std::equal(output.begin(), output.end(), reference.begin());
+            if (baseline == 0.0) {
+                baseline = seconds;
+            }
+            ok = ok && same;
+            printRow(std::string(streaming ? "stream, " : "") + "prefetch " + std::to_string(distance),
+                     seconds, bytes, baseline, same);
+            if (seconds < best.seconds) {
+                best.settings = settings;
+                best.seconds = seconds;
+            }
+        }
+    }
+    ScanTuning::set(ScanTuning::PREDICT, defaults);
+    return ok;
+}
+
+bool benchMetrics(size_t megabytes, Best& best) {
+    ScanTuning::Settings defaults = ScanTuning::get(ScanTuning::METRICS);
+    size_t n = megabytes * (1 << 20) / (2 * sizeof(double));
+    Buffer predicted(n), actual(n);
+    for (size_t i = 0; i < n; ++i) {
+        actual[i] = static_cast<double>(i % 977);
+        predicted[i] = actual[i] + static_cast<double>((i * 13) % 17) * 0.1 - 0.8;
+    }
+    double bytes = static_cast<double>(2 * n * sizeof(double));
+
+    printHeader("METRICS, squared differences of 2 x " + std::to_string(n));
+    double baseline = 0.0, reference = 0.0;
+    bool ok = true;
+    for (size_t distance : DISTANCES) {
+        ScanTuning::Settings settings;
+        settings.prefetchBytes = distance;
+        ScanTuning::set(ScanTuning::METRICS, settings);
+        double value = 0.0;
+        double seconds = bestSeconds([&]() { value = Summation::squaredDifferences(predicted.data(), actual.data(), n); });
+        if (baseline == 0.0) {
+            baseline = seconds;
+            reference = value;
+        }
+        ok = ok && value == reference;
+        printRow("prefetch " + std::to_string(distance), seconds, bytes, baseline, value == reference);
+        if (seconds < best.seconds) {
+            best.settings = settings;
+            best.seconds = seconds;
+        }
+    }
+    ScanTuning::set(ScanTuning::METRICS, defaults);
+    return ok;
+}
+
+bool benchGram(size_t megabytes, Best& best) {
+    ScanTuning::Settings defaults = ScanTuning::get(ScanTuning::GRAM);
+    const size_t cols = 8;
+    // Each row is its own heap block, so keep the row data to a quarter of the budget
+    size_t rows = megabytes * (1 << 20) / 4 / (cols * sizeof(double));
+    Matrix X(rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            X(i, j) = static_cast<double>((i * 31 + j * 17) % 1009) * 0.001;
+        }
+    }
+    double bytes = static_cast<double>(rows * cols * sizeof(double));
+
+    printHeader("GRAM, X^T X of " + std::to_string(rows) + " x 8");
+    double baseline = 0.0;
+    Matrix reference;
+    bool ok = true;
+    for (size_t distance : DISTANCES) {
+        ScanTuning::Settings settings;
+        settings.prefetchBytes = distance;
+        ScanTuning::set(ScanTuning::GRAM, settings);
+        Matrix gram;
+        double seconds = bestSeconds([&]() { gram = X.transposed() * X; });
+        if (baseline == 0.0) {
+            baseline = seconds;
+            reference = gram;
+        }
+        bool same = true;
+        for (size_t r = 0; r < cols; ++r) {
+            for (size_t c = 0; c < cols; ++c) {
+                same = same && gram(r, c) == reference(r, c);
+            }
+        }
+        ok = ok && same;
+        printRow("prefetch " + std::to_string(distance), seconds, bytes, baseline, same);
+        if (seconds < best.seconds) {
+            best.settings = settings;
+            best.seconds = seconds;
+        }
+    }
+    ScanTuning::set(ScanTuning::GRAM, defaults);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long megabytes = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 1024;
+    if (megabytes <= 0) {
+        std::cerr << "Error: Size must be a positive number of megabytes" << std::endl;
+        return 1;
+    }
+
+    Best best[ScanTuning::KERNEL_COUNT];
+    bool ok = benchPredict(static_cast<size_t>(megabytes), best[ScanTuning::PREDICT]);
+    ok = benchMetrics(static_cast<size_t>(megabytes), best[ScanTuning::METRICS]) && ok;
+    ok = benchGram(static_cast<size_t>(megabytes), best[ScanTuning::GRAM]) && ok;
+
+    std::cout << "\nFastest settings:" << std::endl;
+    for (int k = 0; k < ScanTuning::KERNEL_COUNT; ++k) {
+        const char* name = ScanTuning::kernelName(static_cast<ScanTuning::Kernel>(k));
+        std::cout << "  CPUPERF_PREFETCH_" << name << "=" << best[k].settings.prefetchBytes;
+        if (k == ScanTuning::PREDICT) {
+            std::cout << " CPUPERF_STREAM_" << name << "=" << (best[k].settings.streamingStores ? 1 : 0);
+        }
+        std::cout << std::endl;
+    }
+    std::cout << (ok ? "\nAll results match" : "\nResults DIFFER") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+// Built as C++20 (coroutines); see CMakeLists.txt / Makefile
+#include "../include/AsyncWorkflow.h"
+#include "../include/AsyncTask.h"
+#include "../include/Dataset.h"
+#include "../include/FileIO.h"
+#include "../include/LinearRegression.h"
+#include "../include/NormalEquations.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+// ============================================================================
+// IoService
+// ============================================================================
+
+IoService::IoService(ThreadPool& computePool, unsigned threads)
+    : computePool(computePool), stopping(false) {
+    for (unsigned i = 0; i < std::max(1u, threads); ++i) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+IoService::~IoService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void IoService::post(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    ready.notify_one();
+}
+
+void IoService::workerLoop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+// Read a whole file through FileReader (io_uring where available)
+IoOperation<std::string> IoService::readFile(const std::string& filename) {
+    auto state = std::make_shared<IoOperation<std::string>::State>();
+    state->resumeOn = &computePool;
+    post([state, filename]() {
+        FileReader reader;
+        std::string content;
+        if (!reader.open(filename) || !reader.readAll(content)) {
+            state->complete(std::nullopt, "Could not read file " + filename);
+            return;
+        }
+        state->complete(std::move(content), "");
+    });
+    return IoOperation<std::string>(state);
+}
+
+// Write a whole file through FileWriter
+IoOperation<size_t> IoService::writeFile(const std::string& filename, std::string content) {
+    auto state = std::make_shared<IoOperation<size_t>::State>();
+    state->resumeOn = &computePool;
+    post([state, filename, content = std::move(content)]() {
+        FileWriter writer;
+        if (!writer.open(filename) || !writer.write(content) || !writer.close()) {
+            state->complete(std::nullopt, "Could not write file " + filename);
+            return;
+        }
+        state->complete(content.size(), "");
+    });
+    return IoOperation<size_t>(state);
+}
+
+// ============================================================================
+// Workflow coroutines
+// ============================================================================
+
+struct AsyncWorkflow::Runtime {
+    ThreadPool pool;
+    IoService io;
+
+    Runtime(unsigned computeThreads, unsigned ioThreads)
+        : pool(computeThreads), io(pool, ioThreads) {}
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Fit through the normal equations (silent, unlike LinearRegression::train)
+bool fitRows(const Dataset& data, LinearRegression& model) {
+    NormalEquations equations(6);
+    for (size_t i = 0; i < data.size(); ++i) {
+        std::vector<double> features = data[i].getFeatureVector();
+        equations.addRow(features.data(), data[i].getTarget());
+    }
+    return model.trainFromNormalEquations(equations);
+}
+
+// Coefficients followed by one CSV line per row
+std::string renderPredictions(const LinearRegression& model, const Dataset& data) {
+    std::string report = "# coefficients";
+    char line[256];
+    for (double c : model.getCoefficients()) {
+        std::snprintf(line, sizeof(line), " %.6f", c);
+        report += line;
+    }
+    report += "\nvendor,model,actual,predicted\n";
+    for (size_t i = 0; i < data.size(); ++i) {
+        // Names are appended directly; only the numbers go through the buffer
+        std::snprintf(line, sizeof(line), ",%.0f,%.4f\n", data[i].getTarget(), model.predict(data[i]));
+        report += data[i].getVendor();
+        report += ',';
+        report += data[i].getModel();
+        report += line;
+    }
+    return report;
+}
+
+// One cross-validation fold, partitioned like LinearRegression::crossValidate
+Task<double> foldRMSE(ThreadPool& pool, const Dataset& data, int fold, int folds) {
+    co_await pool.schedule();
+
+    size_t foldSize = data.size() / folds;
+    size_t begin = fold * foldSize;
+    size_t end = (fold == folds - 1) ? data.size() : begin + foldSize;
+
+    Dataset trainSet, validSet;
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (i >= begin && i < end) {
+            validSet.addDataPoint(data[i]);
+        } else {
+            trainSet.addDataPoint(data[i]);
+        }
+    }
+
+    LinearRegression model;
+    if (!fitRows(trainSet, model)) {
+        throw std::runtime_error("Training failed in fold " + std::to_string(fold + 1));
+    }
+    co_return model.calculateRMSE(validSet);
+}
+
+Task<AsyncWorkflow::Result> trainEvaluateReport(ThreadPool& pool, IoService& io,
+                                                std::string dataPath, std::string reportPath,
+                                                int folds) {
+    AsyncWorkflow::Result result;
+
+    // Resumes on the compute pool once the I/O thread has the bytes
+    std::string text = co_await io.readFile(dataPath);
+
+    Dataset full, trainSet, testSet;
+    if (!full.loadFromBuffer(text)) {
+        throw std::runtime_error("No data points in " + dataPath);
+    }
+    result.rows = full.size();
+    full.split(0.8, trainSet, testSet);
+
+    LinearRegression model;
+    if (!fitRows(trainSet, model)) {
+        throw std::runtime_error("Training failed");
+    }
+    result.coefficients = model.getCoefficients();
+    result.testRMSE = model.calculateRMSE(testSet);
+
+    // The report write starts now and overlaps the cross-validation folds
+    IoOperation<size_t> reportWrite = io.writeFile(reportPath, renderPredictions(model, testSet));
+
+    std::vector<Task<double>> foldTasks;
+    for (int fold = 0; fold < folds; ++fold) {
+        foldTasks.push_back(foldRMSE(pool, full, fold, folds));
+    }
+    result.foldRMSEs = co_await whenAll(std::move(foldTasks));
+    result.reportBytes = co_await reportWrite;
+
+    result.success = true;
+    co_return result;
+}
+
+Task<bool> processFile(IoService& io, std::string input, std::string output) {
+    try {
+        std::string text = co_await io.readFile(input);
+        std::string report;
+        if (!AsyncWorkflow::trainAndScore(text, report)) {
+            co_return false;
+        }
+        co_await io.writeFile(output, std::move(report));
+        co_return true;
+    } catch (const std::exception&) {
+        co_return false;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// AsyncWorkflow
+// ============================================================================
+
+// Constructor
+AsyncWorkflow::AsyncWorkflow(unsigned computeThreads, unsigned ioThreads)
+    : runtime(new Runtime(computeThreads, ioThreads)) {}
+
+// Destructor
+AsyncWorkflow::~AsyncWorkflow() = default;
+
+// Load, train, cross-validate and write the report
+AsyncWorkflow::Result AsyncWorkflow::run(const std::string& dataPath, const std::string& reportPath,
+                                         int folds) {
+    if (folds < 2) {
+        throw std::invalid_argument("Number of folds must be at least 2");
+    }
+
+    Clock::time_point start = Clock::now();
+    Result result;
+    try {
+        result = syncWait(trainEvaluateReport(runtime->pool, runtime->io, dataPath, reportPath, folds));
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error = e.what();
+    }
+    result.wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+// Run one read -> fit -> write job per input concurrently
+size_t AsyncWorkflow::processFiles(const std::vector<std::string>& inputs,
+                                   const std::vector<std::string>& outputs) {
+    if (inputs.size() != outputs.size()) {
+        throw std::invalid_argument("Each input needs exactly one output path");
+    }
+
+    std::vector<Task<bool>> jobs;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        jobs.push_back(processFile(runtime->io, inputs[i], outputs[i]));
+    }
+    std::vector<bool> outcomes = syncWait(whenAll(std::move(jobs)));
+
+    size_t succeeded = 0;
+    for (bool ok : outcomes) {
+        succeeded += ok ? 1 : 0;
+    }
+    return succeeded;
+}
+
+// Fit on CSV text and render the prediction report
+bool AsyncWorkflow::trainAndScore(const std::string& csvText, std::string& report) {
+    Dataset data;
+    if (!data.loadFromBuffer(csvText)) {
+        return false;
+    }
+    LinearRegression model;
+    if (!fitRows(data, model)) {
+        return false;
+    }
+    report = renderPredictions(model, data);
+    return true;
+}
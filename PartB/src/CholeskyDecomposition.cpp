@@ -0,0 +1,104 @@
+#include "../include/CholeskyDecomposition.h"
+#include <cmath>
+#include <stdexcept>
+
+// Default constructor
+CholeskyDecomposition::CholeskyDecomposition() : n(0) {}
+
+// Factor a symmetric positive definite matrix (only the lower triangle is read)
+CholeskyDecomposition::CholeskyDecomposition(const Matrix& matrix)
+    : n(matrix.getRows()), lower(matrix.getRows() * matrix.getRows(), 0.0) {
+    if (matrix.getRows() != matrix.getCols()) {
+        throw std::invalid_argument("Cholesky factorization requires a square matrix");
+    }
+
+    for (size_t j = 0; j < n; ++j) {
+        double* rowJ = lower.data() + j * n;
+        double diagonal = matrix(j, j);
+        for (size_t k = 0; k < j; ++k) {
+            diagonal -= rowJ[k] * rowJ[k];
+        }
+        if (diagonal <= 0.0 || !std::isfinite(diagonal)) {
+            throw std::runtime_error("Matrix is not positive definite");
+        }
+        rowJ[j] = std::sqrt(diagonal);
+
+        for (size_t i = j + 1; i < n; ++i) {
+            double* rowI = lower.data() + i * n;
+            double sum = matrix(i, j);
+            for (size_t k = 0; k < j; ++k) {
+                sum -= rowI[k] * rowJ[k];
+            }
+            rowI[j] = sum / rowJ[j];
+        }
+    }
+}
+
+// Forward substitution for a whole batch: each step is an axpy over the batch
+void CholeskyDecomposition::solveLowerColumns(double* columns, size_t rows) const {
+    for (size_t j = 0; j < n; ++j) {
+        double* target = columns + j * rows;
+        const double* rowJ = lower.data() + j * n;
+        for (size_t k = 0; k < j; ++k) {
+            const double* solved = columns + k * rows;
+            double factor = rowJ[k];
+            for (size_t i = 0; i < rows; ++i) {
+                target[i] -= factor * solved[i];
+            }
+        }
+        double inverse = 1.0 / rowJ[j];
+        for (size_t i = 0; i < rows; ++i) {
+            target[i] *= inverse;
+        }
+    }
+}
+
+// ||L^(-1) x||^2 for every row of the batch
+void CholeskyDecomposition::quadraticForms(const double* batch, size_t rows, double* out) const {
+    std::vector<double> columns(n * rows);
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            columns[j * rows + i] = batch[i * n + j];
+        }
+    }
+
+    solveLowerColumns(columns.data(), rows);
+
+    for (size_t i = 0; i < rows; ++i) {
+        out[i] = 0.0;
+    }
+    for (size_t j = 0; j < n; ++j) {
+        const double* column = columns.data() + j * rows;
+        for (size_t i = 0; i < rows; ++i) {
+            out[i] += column[i] * column[i];
+        }
+    }
+}
+
+// Forward then backward substitution
+std::vector<double> CholeskyDecomposition::solve(const std::vector<double>& b) const {
+    if (b.size() != n) {
+        throw std::invalid_argument("Right-hand side size does not match matrix dimensions");
+    }
+
+    std::vector<double> x = b;
+    solveLowerColumns(x.data(), 1);
+    for (size_t j = n; j-- > 0;) {
+        for (size_t i = j + 1; i < n; ++i) {
+            x[j] -= lower[i * n + j] * x[i];
+        }
+        x[j] /= lower[j * n + j];
+    }
+    return x;
+}
+
+// (A^(-1))_jj = e_j^T A^(-1) e_j, so the identity is one batch of quadratic forms
+std::vector<double> CholeskyDecomposition::inverseDiagonal() const {
+    std::vector<double> identity(n * n, 0.0);
+    for (size_t j = 0; j < n; ++j) {
+        identity[j * n + j] = 1.0;
+    }
+    std::vector<double> result(n);
+    quadraticForms(identity.data(), n, result.data());
+    return result;
+}
@@ -0,0 +1,171 @@
+#include "../include/CpuDispatch.h"
+#include "../include/SimdKernels.h"
+#include <atomic>
+#include <cstdlib>
+#include <sstream>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CPUPERF_HAVE_CPUID 1
+#endif
+
+namespace {
+
+const char* const LEVEL_NAMES[CpuDispatch::LEVEL_COUNT] = {"baseline", "sse4.2", "avx2", "avx512"};
+
+// Whether the CPU (and OS, for the AVX register state) supports a level
+bool cpuSupports(CpuDispatch::Level level) {
+#if defined(CPUPERF_HAVE_CPUID)
+    __builtin_cpu_init();
+    switch (level) {
+        case CpuDispatch::BASELINE:
+            return true;
+        case CpuDispatch::SSE42:
+            return __builtin_cpu_supports("sse4.2");
+        case CpuDispatch::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case CpuDispatch::AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                   __builtin_cpu_supports("avx512dq");
+        default:
+            return false;
+    }
+#else
+    return level == CpuDispatch::BASELINE;
+#endif
+}
+
+// Tables for every level both the CPU and the build support, filled once
+struct Registry {
+    const CpuDispatch::Kernels* tables[CpuDispatch::LEVEL_COUNT];
+    CpuDispatch::Level detected;
+    CpuDispatch::Level requested;   // CPUPERF_SIMD, or LEVEL_COUNT when unset
+
+    Registry() : tables(), detected(CpuDispatch::BASELINE), requested(CpuDispatch::LEVEL_COUNT) {
+        const CpuDispatch::Kernels* (*const builders[CpuDispatch::LEVEL_COUNT])() = {
+            &SimdKernels::baseline, &SimdKernels::sse42, &SimdKernels::avx2, &SimdKernels::avx512};
+        for (int l = 0; l < CpuDispatch::LEVEL_COUNT; ++l) {
+            CpuDispatch::Level level = static_cast<CpuDispatch::Level>(l);
+            tables[l] = cpuSupports(level) ? builders[l]() : nullptr;
+            if (tables[l] != nullptr) {
+                detected = level;
+            }
+        }
+
+        const char* setting = std::getenv("CPUPERF_SIMD");
+        if (setting != nullptr) {
+            for (int l = 0; l < CpuDispatch::LEVEL_COUNT; ++l) {
+                if (std::string(setting) == LEVEL_NAMES[l]) {
+                    requested = static_cast<CpuDispatch::Level>(l);
+                }
+            }
+        }
+    }
+
+    // Highest supported level not above the cap
+    const CpuDispatch::Kernels* best(CpuDispatch::Level cap) const {
+        for (int l = cap; l > CpuDispatch::BASELINE; --l) {
+            if (tables[l] != nullptr) {
+                return tables[l];
+            }
+        }
+        return tables[CpuDispatch::BASELINE];
+    }
+};
+
+const Registry& registry() {
+    static const Registry instance;
+    return instance;
+}
+
+std::atomic<const CpuDispatch::Kernels*>& active() {
+    static std::atomic<const CpuDispatch::Kernels*> table(
+        registry().best(registry().requested == CpuDispatch::LEVEL_COUNT ? registry().detected
+                                                                         : registry().requested));
+    return table;
+}
+
+} // namespace
+
+namespace CpuDispatch {
+
+Level detected() {
+    return registry().detected;
+}
+
+Level level() {
+    return kernels().level;
+}
+
+bool setLevel(Level level) {
+    const Kernels* table = kernelsFor(level);
+    if (table == nullptr) {
+        return false;
+    }
+    active().store(table, std::memory_order_release);
+    return true;
+}
+
+const Kernels& kernels() {
+    return *active().load(std::memory_order_acquire);
+}
+
+const Kernels* kernelsFor(Level level) {
+    return level >= BASELINE && level < LEVEL_COUNT ? registry().tables[level] : nullptr;
+}
+
+const char* levelName(Level level) {
+    return level >= BASELINE && level < LEVEL_COUNT ? LEVEL_NAMES[level] : "unknown";
+}
+
+std::string describe() {
+    std::ostringstream out;
+    out << "CPU features:";
+#if defined(CPUPERF_HAVE_CPUID)
+    __builtin_cpu_init();
+    const struct {
+        const char* name;
+        bool present;
+    } FEATURES[] = {
+        {"sse4.2", __builtin_cpu_supports("sse4.2") != 0},
+        {"avx2", __builtin_cpu_supports("avx2") != 0},
+        {"fma", __builtin_cpu_supports("fma") != 0},
+        {"avx512f", __builtin_cpu_supports("avx512f") != 0},
+        {"avx512bw", __builtin_cpu_supports("avx512bw") != 0},
+        {"avx512dq", __builtin_cpu_supports("avx512dq") != 0},
+    };
+    for (const auto& feature : FEATURES) {
+        if (feature.present) {
+            out << " " << feature.name;
+        }
+    }
+#else
+    out << " (no cpuid on this target)";
+#endif
+    out << "\n";
+
+    out << "Kernel levels:";
+    for (int l = 0; l < LEVEL_COUNT; ++l) {
+        Level candidate = static_cast<Level>(l);
+        out << " " << LEVEL_NAMES[l]
+            << (registry().tables[l] != nullptr ? "" : cpuSupports(candidate) ? " (not built)" : " (no CPU support)");
+    }
+    out << "\n";
+
+    const char* setting = std::getenv("CPUPERF_SIMD");
+    const Kernels& table = kernels();
+    out << "Selected: " << levelName(table.level) << " (detected " << levelName(detected())
+        << ", CPUPERF_SIMD=" << (setting != nullptr ? setting : "unset") << ")\n";
+    out << "  compensated sums  " << REDUCE_LANES << " lanes in " << REDUCE_LANES / table.width
+        << " x " << table.width << "-double registers\n";
+    out << "  sin/cos           " << table.width << " angles per step\n";
+    out << "  column scoring    " << table.width << " rows per register, 4 registers per step\n";
+    out << "  CSV structurals   ";
+    if (table.width == 1) {
+        out << "bytewise compares";
+    } else {
+        out << 64 / (8 * table.width) << " compare(s) per 64-byte block and character class";
+    }
+    return out.str();
+}
+
+} // namespace CpuDispatch
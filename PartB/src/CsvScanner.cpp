@@ -0,0 +1,121 @@
+#include "../include/CsvScanner.h"
+#include "../include/CpuDispatch.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+// Blocks classified per dispatched kernel call (4 KB of input)
+const size_t CLASSIFY_BLOCKS = 64;
+
+// Index of the lowest set bit (tzcnt)
+inline unsigned trailingZeros(uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+}
+
+// Append base + position of every set bit
+inline void flattenBits(std::vector<uint32_t>& offsets, uint32_t base, uint64_t bits) {
+    while (bits != 0) {
+        offsets.push_back(base + trailingZeros(bits));
+        bits &= bits - 1;
+    }
+}
+
+} // namespace
+
+// Classify 64 bytes into delimiter and newline bitmaps
+CsvScanner::Block CsvScanner::classifyBlock(const char* ptr, char delimiter) {
+    Block block;
+    CpuDispatch::kernels().classify(ptr, 1, delimiter, &block.delimiters, &block.newlines);
+    return block;
+}
+
+// Stage 1: structural character offsets
+void CsvScanner::findStructurals(const char* data, size_t length,
+                                 std::vector<uint32_t>& offsets, char delimiter) {
+    if (length > UINT32_MAX) {
+        throw std::invalid_argument("CsvScanner buffer exceeds 32-bit offsets");
+    }
+
+    // Roughly one structural per 4 bytes for numeric CSV
+    offsets.reserve(offsets.size() + length / 4 + 1);
+
+    // Whole blocks, classified a batch at a time
+    const CpuDispatch::Kernels& kernels = CpuDispatch::kernels();
+    uint64_t delimiters[CLASSIFY_BLOCKS], newlines[CLASSIFY_BLOCKS];
+    size_t blocks = length / BLOCK_SIZE;
+    for (size_t first = 0; first < blocks; first += CLASSIFY_BLOCKS) {
+        size_t count = std::min(CLASSIFY_BLOCKS, blocks - first);
+        kernels.classify(data + first * BLOCK_SIZE, count, delimiter, delimiters, newlines);
+        for (size_t b = 0; b < count; ++b) {
+            flattenBits(offsets, static_cast<uint32_t>((first + b) * BLOCK_SIZE), delimiters[b] | newlines[b]);
+        }
+    }
+
+    size_t pos = blocks * BLOCK_SIZE;
+    if (pos < length) {
+        // Pad the tail with a byte that is neither a delimiter nor a newline
+        char tail[BLOCK_SIZE];
+        std::memset(tail, delimiter == ' ' ? '\t' : ' ', BLOCK_SIZE);
+        std::memcpy(tail, data + pos, length - pos);
+        Block block = classifyBlock(tail, delimiter);
+        flattenBits(offsets, static_cast<uint32_t>(pos), block.delimiters | block.newlines);
+    }
+}
+
+// SWAR conversion of up to eight ASCII digits (eight digits per 64-bit word)
+bool CsvScanner::parseInt(const char* str, size_t length, int& value) {
+    bool negative = false;
+    if (length > 0 && str[0] == '-') {
+        negative = true;
+        ++str;
+        --length;
+    }
+    if (length == 0 || length > 8) {
+        return false;
+    }
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // Right-align the digits in a word of '0's so the leading bytes add nothing
+    char buffer[8];
+    std::memset(buffer, '0', sizeof(buffer));
+    std::memcpy(buffer + (8 - length), str, length);
+    uint64_t word;
+    std::memcpy(&word, buffer, sizeof(word));
+
+    // Every byte must be in '0'..'9'
+    if ((((word + 0x4646464646464646ULL) | (word - 0x3030303030303030ULL)) &
+         0x8080808080808080ULL) != 0) {
+        return false;
+    }
+
+    word -= 0x3030303030303030ULL;
+    word = (word * 10) + (word >> 8);
+    word = (((word & 0x000000FF000000FFULL) * 0x000F424000000064ULL) +
+            (((word >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >> 32;
+    int result = static_cast<int>(static_cast<uint32_t>(word));
+#else
+    int result = 0;
+    for (size_t i = 0; i < length; ++i) {
+        unsigned digit = static_cast<unsigned char>(str[i]) - '0';
+        if (digit > 9) {
+            return false;
+        }
+        result = result * 10 + static_cast<int>(digit);
+    }
+#endif
+
+    value = negative ? -result : result;
+    return true;
+}
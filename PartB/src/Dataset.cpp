@@ -1,72 +1,150 @@
 #include "../include/Dataset.h"
-#include <fstream>
-#include <sstream>
+#include "../include/FileIO.h"
+#include <cstring>
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
 #include <random>
 #include <chrono>
+#include <stdexcept>
 
 // Constructor
-Dataset::Dataset() : rng(std::chrono::steady_clock::now().time_since_epoch().count()) {}
+Dataset::Dataset() : rng(std::chrono::steady_clock::now().time_since_epoch().count()), quiet(false) {}
+
+// Record an error for getLastError() and print it unless quiet
+bool Dataset::fail(const std::string& message) {
+    lastError = message;
+    if (!quiet) {
+        std::cerr << "Error: " << message << std::endl;
+    }
+    return false;
+}
 
 // Load data from CSV file
 bool Dataset::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << filename << std::endl;
-        return false;
+    FileReader reader;
+    lastError.clear();
+    if (!reader.open(filename)) {
+        return fail("Could not open file " + filename);
     }
     
     data.clear();
-    std::string line;
-    int lineNumber = 0;
+    auto addRecord = [this](const CsvScanner::Field* fields, size_t count, size_t lineNumber) {
+        DataPoint point;
+        if (parseRecord(fields, count, lineNumber, point, quiet ? &lastError : nullptr)) {
+            data.push_back(point);
+        }
+    };
     
-    while (std::getline(file, line)) {
-        lineNumber++;
-        line = trim(line);
-        
-        // Skip empty lines
-        if (line.empty()) {
-            continue;
+    // Blocks arrive while the following reads are still in flight. Complete
+    // lines are scanned in place; a line cut by the block boundary is carried
+    // over and finished with the head of the next block.
+    std::string carry;
+    size_t lineNumber = 1;
+    bool readOk = reader.readBlocks([&](const char* block, size_t length) {
+        size_t pos = 0;
+        if (!carry.empty()) {
+            const char* newline = static_cast<const char*>(std::memchr(block, '\n', length));
+            if (newline == nullptr) {
+                carry.append(block, length);
+                return true;
+            }
+            pos = static_cast<size_t>(newline - block) + 1;
+            carry.append(block, pos);
+            lineNumber += CsvScanner::forEachRecord(carry.data(), carry.size(), addRecord, lineNumber);
+            carry.clear();
         }
         
-        // Parse CSV line
-        std::vector<std::string> tokens = parseLine(line);
-        
-        // Validate number of columns
-        if (tokens.size() != 10) {
-            std::cerr << "Warning: Line " << lineNumber << " has " << tokens.size() 
-                      << " columns instead of 10. Skipping." << std::endl;
-            continue;
+        size_t end = length;
+        while (end > pos && block[end - 1] != '\n') {
+            --end;
         }
-        
-        try {
-            // Create DataPoint from parsed tokens
+        lineNumber += CsvScanner::forEachRecord(block + pos, end - pos, addRecord, lineNumber);
+        carry.assign(block + end, length - end);
+        return true;
+    });
+    CsvScanner::forEachRecord(carry.data(), carry.size(), addRecord, lineNumber);
+    reader.close();
+    
+    if (!readOk) {
+        data.clear();
+        return fail("Failed while reading " + filename);
+    }
+    
+    if (!quiet) {
+        std::cout << "Successfully loaded " << data.size() << " data points from " << filename << std::endl;
+    } else if (data.empty() && lastError.empty()) {
+        lastError = "No data points in " + filename;
+    }
+    return !data.empty();
+}
+
+// Parse CSV text already in memory
+bool Dataset::loadFromBuffer(const std::string& buffer) {
+    data.clear();
+    lastError.clear();
+    CsvScanner::forEachRecord(buffer.data(), buffer.size(),
+        [this](const CsvScanner::Field* fields, size_t count, size_t lineNumber) {
             DataPoint point;
-            point.setVendor(trim(tokens[0]));
-            point.setModel(trim(tokens[1]));
-            point.setMYCT(std::stoi(tokens[2]));
-            point.setMMIN(std::stoi(tokens[3]));
-            point.setMMAX(std::stoi(tokens[4]));
-            point.setCACH(std::stoi(tokens[5]));
-            point.setCHMIN(std::stoi(tokens[6]));
-            point.setCHMAX(std::stoi(tokens[7]));
-            point.setPRP(std::stoi(tokens[8]));
-            point.setERP(std::stoi(tokens[9]));
-            
-            data.push_back(point);
-        }
-        catch (const std::exception& e) {
-            std::cerr << "Warning: Error parsing line " << lineNumber 
-                      << ": " << e.what() << ". Skipping." << std::endl;
-            continue;
+            if (parseRecord(fields, count, lineNumber, point, quiet ? &lastError : nullptr)) {
+                data.push_back(point);
+            }
+        });
+    return !data.empty();
+}
+
+// Parse one scanned record into a DataPoint
+bool Dataset::parseRecord(const CsvScanner::Field* fields, size_t count,
+                          size_t lineNumber, DataPoint& point, std::string* problem) {
+    // Validate number of columns
+    if (count != 10) {
+        std::string warning = "Line " + std::to_string(lineNumber) + " has " + std::to_string(count) +
+                              " columns instead of 10";
+        if (problem != nullptr) {
+            *problem = warning;
+        } else {
+            std::cerr << "Warning: " << warning << ". Skipping." << std::endl;
         }
+        return false;
     }
     
-    file.close();
-    std::cout << "Successfully loaded " << data.size() << " data points from " << filename << std::endl;
-    return !data.empty();
+    try {
+        int values[8];
+        for (size_t i = 0; i < 8; ++i) {
+            const CsvScanner::Field& field = fields[i + 2];
+            // Plain digits take the SWAR path, anything else goes through std::stoi,
+            // which must consume the whole field but surrounding blanks
+            if (!CsvScanner::parseInt(field.begin, field.length, values[i])) {
+                std::string text(field.begin, field.length);
+                size_t used = 0;
+                values[i] = std::stoi(text, &used);
+                if (text.find_first_not_of(" \t", used) != std::string::npos) {
+                    throw std::invalid_argument("malformed integer '" + text + "'");
+                }
+            }
+        }
+        
+        point.setVendor(trim(std::string(fields[0].begin, fields[0].length)));
+        point.setModel(trim(std::string(fields[1].begin, fields[1].length)));
+        point.setMYCT(values[0]);
+        point.setMMIN(values[1]);
+        point.setMMAX(values[2]);
+        point.setCACH(values[3]);
+        point.setCHMIN(values[4]);
+        point.setCHMAX(values[5]);
+        point.setPRP(values[6]);
+        point.setERP(values[7]);
+        return true;
+    }
+    catch (const std::exception& e) {
+        std::string warning = "Error parsing line " + std::to_string(lineNumber) + ": " + e.what();
+        if (problem != nullptr) {
+            *problem = warning;
+        } else {
+            std::cerr << "Warning: " << warning << ". Skipping." << std::endl;
+        }
+        return false;
+    }
 }
 
 // Access operators
@@ -141,6 +219,36 @@ void Dataset::getMatrices(std::vector<std::vector<double>>& X, std::vector<doubl
     }
 }
 
+// Sparse design matrix with optional one-hot vendor indicators
+SparseMatrix Dataset::getSparseDesign(bool oneHotVendors, std::vector<std::string>* vendorNames) const {
+    std::vector<std::string> vendors;
+    if (oneHotVendors) {
+        for (const auto& point : data) {
+            vendors.push_back(point.getVendor());
+        }
+        std::sort(vendors.begin(), vendors.end());
+        vendors.erase(std::unique(vendors.begin(), vendors.end()), vendors.end());
+    }
+    
+    std::vector<SparseMatrix::Triplet> triplets;
+    triplets.reserve(data.size() * (oneHotVendors ? 7 : 6));
+    for (size_t i = 0; i < data.size(); ++i) {
+        std::vector<double> features = data[i].getFeatureVector();
+        for (size_t j = 0; j < features.size(); ++j) {
+            triplets.push_back({i, j, features[j]});
+        }
+        if (oneHotVendors) {
+            size_t column = std::lower_bound(vendors.begin(), vendors.end(), data[i].getVendor()) - vendors.begin();
+            triplets.push_back({i, 6 + column, 1.0});
+        }
+    }
+    
+    if (vendorNames) {
+        *vendorNames = vendors;
+    }
+    return SparseMatrix::fromTriplets(data.size(), 6 + vendors.size(), std::move(triplets));
+}
+
 // Display statistics
 void Dataset::displayStatistics() const {
     if (data.empty()) {
@@ -214,21 +322,8 @@ void Dataset::displaySample(size_t n) const {
     }
 }
 
-// Helper function to parse CSV line
-std::vector<std::string> Dataset::parseLine(const std::string& line) const {
-    std::vector<std::string> tokens;
-    std::stringstream ss(line);
-    std::string token;
-    
-    while (std::getline(ss, token, ',')) {
-        tokens.push_back(token);
-    }
-    
-    return tokens;
-}
-
 // Helper function to trim whitespace
-std::string Dataset::trim(const std::string& str) const {
+std::string Dataset::trim(const std::string& str) {
     size_t start = str.find_first_not_of(" \t\r\n");
     if (start == std::string::npos) {
         return "";
@@ -0,0 +1,506 @@
+#include "../include/DistributedTrainer.h"
+#include "../include/CsvScanner.h"
+#include "../include/Dataset.h"
+#include "../include/ScoringKernel.h"
+#include "../include/SplitMix64.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CPUPERF_HAVE_FORK 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+enum MessageType : uint32_t {
+    TRAIN_STATISTICS = 1,   // worker -> coordinator: NormalEquations::serialize()
+    TEST_STATISTICS = 2,
+    SHARD_SUMMARY = 3,      // worker -> coordinator: bytes, seconds
+    SCORE = 4,              // coordinator -> worker: coefficients
+    METRICS = 5,            // worker -> coordinator: MetricAccumulator::serialize()
+    FAILED = 6              // worker -> coordinator: no payload
+};
+
+struct MessageHeader {
+    uint32_t type;
+    uint32_t worker;
+    uint64_t count;         // doubles in the payload
+};
+
+// Largest payload accepted, in doubles; guards against a corrupt header
+const uint64_t MAX_PAYLOAD = uint64_t(1) << 24;
+// Bytes read at a time while looking for a shard's first and last line break
+const size_t SCAN_BLOCK = 64 * 1024;
+
+// Byte-offset hash of a row, uniform in [0, 1)
+double rowHash(uint64_t seed, uint64_t offset) {
+    SplitMix64 generator(seed ^ SplitMix64(offset).next());
+    return static_cast<double>(generator.next() >> 11) * 0x1.0p-53;
+}
+
+#ifdef CPUPERF_HAVE_FORK
+
+bool sendAll(int fd, const void* data, size_t length) {
+    const char* next = static_cast<const char*>(data);
+    while (length > 0) {
+        ssize_t sent = ::send(fd, next, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        next += sent;
+        length -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool receiveAll(int fd, void* data, size_t length) {
+    char* next = static_cast<char*>(data);
+    while (length > 0) {
+        ssize_t received = ::recv(fd, next, length, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;  // error, or the peer closed the socket
+        }
+        next += received;
+        length -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+bool sendMessage(int fd, uint32_t type, uint32_t worker, const std::vector<double>& payload) {
+    MessageHeader header = {type, worker, payload.size()};
+    return sendAll(fd, &header, sizeof(header)) &&
+           sendAll(fd, payload.data(), payload.size() * sizeof(double));
+}
+
+bool receiveMessage(int fd, MessageHeader& header, std::vector<double>& payload) {
+    if (!receiveAll(fd, &header, sizeof(header)) || header.count > MAX_PAYLOAD) {
+        return false;
+    }
+    payload.resize(header.count);
+    return receiveAll(fd, payload.data(), payload.size() * sizeof(double));
+}
+
+// Receive one message of the expected type from a worker
+bool expectMessage(int fd, uint32_t type, size_t worker, std::vector<double>& payload) {
+    MessageHeader header;
+    if (!receiveMessage(fd, header, payload)) {
+        std::cerr << "Error: Lost connection to worker " << worker << std::endl;
+        return false;
+    }
+    if (header.type != type) {
+        std::cerr << "Error: Worker " << worker
+                  << (header.type == FAILED ? " failed" : " sent an unexpected message") << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool readRange(int fd, uint64_t offset, size_t length, std::string& out) {
+    size_t begin = out.size();
+    out.resize(begin + length);
+    size_t done = 0;
+    while (done < length) {
+        ssize_t got = ::pread(fd, &out[begin + done], length - done, static_cast<off_t>(offset + done));
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            out.resize(begin + done);
+            return got == 0;  // end of file
+        }
+        done += static_cast<size_t>(got);
+    }
+    return true;
+}
+
+// Lines that start in [size * index / count, size * (index + 1) / count).
+// Sets `first` to the file offset of text[0].
+bool readShard(const std::string& filename, size_t index, size_t count, std::string& text, uint64_t& first) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    uint64_t size = static_cast<uint64_t>(info.st_size);
+    uint64_t begin = size * index / count;
+    uint64_t end = size * (index + 1) / count;
+
+    // A line that started in the previous shard belongs to that shard
+    bool ok = true;
+    std::string scan;
+    if (begin > 0) {
+        ok = readRange(fd, begin - 1, 1, scan);
+        bool midLine = ok && !scan.empty() && scan[0] != '\n';
+        while (ok && midLine && begin < end) {
+            scan.clear();
+            ok = readRange(fd, begin, static_cast<size_t>(std::min<uint64_t>(SCAN_BLOCK, end - begin)), scan);
+            const void* newline = std::memchr(scan.data(), '\n', scan.size());
+            if (newline) {
+                begin += static_cast<uint64_t>(static_cast<const char*>(newline) - scan.data()) + 1;
+                break;
+            }
+            begin += scan.size();
+            midLine = !scan.empty();
+        }
+    }
+
+    // Whole lines from begin, finishing the line that crosses end
+    text.clear();
+    first = begin;
+    if (ok && begin < end) {
+        ok = readRange(fd, begin, static_cast<size_t>(end - begin), text);
+        uint64_t next = end;
+        while (ok && !text.empty() && text.back() != '\n' && next < size) {
+            scan.clear();
+            ok = readRange(fd, next, SCAN_BLOCK, scan);
+            const void* newline = std::memchr(scan.data(), '\n', scan.size());
+            size_t take = newline ? static_cast<const char*>(newline) - scan.data() + 1 : scan.size();
+            text.append(scan, 0, take);
+            next += scan.size();
+            if (newline || scan.empty()) {
+                break;
+            }
+        }
+    }
+    ::close(fd);
+    return ok;
+}
+
+// Worker process: accumulate the shard, then score held-out rows on request
+// until the coordinator closes the socket
+int runWorker(int fd, const std::string& filename, size_t index, const DistributedConfig& config) {
+    Clock::time_point start = Clock::now();
+    std::string text;
+    uint64_t first = 0;
+    if (!readShard(filename, index, config.workers, text, first)) {
+        sendMessage(fd, FAILED, static_cast<uint32_t>(index), {});
+        return 1;
+    }
+
+    NormalEquations trainStats(6), testStats(6);
+    std::array<std::vector<double>, 6> columns;
+    std::vector<double> target, trainWeight, testWeight;
+    std::vector<double> heldOutRows, heldOutTargets;
+    auto flush = [&]() {
+        const double* pointers[6];
+        for (size_t j = 0; j < 6; ++j) {
+            pointers[j] = columns[j].data();
+        }
+        trainStats.addColumns(pointers, target.data(), target.size(), trainWeight.data());
+        testStats.addColumns(pointers, target.data(), target.size(), testWeight.data());
+        for (std::vector<double>& column : columns) {
+            column.clear();
+        }
+        target.clear();
+        trainWeight.clear();
+        testWeight.clear();
+    };
+
+    CsvScanner::forEachRecord(text.data(), text.size(),
+        [&](const CsvScanner::Field* fields, size_t count, size_t line) {
+            DataPoint point;
+            if (!Dataset::parseRecord(fields, count, line, point)) {
+                return;
+            }
+            std::vector<double> features = point.getFeatureVector();
+            uint64_t offset = first + static_cast<uint64_t>(fields[0].begin - text.data());
+            bool train = rowHash(config.seed, offset) < config.trainRatio;
+            for (size_t j = 0; j < 6; ++j) {
+                columns[j].push_back(features[j]);
+            }
+            target.push_back(point.getTarget());
+            trainWeight.push_back(train ? 1.0 : 0.0);
+            testWeight.push_back(train ? 0.0 : 1.0);
+            if (!train) {
+                heldOutRows.insert(heldOutRows.end(), features.begin(), features.end());
+                heldOutTargets.push_back(point.getTarget());
+            }
+            if (target.size() == config.batchRows) {
+                flush();
+            }
+        });
+    flush();
+
+    uint32_t worker = static_cast<uint32_t>(index);
+    if (!sendMessage(fd, TRAIN_STATISTICS, worker, trainStats.serialize()) ||
+        !sendMessage(fd, TEST_STATISTICS, worker, testStats.serialize()) ||
+        !sendMessage(fd, SHARD_SUMMARY, worker, {static_cast<double>(text.size()), secondsSince(start)})) {
+        return 1;
+    }
+
+    MessageHeader header;
+    std::vector<double> payload;
+    std::vector<double> predictions(heldOutTargets.size());
+    while (receiveMessage(fd, header, payload)) {
+        if (header.type != SCORE || payload.size() != 6) {
+            sendMessage(fd, FAILED, worker, {});
+            return 1;
+        }
+        ScoringKernel(payload).score(heldOutRows.data(), heldOutTargets.size(), predictions.data());
+        MetricAccumulator metrics;
+        metrics.addBatch(heldOutTargets.data(), predictions.data(), heldOutTargets.size());
+        if (!sendMessage(fd, METRICS, worker, metrics.serialize())) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#endif // CPUPERF_HAVE_FORK
+
+} // namespace
+
+// Constructors
+DistributedTrainer::DistributedTrainer() : DistributedTrainer(DistributedConfig()) {}
+
+DistributedTrainer::DistributedTrainer(const DistributedConfig& config)
+    : config(config), trainStats(6), testStats(6) {
+    if (config.workers == 0) {
+        throw std::invalid_argument("Worker count must be positive");
+    }
+    if (config.trainRatio < 0.0 || config.trainRatio > 1.0) {
+        throw std::invalid_argument("Train ratio must be between 0 and 1");
+    }
+    if (config.batchRows == 0) {
+        throw std::invalid_argument("Batch size must be positive");
+    }
+}
+
+DistributedTrainer::~DistributedTrainer() {
+    stop();
+}
+
+// Fork the workers, then merge their statistics in worker order
+bool DistributedTrainer::start(const std::string& filename) {
+#ifdef CPUPERF_HAVE_FORK
+    stop();
+    trainStats.clear();
+    testStats.clear();
+    result = Result();
+    result.workers.resize(config.workers);
+
+    struct stat info;
+    if (::stat(filename.c_str(), &info) != 0) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+
+    // Nothing buffered may be written twice by the children
+    std::cout.flush();
+    std::cerr.flush();
+
+    for (size_t k = 0; k < config.workers; ++k) {
+        int pair[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+            std::cerr << "Error: Could not create a socket pair: " << std::strerror(errno) << std::endl;
+            stop();
+            return false;
+        }
+        pid_t pid = ::fork();
+        if (pid < 0) {
+            std::cerr << "Error: Could not fork worker " << k << ": " << std::strerror(errno) << std::endl;
+            ::close(pair[0]);
+            ::close(pair[1]);
+            stop();
+            return false;
+        }
+        if (pid == 0) {
+            // Worker: keep only its own end of its own socket
+            for (int fd : sockets) {
+                ::close(fd);
+            }
+            ::close(pair[0]);
+            int status = runWorker(pair[1], filename, k, config);
+            ::close(pair[1]);
+            ::_exit(status);
+        }
+        ::close(pair[1]);
+        sockets.push_back(pair[0]);
+        pids.push_back(pid);
+        result.workers[k].pid = pid;
+    }
+
+    std::vector<double> payload;
+    for (size_t k = 0; k < sockets.size(); ++k) {
+        try {
+            if (!expectMessage(sockets[k], TRAIN_STATISTICS, k, payload)) {
+                stop();
+                return false;
+            }
+            NormalEquations train = NormalEquations::deserialize(payload.data(), payload.size());
+            if (!expectMessage(sockets[k], TEST_STATISTICS, k, payload)) {
+                stop();
+                return false;
+            }
+            NormalEquations test = NormalEquations::deserialize(payload.data(), payload.size());
+            if (!expectMessage(sockets[k], SHARD_SUMMARY, k, payload) || payload.size() != 2) {
+                stop();
+                return false;
+            }
+
+            trainStats.merge(train);
+            testStats.merge(test);
+            WorkerReport& report = result.workers[k];
+            report.bytes = static_cast<uint64_t>(payload[0]);
+            report.seconds = payload[1];
+            report.trainRows = train.getCount();
+            report.testRows = test.getCount();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error: Bad statistics from worker " << k << ": " << e.what() << std::endl;
+            stop();
+            return false;
+        }
+    }
+    result.trainRows = trainStats.getCount();
+    result.testRows = testStats.getCount();
+    return true;
+#else
+    (void)filename;
+    std::cerr << "Error: Distributed training needs fork() and Unix sockets" << std::endl;
+    return false;
+#endif
+}
+
+// Solve on the merged training statistics
+bool DistributedTrainer::train(LinearRegression& model) {
+    if (!model.trainFromNormalEquations(trainStats, config.lambda)) {
+        return false;
+    }
+    result.coefficients = model.getCoefficients();
+    result.trainRMSE = std::sqrt(trainStats.residualSumSquares(result.coefficients) / result.trainRows);
+    return true;
+}
+
+// One SCORE round trip per worker; replies are merged in worker order
+bool DistributedTrainer::evaluate(const std::vector<double>& coefficients, MetricAccumulator& metrics) {
+#ifdef CPUPERF_HAVE_FORK
+    if (sockets.empty()) {
+        std::cerr << "Error: No workers running" << std::endl;
+        return false;
+    }
+    if (coefficients.size() != 6) {
+        throw std::invalid_argument("Coefficient count does not match feature count");
+    }
+
+    for (size_t k = 0; k < sockets.size(); ++k) {
+        if (!sendMessage(sockets[k], SCORE, static_cast<uint32_t>(k), coefficients)) {
+            std::cerr << "Error: Lost connection to worker " << k << std::endl;
+            return false;
+        }
+    }
+    MetricAccumulator merged;
+    std::vector<double> payload;
+    for (size_t k = 0; k < sockets.size(); ++k) {
+        try {
+            if (!expectMessage(sockets[k], METRICS, k, payload)) {
+                return false;
+            }
+            merged.merge(MetricAccumulator::deserialize(payload.data(), payload.size()));
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error: Bad metrics from worker " << k << ": " << e.what() << std::endl;
+            return false;
+        }
+    }
+    metrics = merged;
+    return true;
+#else
+    (void)coefficients;
+    (void)metrics;
+    return false;
+#endif
+}
+
+// Closing its socket ends a worker's request loop
+bool DistributedTrainer::stop() {
+    bool ok = true;
+#ifdef CPUPERF_HAVE_FORK
+    for (int fd : sockets) {
+        ::close(fd);
+    }
+    for (int pid : pids) {
+        int status = 0;
+        while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+        }
+        ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+#endif
+    sockets.clear();
+    pids.clear();
+    return ok;
+}
+
+// Train on the merged statistics and evaluate on every shard's held-out rows
+bool DistributedTrainer::run(const std::string& filename, LinearRegression& model) {
+    Clock::time_point wallStart = Clock::now();
+    if (!start(filename) || !train(model)) {
+        stop();
+        return false;
+    }
+    bool evaluated = result.testRows <= 0.0 || evaluate(result.coefficients, result.test);
+    bool stopped = stop();
+    if (!stopped) {
+        std::cerr << "Error: A worker exited with an error" << std::endl;
+    }
+    result.wallSeconds = secondsSince(wallStart);
+    return evaluated && stopped;
+}
+
+// Display results and per-worker counters
+void DistributedTrainer::displayResults() const {
+    std::cout << "\n=== Distributed Training (" << result.workers.size() << " workers) ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "Training rows:   " << result.trainRows << std::endl;
+    std::cout << "Test rows:       " << result.testRows << std::endl;
+    std::cout << std::setprecision(4);
+    std::cout << "Training RMSE:   " << result.trainRMSE << std::endl;
+    std::cout << "Test RMSE:       " << result.test.getRMSE() << std::endl;
+    std::cout << "Test MAE:        " << result.test.getMAE() << std::endl;
+    std::cout << "Test R²:         " << result.test.getRSquared() << std::endl;
+    std::cout << "Test MAPE:       " << std::setprecision(2) << result.test.getMAPE() << "%" << std::endl;
+    std::cout << "Wall time:       " << result.wallSeconds * 1000.0 << " ms" << std::endl;
+
+    std::cout << "\n" << std::setw(8) << "Worker" << std::setw(10) << "PID" << std::setw(12) << "KB"
+              << std::setw(10) << "Train" << std::setw(10) << "Test" << std::setw(12) << "Shard ms" << std::endl;
+    std::cout << std::string(62, '-') << std::endl;
+    for (size_t k = 0; k < result.workers.size(); ++k) {
+        const WorkerReport& report = result.workers[k];
+        std::cout << std::setw(8) << k << std::setw(10) << report.pid
+                  << std::setw(12) << std::setprecision(1) << report.bytes / 1024.0
+                  << std::setw(10) << std::setprecision(0) << report.trainRows
+                  << std::setw(10) << report.testRows
+                  << std::setw(12) << std::setprecision(2) << report.seconds * 1000.0 << std::endl;
+    }
+}
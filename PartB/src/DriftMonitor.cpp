@@ -0,0 +1,425 @@
+#include "../include/DriftMonitor.h"
+#include "../include/FileIO.h"
+#include "../include/Summation.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// First line of a saved baseline file
+const char* BASELINE_HEADER = "cpuperf-drift 1";
+
+// Floor on bin fractions in the PSI sum, so empty bins stay finite
+const double PSI_FLOOR = 1e-4;
+
+} // namespace
+
+// Record an error for getLastError() and print it unless quiet
+bool DriftBaseline::fail(const std::string& message) const {
+    lastError = message;
+    if (!quiet) {
+        std::cerr << "Error: " << message << std::endl;
+    }
+    return false;
+}
+
+bool DriftBaseline::capture(const double* rows, size_t count, size_t featureCount) {
+    if (rows == nullptr || count == 0 || featureCount == 0) {
+        return fail("No rows to capture a drift baseline from");
+    }
+
+    std::vector<Feature> captured(featureCount);
+    std::vector<double> column(count);
+    for (size_t j = 0; j < featureCount; ++j) {
+        Feature& feature = captured[j];
+        Summation::KahanBabuska sum;
+        for (size_t i = 0; i < count; ++i) {
+            column[i] = rows[i * featureCount + j];
+            sum.add(column[i]);
+        }
+        feature.count = static_cast<double>(count);
+        feature.mean = sum.value() / feature.count;
+        Summation::KahanBabuska squares;
+        for (double value : column) {
+            squares.add((value - feature.mean) * (value - feature.mean));
+        }
+        feature.variance = count > 1 ? squares.value() / (feature.count - 1.0) : 0.0;
+
+        // Nearest-rank quantiles k / BINS as the inner edges, ties merged
+        std::sort(column.begin(), column.end());
+        for (size_t k = 1; k < BINS; ++k) {
+            double edge = column[(k * count + BINS - 1) / BINS - 1];
+            if (feature.edges.empty() || edge > feature.edges.back()) {
+                feature.edges.push_back(edge);
+            }
+        }
+        feature.fractions.assign(feature.edges.size() + 1, 0.0);
+        for (double value : column) {
+            feature.fractions[binOf(feature.edges, value)] += 1.0 / feature.count;
+        }
+    }
+
+    features = std::move(captured);
+    return true;
+}
+
+bool DriftBaseline::capture(const Dataset& data) {
+    std::vector<double> rows;
+    rows.reserve(data.size() * 6);
+    for (size_t i = 0; i < data.size(); ++i) {
+        for (double value : data[i].getFeatureVector()) {
+            rows.push_back(value);
+        }
+    }
+    return capture(rows.data(), data.size(), 6);
+}
+
+size_t DriftBaseline::binOf(const std::vector<double>& edges, double value) {
+    return static_cast<size_t>(std::lower_bound(edges.begin(), edges.end(), value) - edges.begin());
+}
+
+bool DriftBaseline::save(const std::string& filename) const {
+    if (features.empty()) {
+        return fail("Drift baseline has not been captured");
+    }
+
+    std::ostringstream text;
+    char number[32];
+    auto put = [&](double value) {
+        std::snprintf(number, sizeof(number), " %.17g", value);
+        text << number;
+    };
+
+    text << BASELINE_HEADER << "\n";
+    text << "features " << features.size() << "\n";
+    for (size_t j = 0; j < features.size(); ++j) {
+        const Feature& feature = features[j];
+        text << "feature " << j << " count";
+        put(feature.count);
+        text << " mean";
+        put(feature.mean);
+        text << " variance";
+        put(feature.variance);
+        text << "\nedges " << feature.edges.size();
+        for (double value : feature.edges) {
+            put(value);
+        }
+        text << "\nfractions";
+        for (double value : feature.fractions) {
+            put(value);
+        }
+        text << "\n";
+    }
+
+    FileWriter writer;
+    if (!writer.open(filename) || !writer.write(text.str()) || !writer.close()) {
+        return fail("Could not write drift baseline " + filename);
+    }
+    return true;
+}
+
+bool DriftBaseline::load(const std::string& filename) {
+    FileReader reader;
+    std::string buffer;
+    if (!reader.open(filename) || !reader.readAll(buffer)) {
+        return fail("Could not open file " + filename);
+    }
+
+    std::istringstream text(buffer);
+    std::string header, version, key;
+    size_t featureCount = 0;
+    text >> header >> version;
+    if (header + " " + version != BASELINE_HEADER) {
+        return fail(filename + " is not a drift baseline");
+    }
+    text >> key >> featureCount;
+    if (!text || featureCount == 0) {
+        return fail("Malformed drift baseline header in " + filename);
+    }
+
+    std::vector<Feature> loaded(featureCount);
+    for (Feature& feature : loaded) {
+        size_t index = 0, edgeCount = 0;
+        text >> key >> index >> key >> feature.count >> key >> feature.mean >> key >> feature.variance;
+        text >> key >> edgeCount;
+        if (!text || edgeCount >= BINS) {
+            return fail("Malformed drift baseline " + filename);
+        }
+        feature.edges.resize(edgeCount);
+        for (double& value : feature.edges) {
+            text >> value;
+        }
+        feature.fractions.resize(edgeCount + 1);
+        text >> key;
+        for (double& value : feature.fractions) {
+            text >> value;
+        }
+        if (!text || !std::is_sorted(feature.edges.begin(), feature.edges.end())) {
+            return fail("Truncated drift baseline " + filename);
+        }
+    }
+
+    features = std::move(loaded);
+    return true;
+}
+
+// Chan et al. pairwise update of the moments
+void DriftMonitor::Sketch::merge(const Sketch& other) {
+    if (other.count == 0.0) {
+        return;
+    }
+    double total = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / total;
+    m2 += other.m2 + delta * delta * count * other.count / total;
+    count = total;
+    for (size_t b = 0; b < bins.size(); ++b) {
+        bins[b] += other.bins[b];
+    }
+}
+
+DriftMonitor::DriftMonitor(const DriftBaseline& baseline, const DriftConfig& config)
+    : baseline(baseline), config(config), featureCount(baseline.featureCount()), scored(0), dropped(0),
+      pendingRows(0), folding(false), stopping(false) {
+    if (featureCount == 0) {
+        throw std::invalid_argument("DriftMonitor: empty baseline");
+    }
+    size_t stride = 1;
+    while (stride < this->config.sampleStride) {
+        stride <<= 1;
+    }
+    this->config.sampleStride = stride;
+    this->config.batchRows = std::max<size_t>(this->config.batchRows, 1);
+    this->config.windowRows = std::max<size_t>(this->config.windowRows, 1);
+    pending.resize(this->config.batchRows * featureCount);
+    current = emptySketches();
+    previous = emptySketches();
+    worker = std::thread(&DriftMonitor::run, this);
+}
+
+DriftMonitor::~DriftMonitor() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+    worker.join();
+}
+
+std::vector<DriftMonitor::Sketch> DriftMonitor::emptySketches() const {
+    std::vector<Sketch> sketches(featureCount);
+    for (size_t j = 0; j < featureCount; ++j) {
+        sketches[j].bins.assign(baseline.feature(j).fractions.size(), 0.0);
+    }
+    return sketches;
+}
+
+void DriftMonitor::observe(const double* rows, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    // Sample rows at fixed positions in the stream, whichever call carries them
+    size_t offset = firstSample(count);
+    if (offset >= count) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(queueMutex);
+    for (size_t i = offset; i < count; i += config.sampleStride) {
+        std::copy_n(rows + i * featureCount, featureCount, pending.data() + pendingRows * featureCount);
+        if (++pendingRows == config.batchRows) {
+            enqueuePending(false);
+        }
+    }
+}
+
+void DriftMonitor::observeColumns(const float* const* columns, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    size_t offset = firstSample(count);
+    if (offset >= count) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(queueMutex);
+    for (size_t i = offset; i < count; i += config.sampleStride) {
+        double* row = pending.data() + pendingRows * featureCount;
+        for (size_t j = 0; j < featureCount; ++j) {
+            row[j] = columns[j][i];
+        }
+        if (++pendingRows == config.batchRows) {
+            enqueuePending(false);
+        }
+    }
+}
+
+// Claims the next count stream positions; index of the first sampled row among them
+size_t DriftMonitor::firstSample(size_t count) {
+    uint64_t first = scored.fetch_add(count, std::memory_order_relaxed);
+    uint64_t mask = config.sampleStride - 1;
+    return static_cast<size_t>((config.sampleStride - (first & mask)) & mask);
+}
+
+// Caller holds queueMutex; force queues the batch even when the queue is full.
+// A dropped batch keeps its buffer, a queued one is replaced by a spare
+void DriftMonitor::enqueuePending(bool force) {
+    if (pendingRows == 0) {
+        return;
+    }
+    if (force || queue.size() < config.queueBatches) {
+        pending.resize(pendingRows * featureCount);
+        queue.push_back(std::move(pending));
+        queueReady.notify_one();
+        if (spares.empty()) {
+            pending = std::vector<double>();
+        } else {
+            pending = std::move(spares.back());
+            spares.pop_back();
+        }
+        pending.resize(config.batchRows * featureCount);
+    } else {
+        dropped.fetch_add(pendingRows, std::memory_order_relaxed);
+    }
+    pendingRows = 0;
+}
+
+void DriftMonitor::flush() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    enqueuePending(true);
+    queueIdle.wait(lock, [&]() { return queue.empty() && !folding; });
+}
+
+// Sketch of the whole batch first, from sums shifted by the training mean (no
+// division per value), then one merge under the lock; a full window rolls over
+// at the next batch boundary
+void DriftMonitor::fold(const std::vector<double>& rows) {
+    size_t count = rows.size() / featureCount;
+    std::vector<Sketch> batch = emptySketches();
+    for (size_t j = 0; j < featureCount; ++j) {
+        const DriftBaseline::Feature& reference = baseline.feature(j);
+        Sketch& sketch = batch[j];
+        double shifted = 0.0, squares = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            double value = rows[i * featureCount + j];
+            double delta = value - reference.mean;
+            shifted += delta;
+            squares += delta * delta;
+            sketch.bins[DriftBaseline::binOf(reference.edges, value)] += 1.0;
+        }
+        sketch.count = static_cast<double>(count);
+        sketch.mean = reference.mean + shifted / sketch.count;
+        sketch.m2 = std::max(squares - shifted * shifted / sketch.count, 0.0);
+    }
+
+    std::lock_guard<std::mutex> lock(sketchMutex);
+    if (current[0].count >= static_cast<double>(config.windowRows)) {
+        previous = std::move(current);
+        current = emptySketches();
+    }
+    for (size_t j = 0; j < featureCount; ++j) {
+        current[j].merge(batch[j]);
+    }
+}
+
+void DriftMonitor::run() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    for (;;) {
+        queueReady.wait(lock, [&]() { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            return;  // stopping, nothing left to fold
+        }
+        std::vector<double> rows = std::move(queue.front());
+        queue.pop_front();
+        folding = true;
+        lock.unlock();
+        fold(rows);
+        lock.lock();
+        folding = false;
+        if (spares.size() <= config.queueBatches) {
+            spares.push_back(std::move(rows));
+        }
+        if (queue.empty()) {
+            queueIdle.notify_all();
+        }
+    }
+}
+
+DriftMonitor::Report DriftMonitor::report() {
+    flush();
+
+    std::vector<Sketch> window;
+    {
+        std::lock_guard<std::mutex> lock(sketchMutex);
+        window = previous;
+        for (size_t j = 0; j < featureCount; ++j) {
+            window[j].merge(current[j]);
+        }
+    }
+
+    Report result;
+    result.scoredRows = scored.load(std::memory_order_relaxed);
+    result.droppedRows = dropped.load(std::memory_order_relaxed);
+    result.windowRows = static_cast<uint64_t>(window[0].count);
+    result.judged = result.windowRows >= config.minWindowRows;
+    result.features.resize(featureCount);
+
+    // Two-sample KS critical value: c(alpha) * sqrt((n + m) / (n m))
+    double ksCoefficient = std::sqrt(-0.5 * std::log(config.ksAlpha / 2.0));
+    for (size_t j = 0; j < featureCount; ++j) {
+        const DriftBaseline::Feature& reference = baseline.feature(j);
+        const Sketch& live = window[j];
+        FeatureDrift& drift = result.features[j];
+        drift.baselineMean = reference.mean;
+        drift.baselineStdDev = std::sqrt(reference.variance);
+        if (live.count == 0.0) {
+            continue;
+        }
+        drift.liveMean = live.mean;
+        drift.liveStdDev = live.count > 1.0 ? std::sqrt(live.m2 / (live.count - 1.0)) : 0.0;
+
+        double expectedCumulative = 0.0, actualCumulative = 0.0;
+        for (size_t b = 0; b < reference.fractions.size(); ++b) {
+            double expected = std::max(reference.fractions[b], PSI_FLOOR);
+            double actual = std::max(live.bins[b] / live.count, PSI_FLOOR);
+            drift.psi += (actual - expected) * std::log(actual / expected);
+            expectedCumulative += reference.fractions[b];
+            actualCumulative += live.bins[b] / live.count;
+            drift.ks = std::max(drift.ks, std::abs(expectedCumulative - actualCumulative));
+        }
+        drift.ks = std::min(drift.ks, 1.0);
+        drift.ksCritical = ksCoefficient * std::sqrt((reference.count + live.count) / (reference.count * live.count));
+        drift.drifted = result.judged && (drift.psi > config.psiThreshold || drift.ks > drift.ksCritical);
+        result.drifted = result.drifted || drift.drifted;
+    }
+    return result;
+}
+
+void DriftMonitor::display(const Report& report) {
+    std::vector<std::string> featureNames = {"MYCT", "MMIN", "MMAX", "CACH", "CHMIN", "CHMAX"};
+
+    std::cout << "\n=== Feature Drift ===" << std::endl;
+    std::cout << "Scored rows: " << report.scoredRows << ", window: " << report.windowRows
+              << " sampled rows, dropped: " << report.droppedRows << std::endl;
+    std::cout << std::left << std::setw(8) << "Feature" << std::right << std::setw(12) << "Train mean"
+              << std::setw(12) << "Live mean" << std::setw(12) << "Train sd" << std::setw(12) << "Live sd"
+              << std::setw(9) << "PSI" << std::setw(8) << "KS" << std::setw(9) << "KS crit" << std::endl;
+    for (size_t j = 0; j < report.features.size(); ++j) {
+        const FeatureDrift& drift = report.features[j];
+        std::string name = report.features.size() == featureNames.size() ? featureNames[j] : std::to_string(j);
+        std::cout << std::left << std::setw(8) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << drift.baselineMean << std::setw(12) << drift.liveMean << std::setw(12)
+                  << drift.baselineStdDev << std::setw(12) << drift.liveStdDev << std::setprecision(3)
+                  << std::setw(9) << drift.psi << std::setw(8) << drift.ks << std::setw(9) << drift.ksCritical
+                  << (drift.drifted ? "  DRIFT" : "") << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    if (!report.judged) {
+        std::cout << "Too few sampled rows to judge drift yet" << std::endl;
+    } else {
+        std::cout << (report.drifted ? "Drift detected: retraining recommended" : "No drift detected") << std::endl;
+    }
+}
@@ -0,0 +1,446 @@
+#include "../include/Ensemble.h"
+#include "../include/NormalEquations.h"
+#include "../include/Parallel.h"
+#include "../include/SplitMix64.h"
+#include "../include/Summation.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Batches per parallel block in predictMembers()
+const size_t BATCH_GRAIN = 4;
+// Coordinate-descent sweeps for the non-negative blend
+const int BLEND_SWEEPS = 500;
+
+// Column-major copy of X plus per-column pointers for NormalEquations::addColumns
+struct ColumnCopy {
+    std::vector<double> storage;
+    std::vector<const double*> columns;
+
+    explicit ColumnCopy(const Matrix& X)
+        : storage(X.getRows() * X.getCols()), columns(X.getCols()) {
+        size_t n = X.getRows();
+        for (size_t i = 0; i < n; ++i) {
+            const std::vector<double>& row = X[i];
+            for (size_t j = 0; j < row.size(); ++j) {
+                storage[j * n + i] = row[j];
+            }
+        }
+        for (size_t j = 0; j < columns.size(); ++j) {
+            columns[j] = storage.data() + j * n;
+        }
+    }
+};
+
+} // namespace
+
+// Constructor
+Ensemble::Ensemble()
+    : kind(Kind::Bagged), features(6), blendIntercept(0.0), isTrained(false) {}
+
+// Bagged ridge members trained in parallel from Poisson-weighted Gram matrices
+bool Ensemble::fitBagged(const Matrix& X, const std::vector<double>& y, size_t members,
+                         double lambda, uint64_t seed) {
+    size_t n = X.getRows();
+    size_t p = X.getCols();
+
+    if (n == 0 || p == 0 || members == 0) {
+        std::cerr << "Error: Training data or ensemble size is empty" << std::endl;
+        return false;
+    }
+    if (y.size() != n) {
+        std::cerr << "Error: Design matrix and targets do not match" << std::endl;
+        return false;
+    }
+
+    ColumnCopy copy(X);
+    Matrix coefficients(p, members);
+    std::vector<char> failed(members, 0);
+
+    // Each member owns its seed, so the fit does not depend on the thread count
+    Parallel::parallelFor(members, 1, [&](size_t, size_t begin, size_t end) {
+        std::vector<double> weights(n);
+        for (size_t m = begin; m < end; ++m) {
+            SplitMix64 random(seed + m);
+            for (size_t i = 0; i < n; ++i) {
+                weights[i] = random.poisson(1.0);
+            }
+            try {
+                NormalEquations equations(p);
+                equations.addColumns(copy.columns.data(), y.data(), n, weights.data());
+                std::vector<double> theta = equations.solve(lambda);
+                for (size_t j = 0; j < p; ++j) {
+                    coefficients[j][m] = theta[j];
+                }
+            }
+            catch (const std::exception&) {
+                failed[m] = 1;
+            }
+        }
+    });
+
+    for (size_t m = 0; m < members; ++m) {
+        if (failed[m]) {
+            std::cerr << "Error: Bootstrap member " << m + 1 << " has a singular Gram matrix" << std::endl;
+            isTrained = false;
+            return false;
+        }
+    }
+
+    kind = Kind::Bagged;
+    features = p;
+    linearCoefficients = coefficients;
+    kernelMembers.clear();
+    memberNames.clear();
+    for (size_t m = 0; m < members; ++m) {
+        memberNames.push_back("bootstrap " + std::to_string(m + 1));
+    }
+    blendWeights.assign(members, 1.0 / members);
+    blendIntercept = 0.0;
+    fuse();
+    isTrained = true;
+    return true;
+}
+
+bool Ensemble::fitBagged(const Dataset& trainData, size_t members, double lambda, uint64_t seed) {
+    if (trainData.empty()) {
+        std::cerr << "Error: Training dataset is empty" << std::endl;
+        return false;
+    }
+    return fitBagged(createDesignMatrix(trainData), createTargetVector(trainData),
+                     members, lambda, seed);
+}
+
+// Stacking: out-of-fold member predictions feed a non-negative blend
+bool Ensemble::fitStacked(const Matrix& X, const std::vector<double>& y,
+                          const std::vector<double>& ridgeLambdas,
+                          const std::vector<size_t>& kernelFrequencies,
+                          int folds, uint64_t seed) {
+    size_t n = X.getRows();
+    size_t p = X.getCols();
+    size_t linearCount = ridgeLambdas.size();
+    size_t memberCount = linearCount + kernelFrequencies.size();
+
+    if (n == 0 || p == 0 || memberCount == 0) {
+        std::cerr << "Error: Training data or member list is empty" << std::endl;
+        return false;
+    }
+    if (y.size() != n) {
+        std::cerr << "Error: Design matrix and targets do not match" << std::endl;
+        return false;
+    }
+    if (folds < 2 || n < static_cast<size_t>(2 * folds)) {
+        std::cerr << "Error: Not enough rows for " << folds << "-fold stacking" << std::endl;
+        return false;
+    }
+
+    try {
+        // Random fold assignment
+        SplitMix64 random(seed);
+        std::vector<size_t> fold(n);
+        for (size_t i = 0; i < n; ++i) {
+            fold[i] = random.next() % folds;
+        }
+
+        // Per-fold sufficient statistics; training on "all but k" is a merge
+        ColumnCopy copy(X);
+        std::vector<NormalEquations> foldEquations(folds, NormalEquations(p));
+        Parallel::parallelFor(folds, 1, [&](size_t, size_t begin, size_t end) {
+            std::vector<double> mask(n);
+            for (size_t k = begin; k < end; ++k) {
+                for (size_t i = 0; i < n; ++i) {
+                    mask[i] = fold[i] == k ? 1.0 : 0.0;
+                }
+                foldEquations[k].addColumns(copy.columns.data(), y.data(), n, mask.data());
+            }
+        });
+
+        Matrix outOfFold(n, memberCount);
+        for (size_t k = 0; k < static_cast<size_t>(folds); ++k) {
+            NormalEquations others(p);
+            for (size_t f = 0; f < static_cast<size_t>(folds); ++f) {
+                if (f != k) {
+                    others.merge(foldEquations[f]);
+                }
+            }
+            for (size_t l = 0; l < linearCount; ++l) {
+                std::vector<double> theta = others.solve(ridgeLambdas[l]);
+                for (size_t i = 0; i < n; ++i) {
+                    if (fold[i] != k) {
+                        continue;
+                    }
+                    double prediction = 0.0;
+                    for (size_t j = 0; j < p; ++j) {
+                        prediction += X[i][j] * theta[j];
+                    }
+                    outOfFold[i][l] = prediction;
+                }
+            }
+
+            if (!kernelFrequencies.empty()) {
+                std::vector<size_t> trainRows, testRows;
+                for (size_t i = 0; i < n; ++i) {
+                    (fold[i] == k ? testRows : trainRows).push_back(i);
+                }
+                Matrix trainX(trainRows.size(), p), testX(testRows.size(), p);
+                std::vector<double> trainY(trainRows.size());
+                for (size_t r = 0; r < trainRows.size(); ++r) {
+                    trainX[r] = X[trainRows[r]];
+                    trainY[r] = y[trainRows[r]];
+                }
+                for (size_t r = 0; r < testRows.size(); ++r) {
+                    testX[r] = X[testRows[r]];
+                }
+                for (size_t q = 0; q < kernelFrequencies.size(); ++q) {
+                    KernelRidgeRegression member(kernelFrequencies[q], 1.0, 0.0, seed + q);
+                    if (!member.fit(trainX, trainY)) {
+                        return false;
+                    }
+                    std::vector<double> predictions = member.predict(testX);
+                    for (size_t r = 0; r < testRows.size(); ++r) {
+                        outOfFold[testRows[r]][linearCount + q] = predictions[r];
+                    }
+                }
+            }
+        }
+
+        // Blend fitted on centered out-of-fold predictions, with a free intercept
+        std::vector<double> columnMean(memberCount, 0.0);
+        double yMean = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t m = 0; m < memberCount; ++m) {
+                columnMean[m] += outOfFold[i][m];
+            }
+            yMean += y[i];
+        }
+        for (double& mean : columnMean) {
+            mean /= n;
+        }
+        yMean /= n;
+
+        Matrix gram(memberCount, memberCount);
+        std::vector<double> rhs(memberCount, 0.0);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t a = 0; a < memberCount; ++a) {
+                double da = outOfFold[i][a] - columnMean[a];
+                for (size_t b = 0; b < memberCount; ++b) {
+                    gram[a][b] += da * (outOfFold[i][b] - columnMean[b]);
+                }
+                rhs[a] += da * (y[i] - yMean);
+            }
+        }
+        // Non-negative weights (coordinate descent on the small member Gram)
+        // keep correlated members from cancelling each other out
+        std::vector<double> blend(memberCount, 0.0);
+        for (int sweep = 0; sweep < BLEND_SWEEPS; ++sweep) {
+            for (size_t m = 0; m < memberCount; ++m) {
+                if (gram[m][m] <= 0.0) {
+                    continue;
+                }
+                double residual = rhs[m];
+                for (size_t k = 0; k < memberCount; ++k) {
+                    if (k != m) {
+                        residual -= gram[m][k] * blend[k];
+                    }
+                }
+                blend[m] = std::max(0.0, residual / gram[m][m]);
+            }
+        }
+        double intercept = yMean;
+        for (size_t m = 0; m < memberCount; ++m) {
+            intercept -= blend[m] * columnMean[m];
+        }
+
+        // Refit every member on all rows
+        NormalEquations all(p);
+        for (const NormalEquations& equations : foldEquations) {
+            all.merge(equations);
+        }
+        Matrix coefficients(p, linearCount);
+        std::vector<std::string> names;
+        for (size_t l = 0; l < linearCount; ++l) {
+            std::vector<double> theta = all.solve(ridgeLambdas[l]);
+            for (size_t j = 0; j < p; ++j) {
+                coefficients[j][l] = theta[j];
+            }
+            std::ostringstream name;
+            name << "ridge (lambda=" << ridgeLambdas[l] << ")";
+            names.push_back(name.str());
+        }
+        std::vector<KernelRidgeRegression> kernels;
+        for (size_t q = 0; q < kernelFrequencies.size(); ++q) {
+            KernelRidgeRegression member(kernelFrequencies[q], 1.0, 0.0, seed + q);
+            if (!member.fit(X, y)) {
+                return false;
+            }
+            kernels.push_back(member);
+            names.push_back("kernel ridge (" + std::to_string(kernelFrequencies[q]) + " frequencies)");
+        }
+
+        kind = Kind::Stacked;
+        features = p;
+        linearCoefficients = coefficients;
+        kernelMembers = kernels;
+        memberNames = names;
+        blendWeights = blend;
+        blendIntercept = intercept;
+        fuse();
+        isTrained = true;
+        return true;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error during stacked training: " << e.what() << std::endl;
+        isTrained = false;
+        return false;
+    }
+}
+
+bool Ensemble::fitStacked(const Dataset& trainData, int folds, uint64_t seed) {
+    if (trainData.empty()) {
+        std::cerr << "Error: Training dataset is empty" << std::endl;
+        return false;
+    }
+    return fitStacked(createDesignMatrix(trainData), createTargetVector(trainData),
+                      {0.0, 1e3, 1e5}, {128, 512}, folds, seed);
+}
+
+// Fold the linear part of the blend into one coefficient vector
+void Ensemble::fuse() {
+    size_t linearCount = linearCoefficients.getCols();
+    fusedCoefficients.assign(features, 0.0);
+    for (size_t j = 0; j < features; ++j) {
+        const std::vector<double>& row = linearCoefficients[j];
+        for (size_t l = 0; l < linearCount; ++l) {
+            fusedCoefficients[j] += row[l] * blendWeights[l];
+        }
+    }
+    fusedScorer = ScoringKernel(fusedCoefficients, blendIntercept);
+}
+
+// Per-member predictions: one GEMM for the linear members per batch
+Matrix Ensemble::predictMembers(const Matrix& X) const {
+    if (!isTrained) {
+        throw std::runtime_error("Model has not been trained yet");
+    }
+    if (X.getCols() != features) {
+        throw std::invalid_argument("Design matrix column count does not match the model");
+    }
+
+    size_t n = X.getRows();
+    size_t linearCount = linearCoefficients.getCols();
+    Matrix result(n, memberNames.size());
+
+    // Batches are independent: each is one GEMM against the linear members
+    // and one predict per kernel member, written to its own result rows
+    size_t batches = (n + BATCH_ROWS - 1) / BATCH_ROWS;
+    Parallel::parallelFor(batches, BATCH_GRAIN, [&](size_t, size_t first, size_t last) {
+        for (size_t b = first; b < last; ++b) {
+            size_t batchBegin = b * BATCH_ROWS;
+            size_t batchEnd = std::min(n, batchBegin + BATCH_ROWS);
+            ConstMatrixView batch = X.rowRange(batchBegin, batchEnd);
+
+            Matrix linear = Matrix::multiply(batch, linearCoefficients);
+            for (size_t i = batchBegin; i < batchEnd; ++i) {
+                std::copy(linear[i - batchBegin].begin(), linear[i - batchBegin].end(), result[i].begin());
+            }
+            for (size_t q = 0; q < kernelMembers.size(); ++q) {
+                std::vector<double> predictions = kernelMembers[q].predict(batch);
+                for (size_t i = batchBegin; i < batchEnd; ++i) {
+                    result[i][linearCount + q] = predictions[i - batchBegin];
+                }
+            }
+        }
+    });
+    return result;
+}
+
+// Blended prediction: the fused linear vector plus the kernel members
+std::vector<double> Ensemble::predict(const Matrix& X) const {
+    if (!isTrained) {
+        throw std::runtime_error("Model has not been trained yet");
+    }
+    if (X.getCols() != features) {
+        throw std::invalid_argument("Design matrix column count does not match the model");
+    }
+
+    size_t n = X.getRows();
+    std::vector<double> result = fusedScorer.score(X);
+
+    size_t linearCount = linearCoefficients.getCols();
+    for (size_t q = 0; q < kernelMembers.size(); ++q) {
+        std::vector<double> predictions = kernelMembers[q].predict(X);
+        double weight = blendWeights[linearCount + q];
+        for (size_t i = 0; i < n; ++i) {
+            result[i] += weight * predictions[i];
+        }
+    }
+    return result;
+}
+
+std::vector<double> Ensemble::predict(const Dataset& data) const {
+    return predict(createDesignMatrix(data));
+}
+
+// Root mean squared error on PRP
+double Ensemble::calculateRMSE(const Dataset& data) const {
+    if (data.empty()) {
+        return 0.0;
+    }
+    std::vector<double> predictions = predict(data);
+    std::vector<double> targets(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        targets[i] = data[i].getTarget();
+    }
+    return std::sqrt(Summation::squaredDifferences(predictions.data(), targets.data(), data.size()) / data.size());
+}
+
+// Features as an n x 6 matrix
+Matrix Ensemble::createDesignMatrix(const Dataset& data) {
+    Matrix X(data.size(), 6);
+    for (size_t i = 0; i < data.size(); ++i) {
+        X[i] = data[i].getFeatureVector();
+    }
+    return X;
+}
+
+// PRP targets
+std::vector<double> Ensemble::createTargetVector(const Dataset& data) {
+    std::vector<double> y(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        y[i] = data[i].getTarget();
+    }
+    return y;
+}
+
+// Display model information
+void Ensemble::displayModel() const {
+    std::cout << "\n=== " << (kind == Kind::Bagged ? "Bagged" : "Stacked") << " Ensemble ===" << std::endl;
+
+    if (!isTrained) {
+        std::cout << "Model has not been trained yet." << std::endl;
+        return;
+    }
+
+    std::cout << "Members: " << memberNames.size() << std::endl;
+    if (kind == Kind::Stacked) {
+        std::cout << std::left << std::setw(36) << "Member" << std::right << std::setw(12) << "Weight" << std::endl;
+        for (size_t m = 0; m < memberNames.size(); ++m) {
+            std::cout << std::left << std::setw(36) << memberNames[m] << std::right
+                      << std::setw(12) << std::fixed << std::setprecision(4) << blendWeights[m] << std::endl;
+        }
+        std::cout << std::left << std::setw(36) << "intercept" << std::right
+                  << std::setw(12) << blendIntercept << std::endl;
+    }
+
+    std::vector<std::string> featureNames = {"MYCT", "MMIN", "MMAX", "CACH", "CHMIN", "CHMAX"};
+    std::cout << "Fused linear coefficients:" << std::endl;
+    for (size_t j = 0; j < fusedCoefficients.size(); ++j) {
+        std::cout << "  " << std::setw(6) << (j < featureNames.size() ? featureNames[j] : "x" + std::to_string(j + 1))
+                  << ": " << std::fixed << std::setprecision(6) << fusedCoefficients[j] << std::endl;
+    }
+}
@@ -1,11 +1,31 @@
 #include "../include/Evaluator.h"
+#include "../include/FileIO.h"
+#include "../include/HugePages.h"
+#include "../include/Summation.h"
 #include <iostream>
 #include <iomanip>
-#include <fstream>
+#include <sstream>
+#include <cstdio>
 #include <cmath>
 #include <algorithm>
 #include <numeric>
 
+namespace {
+
+// printf-style formatting into line, resized to the exact length (no truncation)
+template <typename... Args>
+bool formatLine(std::string& line, const char* pattern, Args... args) {
+    int length = std::snprintf(nullptr, 0, pattern, args...);
+    if (length < 0) {
+        return false;
+    }
+    line.resize(static_cast<size_t>(length));
+    std::snprintf(&line[0], line.size() + 1, pattern, args...);
+    return true;
+}
+
+} // namespace
+
 // Constructor
 Evaluator::Evaluator(LinearRegression* model) : model(model) {
     if (!model) {
@@ -46,15 +66,9 @@ Evaluator::EvaluationResults Evaluator::evaluate(const Dataset& testData) const
 void Evaluator::generateReport(const Dataset& testData, const std::string& filename) const {
     EvaluationResults results = evaluate(testData);
     
-    std::ostream* output = &std::cout;
-    std::ofstream file;
-    
-    if (!filename.empty()) {
-        file.open(filename);
-        if (file.is_open()) {
-            output = &file;
-        }
-    }
+    // Reports for a file are staged in memory and handed to the async writer
+    std::ostringstream buffer;
+    std::ostream* output = filename.empty() ? &std::cout : &buffer;
     
     *output << "=====================================\n";
     *output << "    LINEAR REGRESSION EVALUATION\n";
@@ -84,7 +98,24 @@ void Evaluator::generateReport(const Dataset& testData, const std::string& filen
     *output << "Mean Absolute Error (MAE):     " << results.mae << "\n";
     *output << "R-squared (R²):                " << results.rSquared << "\n";
     *output << "Mean Absolute Percentage Error: " << results.meanAbsolutePercentageError << "%\n";
-    *output << "Number of test samples:        " << testData.size() << "\n\n";
+    *output << "Number of test samples:        " << testData.size() << "\n";
+    *output << "Huge-page coverage:            " << HugePages::describe(HugePages::coverage()) << "\n\n";
+    
+    // Interval calibration on held-out rows
+    if (model->getHasInference() && !testData.empty()) {
+        std::vector<LinearRegression::PredictionInterval> intervals = model->predictIntervals(testData);
+        size_t covered = 0;
+        double meanWidth = 0.0;
+        for (size_t i = 0; i < intervals.size(); ++i) {
+            double actual = testData[i].getTarget();
+            covered += (actual >= intervals[i].lower && actual <= intervals[i].upper) ? 1 : 0;
+            meanWidth += intervals[i].upper - intervals[i].lower;
+        }
+        *output << "Prediction Intervals (95%):\n";
+        *output << "--------------------------\n";
+        *output << "Coverage:          " << 100.0 * covered / intervals.size() << "%\n";
+        *output << "Mean width:        " << meanWidth / intervals.size() << "\n\n";
+    }
     
     // Residual statistics
     double meanResidual = calculateMean(results.residuals);
@@ -115,12 +146,61 @@ void Evaluator::generateReport(const Dataset& testData, const std::string& filen
                 << std::setw(11) << percentError << "%\n";
     }
     
-    if (file.is_open()) {
-        file.close();
-        std::cout << "Evaluation report saved to: " << filename << std::endl;
+    if (!filename.empty()) {
+        FileWriter writer;
+        if (writer.open(filename) && writer.write(buffer.str()) && writer.close()) {
+            std::cout << "Evaluation report saved to: " << filename << std::endl;
+        } else {
+            std::cout << buffer.str();
+        }
     }
 }
 
+// Write bulk predictions as CSV
+bool Evaluator::exportPredictions(const Dataset& data, const std::string& filename) const {
+    if (!model->getIsTrained()) {
+        throw std::runtime_error("Model has not been trained yet");
+    }
+    
+    FileWriter writer;
+    if (!writer.open(filename)) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+    
+    // 95% prediction bounds are appended when the fit supports them
+    bool intervals = model->getHasInference();
+    bool ok = writer.write(intervals ? "vendor,model,actual,predicted,residual,lower95,upper95\n"
+                                     : "vendor,model,actual,predicted,residual\n");
+    std::vector<double> predictions = model->predict(data);
+    std::vector<LinearRegression::PredictionInterval> bounds;
+    if (intervals) {
+        bounds = model->predictIntervals(data);
+    }
+    std::string line;
+    
+    for (size_t i = 0; i < data.size() && ok; ++i) {
+        double actual = data[i].getTarget();
+        bool formatted = intervals
+            ? formatLine(line, "%s,%s,%.0f,%.4f,%.4f,%.4f,%.4f\n",
+                         data[i].getVendor().c_str(), data[i].getModel().c_str(),
+                         actual, predictions[i], actual - predictions[i],
+                         bounds[i].lower, bounds[i].upper)
+            : formatLine(line, "%s,%s,%.0f,%.4f,%.4f\n",
+                         data[i].getVendor().c_str(), data[i].getModel().c_str(),
+                         actual, predictions[i], actual - predictions[i]);
+        ok = formatted && writer.write(line);
+    }
+    
+    ok = writer.close() && ok;
+    if (ok) {
+        std::cout << "Predictions saved to: " << filename << std::endl;
+    } else {
+        std::cerr << "Error: Failed while writing " << filename << std::endl;
+    }
+    return ok;
+}
+
 // Residual analysis
 void Evaluator::residualAnalysis(const Dataset& testData) const {
     EvaluationResults results = evaluate(testData);
@@ -189,18 +269,16 @@ double Evaluator::calculateMAPE(const std::vector<double>& actual, const std::ve
         throw std::invalid_argument("Vectors must be non-empty and of equal size");
     }
     
-    double sumPercentageError = 0.0;
-    size_t validCount = 0;
+    std::vector<double> percentageErrors;
+    percentageErrors.reserve(actual.size());
     
     for (size_t i = 0; i < actual.size(); ++i) {
         if (actual[i] != 0.0) {  // Avoid division by zero
-            double percentageError = std::abs((actual[i] - predicted[i]) / actual[i]) * 100.0;
-            sumPercentageError += percentageError;
-            validCount++;
+            percentageErrors.push_back(std::abs((actual[i] - predicted[i]) / actual[i]) * 100.0);
         }
     }
     
-    return validCount > 0 ? sumPercentageError / validCount : 0.0;
+    return Summation::mean(percentageErrors);
 }
 
 // Calculate R-squared
@@ -209,17 +287,9 @@ double Evaluator::calculateR2(const std::vector<double>& actual, const std::vect
         throw std::invalid_argument("Vectors must be non-empty and of equal size");
     }
     
-    // Calculate mean of actual values
-    double meanActual = std::accumulate(actual.begin(), actual.end(), 0.0) / actual.size();
-    
-    // Calculate sum of squares
-    double totalSumSquares = 0.0;
-    double residualSumSquares = 0.0;
-    
-    for (size_t i = 0; i < actual.size(); ++i) {
-        totalSumSquares += (actual[i] - meanActual) * (actual[i] - meanActual);
-        residualSumSquares += (actual[i] - predicted[i]) * (actual[i] - predicted[i]);
-    }
+    // Sum of squares about the mean of actual values and about the predictions
+    double totalSumSquares = Summation::squaredDeviations(actual.data(), actual.size(), Summation::mean(actual));
+    double residualSumSquares = Summation::squaredDifferences(actual.data(), predicted.data(), actual.size());
     
     return totalSumSquares == 0.0 ? 1.0 : 1.0 - (residualSumSquares / totalSumSquares);
 }
@@ -250,25 +320,92 @@ void Evaluator::displayResults(const EvaluationResults& results) const {
     std::cout << "R²:    " << results.rSquared << std::endl;
     std::cout << "MAPE:  " << results.meanAbsolutePercentageError << "%" << std::endl;
     std::cout << "Samples: " << results.predictions.size() << std::endl;
+    HugePages::Coverage coverage = HugePages::coverage();
+    if (coverage.allocations > 0) {
+        std::cout << "Huge pages: " << HugePages::describe(coverage) << std::endl;
+    }
+}
+
+// Per-target metrics of a multi-target model
+std::vector<Evaluator::TargetMetrics> Evaluator::evaluateTargets(const MultiTargetRegression& model,
+                                                                 const Dataset& testData) {
+    if (!model.getIsTrained()) {
+        throw std::runtime_error("Model has not been trained yet");
+    }
+    if (testData.empty()) {
+        throw std::invalid_argument("Test dataset is empty");
+    }
+    if (model.getTargetNames() != std::vector<std::string>{"PRP", "ERP"}) {
+        throw std::invalid_argument("Model targets are not the dataset's PRP and ERP columns");
+    }
+    
+    return evaluateTargets(model, MultiTargetRegression::createDesignMatrix(testData),
+                           MultiTargetRegression::createTargetMatrix(testData));
+}
+
+std::vector<Evaluator::TargetMetrics> Evaluator::evaluateTargets(const MultiTargetRegression& model,
+                                                                 const Matrix& X, const Matrix& actual) {
+    if (!model.getIsTrained()) {
+        throw std::runtime_error("Model has not been trained yet");
+    }
+    if (X.getRows() == 0) {
+        throw std::invalid_argument("Test dataset is empty");
+    }
+    if (actual.getRows() != X.getRows() || actual.getCols() != model.getTargetCount()) {
+        throw std::invalid_argument("Actual values must be one column per model target");
+    }
+    
+    Matrix predicted = model.predict(X);
+    size_t n = X.getRows();
+    
+    std::vector<TargetMetrics> metrics;
+    for (size_t t = 0; t < model.getTargetCount(); ++t) {
+        std::vector<double> actuals(n), predictions(n);
+        for (size_t i = 0; i < n; ++i) {
+            actuals[i] = actual[i][t];
+            predictions[i] = predicted[i][t];
+        }
+        
+        TargetMetrics target;
+        target.name = model.getTargetNames()[t];
+        target.mse = Summation::squaredDifferences(predictions.data(), actuals.data(), n) / n;
+        target.rmse = std::sqrt(target.mse);
+        target.mae = Summation::absoluteDifferences(predictions.data(), actuals.data(), n) / n;
+        target.rSquared = calculateR2(actuals, predictions);
+        target.meanAbsolutePercentageError = calculateMAPE(actuals, predictions);
+        metrics.push_back(target);
+    }
+    return metrics;
+}
+
+// Display per-target metrics as a table
+void Evaluator::displayTargetMetrics(const std::vector<TargetMetrics>& metrics) {
+    std::cout << "\n=== Per-Target Evaluation Results ===" << std::endl;
+    std::cout << std::setw(8) << "Target" << std::setw(12) << "RMSE" << std::setw(12) << "MSE"
+              << std::setw(12) << "MAE" << std::setw(10) << "R²" << std::setw(10) << "MAPE" << std::endl;
+    std::cout << std::string(64, '-') << std::endl;
+    
+    std::cout << std::fixed << std::setprecision(4);
+    for (const TargetMetrics& target : metrics) {
+        std::cout << std::setw(8) << target.name
+                  << std::setw(12) << target.rmse
+                  << std::setw(12) << target.mse
+                  << std::setw(12) << target.mae
+                  << std::setw(10) << target.rSquared
+                  << std::setw(9) << std::setprecision(2) << target.meanAbsolutePercentageError << "%"
+                  << std::setprecision(4) << std::endl;
+    }
 }
 
 // Helper functions
 double Evaluator::calculateMean(const std::vector<double>& values) const {
-    if (values.empty()) return 0.0;
-    return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    return Summation::mean(values);
 }
 
 double Evaluator::calculateVariance(const std::vector<double>& values) const {
     if (values.empty()) return 0.0;
     
-    double mean = calculateMean(values);
-    double variance = 0.0;
-    
-    for (double value : values) {
-        variance += (value - mean) * (value - mean);
-    }
-    
-    return variance / values.size();
+    return Summation::squaredDeviations(values.data(), values.size(), calculateMean(values)) / values.size();
 }
 
 double Evaluator::calculateStandardDeviation(const std::vector<double>& values) const {
@@ -0,0 +1,760 @@
+#include "../include/FileIO.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CPUPERF_HAVE_PREAD 1
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define CPUPERF_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+#endif
+
+/**
+ * @brief Common interface of the reader/writer backends
+ */
+class IoBackend {
+public:
+    virtual ~IoBackend() = default;
+    virtual const char* name() const = 0;
+
+    virtual bool openRead(const std::string& filename, uint64_t& size) = 0;
+    virtual bool readBlocks(uint64_t size,
+                            const std::function<bool(const char*, size_t)>& consumer) = 0;
+
+    virtual bool openWrite(const std::string& filename) = 0;
+    virtual bool write(const char* data, size_t length) = 0;
+
+    // Finish pending writes and release the file
+    virtual bool close() = 0;
+    virtual bool isOpen() const = 0;
+};
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// iostream backend (portable fallback)
+// ---------------------------------------------------------------------------
+class StreamBackend : public IoBackend {
+public:
+    explicit StreamBackend(size_t blockSize) : blockSize(blockSize) {}
+
+    const char* name() const override { return "stream"; }
+
+    bool openRead(const std::string& filename, uint64_t& size) override {
+        in.open(filename, std::ios::binary);
+        if (!in.is_open()) {
+            return false;
+        }
+        in.seekg(0, std::ios::end);
+        size = static_cast<uint64_t>(in.tellg());
+        in.seekg(0, std::ios::beg);
+        return true;
+    }
+
+    bool readBlocks(uint64_t, const std::function<bool(const char*, size_t)>& consumer) override {
+        std::vector<char> buffer(blockSize);
+        while (in) {
+            in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            size_t got = static_cast<size_t>(in.gcount());
+            if (got == 0) {
+                break;
+            }
+            if (!consumer(buffer.data(), got)) {
+                break;
+            }
+        }
+        return !in.bad();
+    }
+
+    bool openWrite(const std::string& filename) override {
+        out.open(filename, std::ios::binary | std::ios::trunc);
+        return out.is_open();
+    }
+
+    bool write(const char* data, size_t length) override {
+        out.write(data, static_cast<std::streamsize>(length));
+        return static_cast<bool>(out);
+    }
+
+    bool close() override {
+        bool ok = true;
+        if (out.is_open()) {
+            out.close();
+            ok = !out.fail();
+        }
+        if (in.is_open()) {
+            in.close();
+        }
+        return ok;
+    }
+
+    bool isOpen() const override { return in.is_open() || out.is_open(); }
+
+private:
+    size_t blockSize;
+    std::ifstream in;
+    std::ofstream out;
+};
+
+#ifdef CPUPERF_HAVE_PREAD
+// ---------------------------------------------------------------------------
+// pread / pwrite backend (synchronous, one block at a time)
+// ---------------------------------------------------------------------------
+class PreadBackend : public IoBackend {
+public:
+    explicit PreadBackend(size_t blockSize) : blockSize(blockSize), fd(-1), offset(0) {}
+    ~PreadBackend() override { close(); }
+
+    const char* name() const override { return "pread"; }
+
+    bool openRead(const std::string& filename, uint64_t& size) override {
+        fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close();
+            return false;
+        }
+        size = static_cast<uint64_t>(st.st_size);
+        return true;
+    }
+
+    bool readBlocks(uint64_t size, const std::function<bool(const char*, size_t)>& consumer) override {
+        std::vector<char> buffer(blockSize);
+        uint64_t pos = 0;
+        while (pos < size) {
+            size_t want = static_cast<size_t>(std::min<uint64_t>(blockSize, size - pos));
+            size_t got = 0;
+            while (got < want) {
+                ssize_t n = ::pread(fd, buffer.data() + got, want - got,
+                                    static_cast<off_t>(pos + got));
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n < 0) {
+                    return false;
+                }
+                if (n == 0) {
+                    break;  // file shrank underneath us
+                }
+                got += static_cast<size_t>(n);
+            }
+            if (got == 0 || !consumer(buffer.data(), got)) {
+                break;
+            }
+            pos += got;
+        }
+        return true;
+    }
+
+    bool openWrite(const std::string& filename) override {
+        fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        offset = 0;
+        pending.clear();
+        pending.reserve(blockSize);
+        return fd >= 0;
+    }
+
+    bool write(const char* data, size_t length) override {
+        pending.insert(pending.end(), data, data + length);
+        if (pending.size() >= blockSize) {
+            return flush();
+        }
+        return true;
+    }
+
+    bool close() override {
+        bool ok = true;
+        if (fd >= 0) {
+            ok = flush();
+            ::close(fd);
+            fd = -1;
+        }
+        return ok;
+    }
+
+    bool isOpen() const override { return fd >= 0; }
+
+private:
+    bool flush() {
+        size_t done = 0;
+        while (done < pending.size()) {
+            ssize_t n = ::pwrite(fd, pending.data() + done, pending.size() - done,
+                                 static_cast<off_t>(offset + done));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            done += static_cast<size_t>(n);
+        }
+        offset += done;
+        pending.clear();
+        return true;
+    }
+
+    size_t blockSize;
+    int fd;
+    uint64_t offset;
+    std::vector<char> pending;
+};
+#endif // CPUPERF_HAVE_PREAD
+
+#ifdef CPUPERF_HAVE_IO_URING
+// ---------------------------------------------------------------------------
+// Minimal io_uring submission/completion queue (raw syscalls, no liburing)
+// ---------------------------------------------------------------------------
+class UringQueue {
+public:
+    UringQueue() : ringFd(-1), sqRing(MAP_FAILED), cqRing(MAP_FAILED), sqeMap(MAP_FAILED),
+                   sqRingSize(0), cqRingSize(0), sqeMapSize(0), localTail(0), toSubmit(0) {}
+
+    ~UringQueue() {
+        if (sqeMap != MAP_FAILED) munmap(sqeMap, sqeMapSize);
+        if (cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingSize);
+        if (sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+        if (ringFd >= 0) ::close(ringFd);
+    }
+
+    bool init(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ringFd < 0) {
+            return false;
+        }
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap) {
+            sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+        }
+
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED) {
+            return false;
+        }
+        cqRing = singleMap ? sqRing
+                           : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            return false;
+        }
+        sqeMapSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqeMap = mmap(nullptr, sqeMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_SQES);
+        if (sqeMap == MAP_FAILED) {
+            return false;
+        }
+
+        char* sq = static_cast<char*>(sqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqEntries = params.sq_entries;
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sqes = static_cast<io_uring_sqe*>(sqeMap);
+
+        char* cq = static_cast<char*>(cqRing);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        localTail = *sqTail;
+        return true;
+    }
+
+    bool registerBuffers(const std::vector<iovec>& buffers) {
+        return syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS,
+                       buffers.data(), static_cast<unsigned>(buffers.size())) == 0;
+    }
+
+    // Next free submission entry, or nullptr if the queue is full
+    io_uring_sqe* nextSqe() {
+        unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        if (localTail - head >= sqEntries) {
+            return nullptr;
+        }
+        unsigned index = localTail & sqMask;
+        sqArray[index] = index;
+        ++localTail;
+        ++toSubmit;
+        io_uring_sqe* sqe = &sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    // Submit queued entries and optionally wait for completions
+    bool submit(unsigned waitFor) {
+        __atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+        while (true) {
+            unsigned flags = waitFor > 0 ? IORING_ENTER_GETEVENTS : 0;
+            long ret = syscall(__NR_io_uring_enter, ringFd, toSubmit, waitFor, flags, nullptr, 0);
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ret < 0) {
+                return false;
+            }
+            toSubmit -= static_cast<unsigned>(ret);
+            return true;
+        }
+    }
+
+    // Pop one completion if available
+    bool popCqe(io_uring_cqe& cqe) {
+        unsigned head = *cqHead;
+        if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+        cqe = cqes[head & cqMask];
+        __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+private:
+    int ringFd;
+    void* sqRing;
+    void* cqRing;
+    void* sqeMap;
+    size_t sqRingSize;
+    size_t cqRingSize;
+    size_t sqeMapSize;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    io_uring_sqe* sqes = nullptr;
+
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    unsigned localTail;
+    unsigned toSubmit;
+};
+
+// ---------------------------------------------------------------------------
+// io_uring backend: queueDepth registered buffers, one fixed read/write each
+// ---------------------------------------------------------------------------
+class UringBackend : public IoBackend {
+public:
+    UringBackend(size_t blockSize, unsigned queueDepth)
+        : blockSize(blockSize), fd(-1), offset(0), active(0), failed(false) {
+        slots.resize(queueDepth);
+    }
+
+    ~UringBackend() override {
+        close();
+        for (Slot& slot : slots) {
+            std::free(slot.buffer);
+        }
+    }
+
+    // Set up the ring and register one aligned buffer per slot
+    bool init() {
+        if (!ring.init(static_cast<unsigned>(slots.size()))) {
+            return false;
+        }
+        std::vector<iovec> iov;
+        for (Slot& slot : slots) {
+            if (posix_memalign(reinterpret_cast<void**>(&slot.buffer), 4096, blockSize) != 0) {
+                slot.buffer = nullptr;
+                return false;
+            }
+            iov.push_back({slot.buffer, blockSize});
+        }
+        // Fails e.g. when RLIMIT_MEMLOCK is too small; the caller falls back to pread
+        return ring.registerBuffers(iov);
+    }
+
+    const char* name() const override { return "io_uring"; }
+
+    bool openRead(const std::string& filename, uint64_t& size) override {
+        fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close();
+            return false;
+        }
+        size = static_cast<uint64_t>(st.st_size);
+        return true;
+    }
+
+    bool readBlocks(uint64_t size, const std::function<bool(const char*, size_t)>& consumer) override {
+        const size_t depth = slots.size();
+        const uint64_t blocks = (size + blockSize - 1) / blockSize;
+        uint64_t nextBlock = 0;
+        failed = false;
+
+        // Prime the queue
+        for (size_t s = 0; s < depth && nextBlock < blocks; ++s, ++nextBlock) {
+            startTransfer(s, nextBlock * blockSize,
+                          static_cast<size_t>(std::min<uint64_t>(blockSize, size - nextBlock * blockSize)),
+                          IORING_OP_READ_FIXED);
+        }
+        if (!ring.submit(0)) {
+            return false;
+        }
+
+        bool keepGoing = true;
+        for (uint64_t block = 0; block < blocks && keepGoing; ++block) {
+            Slot& slot = slots[block % depth];
+            if (!waitFor(slot) || failed) {
+                drain();
+                return false;
+            }
+            if (slot.filled == 0) {
+                break;  // file shrank underneath us
+            }
+            keepGoing = consumer(slot.buffer, slot.filled);
+
+            // Reuse the slot for the next block in file order
+            if (keepGoing && nextBlock < blocks) {
+                startTransfer(block % depth, nextBlock * blockSize,
+                              static_cast<size_t>(std::min<uint64_t>(blockSize, size - nextBlock * blockSize)),
+                              IORING_OP_READ_FIXED);
+                ++nextBlock;
+                if (!ring.submit(0)) {
+                    failed = true;
+                }
+            }
+        }
+
+        drain();
+        return !failed;
+    }
+
+    bool openWrite(const std::string& filename) override {
+        fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        offset = 0;
+        active = 0;
+        failed = false;
+        writing = true;
+        for (Slot& slot : slots) {
+            slot.filled = 0;
+        }
+        return fd >= 0;
+    }
+
+    bool write(const char* data, size_t length) override {
+        while (length > 0 && !failed) {
+            Slot& slot = slots[active];
+            size_t room = blockSize - slot.filled;
+            size_t n = std::min(room, length);
+            std::memcpy(slot.buffer + slot.filled, data, n);
+            slot.filled += n;
+            data += n;
+            length -= n;
+            if (slot.filled == blockSize) {
+                submitActive();
+            }
+        }
+        return !failed;
+    }
+
+    bool close() override {
+        if (fd < 0) {
+            return true;
+        }
+        if (writing && slots[active].filled > 0) {
+            submitActive();
+        }
+        drain();
+        ::close(fd);
+        fd = -1;
+        writing = false;
+        return !failed;
+    }
+
+    bool isOpen() const override { return fd >= 0; }
+
+private:
+    struct Slot {
+        char* buffer = nullptr;
+        uint64_t offset = 0;   // file offset of the block
+        size_t length = 0;     // bytes to transfer
+        size_t filled = 0;     // bytes staged (write) or transferred (read)
+        size_t done = 0;       // bytes completed for an in-flight write
+        uint8_t opcode = 0;
+        bool inFlight = false;
+    };
+
+    void startTransfer(size_t index, uint64_t fileOffset, size_t length, uint8_t opcode) {
+        Slot& slot = slots[index];
+        slot.offset = fileOffset;
+        slot.length = length;
+        slot.filled = 0;
+        slot.done = 0;
+        slot.opcode = opcode;
+        slot.inFlight = true;
+        queue(index);
+    }
+
+    // Queue (the remainder of) a slot's transfer
+    void queue(size_t index) {
+        Slot& slot = slots[index];
+        io_uring_sqe* sqe = ring.nextSqe();
+        while (sqe == nullptr) {
+            // Cannot happen with one entry per slot, but never spin silently
+            ring.submit(0);
+            sqe = ring.nextSqe();
+        }
+        size_t progress = slot.opcode == IORING_OP_READ_FIXED ? slot.filled : slot.done;
+        sqe->opcode = slot.opcode;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<uint64_t>(slot.buffer + progress);
+        sqe->len = static_cast<uint32_t>(slot.length - progress);
+        sqe->off = slot.offset + progress;
+        sqe->buf_index = static_cast<uint16_t>(index);
+        sqe->user_data = index;
+    }
+
+    void submitActive() {
+        Slot& slot = slots[active];
+        size_t staged = slot.filled;
+        slot.offset = offset;
+        slot.length = staged;
+        slot.done = 0;
+        slot.opcode = IORING_OP_WRITE_FIXED;
+        slot.inFlight = true;
+        queue(active);
+        offset += staged;
+        if (!ring.submit(0)) {
+            failed = true;
+        }
+        active = (active + 1) % slots.size();
+        if (!waitFor(slots[active])) {
+            failed = true;
+        }
+        slots[active].filled = 0;
+    }
+
+    // Reap completions until the slot is idle
+    bool waitFor(Slot& slot) {
+        while (slot.inFlight) {
+            if (!ring.submit(1)) {
+                return false;
+            }
+            io_uring_cqe cqe;
+            while (ring.popCqe(cqe)) {
+                complete(cqe);
+            }
+        }
+        return true;
+    }
+
+    void complete(const io_uring_cqe& cqe) {
+        size_t index = static_cast<size_t>(cqe.user_data);
+        Slot& slot = slots[index];
+        if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+            queue(index);
+            ring.submit(0);
+            return;
+        }
+        if (cqe.res < 0) {
+            failed = true;
+            slot.inFlight = false;
+            return;
+        }
+
+        size_t& progress = slot.opcode == IORING_OP_READ_FIXED ? slot.filled : slot.done;
+        progress += static_cast<size_t>(cqe.res);
+        if (cqe.res == 0 || progress >= slot.length) {
+            if (cqe.res == 0 && slot.opcode == IORING_OP_WRITE_FIXED) {
+                failed = true;
+            }
+            slot.inFlight = false;
+        } else {
+            queue(index);  // short transfer, continue where it stopped
+            ring.submit(0);
+        }
+    }
+
+    void drain() {
+        for (Slot& slot : slots) {
+            if (!waitFor(slot)) {
+                failed = true;
+                slot.inFlight = false;
+            }
+        }
+    }
+
+    size_t blockSize;
+    int fd;
+    uint64_t offset;
+    size_t active;
+    bool failed;
+    bool writing = false;
+    UringQueue ring;
+    std::vector<Slot> slots;
+};
+#endif // CPUPERF_HAVE_IO_URING
+
+// Pick the best backend available on this host
+std::unique_ptr<IoBackend> makeBackend(size_t blockSize, unsigned queueDepth) {
+    const char* forced = std::getenv("CPUPERF_IO_BACKEND");
+    std::string preference = forced ? forced : "";
+
+#ifdef CPUPERF_HAVE_IO_URING
+    if (preference.empty() || preference == "io_uring") {
+        std::unique_ptr<UringBackend> uring(new UringBackend(blockSize, queueDepth));
+        if (uring->init()) {
+            return uring;
+        }
+    }
+#endif
+#ifdef CPUPERF_HAVE_PREAD
+    if (preference != "stream") {
+        return std::unique_ptr<IoBackend>(new PreadBackend(blockSize));
+    }
+#endif
+    (void)queueDepth;
+    return std::unique_ptr<IoBackend>(new StreamBackend(blockSize));
+}
+
+} // namespace
+
+// ============================================================================
+// FileReader
+// ============================================================================
+
+// Constructor
+FileReader::FileReader(size_t blockSize, unsigned queueDepth)
+    : blockSize(blockSize), queueDepth(queueDepth), size(0) {
+    if (blockSize == 0 || queueDepth == 0) {
+        throw std::invalid_argument("Block size and queue depth must be positive");
+    }
+}
+
+// Destructor
+FileReader::~FileReader() {
+    close();
+}
+
+// Open file for reading
+bool FileReader::open(const std::string& filename) {
+    close();
+    backend = makeBackend(blockSize, queueDepth);
+    if (!backend->openRead(filename, size)) {
+        backend.reset();
+        size = 0;
+        return false;
+    }
+    return true;
+}
+
+// Close file
+void FileReader::close() {
+    if (backend) {
+        backend->close();
+        backend.reset();
+    }
+}
+
+bool FileReader::isOpen() const {
+    return backend && backend->isOpen();
+}
+
+std::string FileReader::backendName() const {
+    return backend ? backend->name() : "none";
+}
+
+// Stream blocks to the consumer in file order
+bool FileReader::readBlocks(const std::function<bool(const char*, size_t)>& consumer) {
+    if (!isOpen()) {
+        return false;
+    }
+    return backend->readBlocks(size, consumer);
+}
+
+// Read the whole file into a string
+bool FileReader::readAll(std::string& buffer) {
+    buffer.clear();
+    buffer.reserve(static_cast<size_t>(size));
+    return readBlocks([&buffer](const char* data, size_t length) {
+        buffer.append(data, length);
+        return true;
+    });
+}
+
+// ============================================================================
+// FileWriter
+// ============================================================================
+
+// Constructor
+FileWriter::FileWriter(size_t blockSize, unsigned queueDepth)
+    : blockSize(blockSize), queueDepth(queueDepth) {
+    if (blockSize == 0 || queueDepth == 0) {
+        throw std::invalid_argument("Block size and queue depth must be positive");
+    }
+}
+
+// Destructor
+FileWriter::~FileWriter() {
+    close();
+}
+
+// Create or truncate file
+bool FileWriter::open(const std::string& filename) {
+    close();
+    backend = makeBackend(blockSize, queueDepth);
+    if (!backend->openWrite(filename)) {
+        backend.reset();
+        return false;
+    }
+    return true;
+}
+
+// Append data
+bool FileWriter::write(const char* data, size_t length) {
+    if (!isOpen()) {
+        return false;
+    }
+    return backend->write(data, length);
+}
+
+// Flush and close
+bool FileWriter::close() {
+    if (!backend) {
+        return true;
+    }
+    bool ok = backend->close();
+    backend.reset();
+    return ok;
+}
+
+bool FileWriter::isOpen() const {
+    return backend && backend->isOpen();
+}
+
+std::string FileWriter::backendName() const {
+    return backend ? backend->name() : "none";
+}
@@ -0,0 +1,262 @@
+#include "../include/HugePages.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#define CPUPERF_HAVE_HUGE_PAGES 1
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+using Range = std::pair<uintptr_t, uintptr_t>;
+
+// A live large buffer
+struct Region {
+    size_t bytes;                 // mapped, whole 2 MB pages
+    bool explicitPages;
+    bool measured;                // hugeBytes holds the last coverage() measurement
+    size_t hugeBytes;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::map<uintptr_t, Region> live;
+    HugePages::Coverage released;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+std::atomic<int>& modeFlag() {
+    static std::atomic<int> flag([]() {
+        const char* env = std::getenv("CPUPERF_HUGE_PAGES");
+        if (env != nullptr && std::strcmp(env, "off") == 0) {
+            return static_cast<int>(HugePages::OFF);
+        }
+        if (env != nullptr && std::strcmp(env, "explicit") == 0) {
+            return static_cast<int>(HugePages::EXPLICIT);
+        }
+        return static_cast<int>(HugePages::TRANSPARENT);
+    }());
+    return flag;
+}
+
+size_t roundUp(size_t bytes) {
+    return (bytes + HugePages::PAGE_BYTES - 1) / HugePages::PAGE_BYTES * HugePages::PAGE_BYTES;
+}
+
+// AnonHugePages inside each range, from /proc/self/smaps. A mapping that
+// only partly overlaps a range contributes in proportion to the overlap.
+std::vector<size_t> measureTransparent(const std::vector<Range>& ranges) {
+    std::vector<size_t> huge(ranges.size(), 0);
+    if (ranges.empty()) {
+        return huge;
+    }
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    uintptr_t begin = 0, end = 0;
+    while (std::getline(smaps, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        // Mapping headers start with a lower-case hex range, fields with a name
+        if ((line[0] >= '0' && line[0] <= '9') || (line[0] >= 'a' && line[0] <= 'f')) {
+            char* dash = nullptr;
+            begin = static_cast<uintptr_t>(std::strtoull(line.c_str(), &dash, 16));
+            end = *dash == '-' ? static_cast<uintptr_t>(std::strtoull(dash + 1, nullptr, 16)) : begin;
+            continue;
+        }
+        if (line.compare(0, 14, "AnonHugePages:") != 0 || end <= begin) {
+            continue;
+        }
+        double bytes = std::strtod(line.c_str() + 14, nullptr) * 1024.0;
+        for (size_t r = 0; r < ranges.size(); ++r) {
+            uintptr_t low = std::max(begin, ranges[r].first);
+            uintptr_t high = std::min(end, ranges[r].second);
+            if (high > low) {
+                huge[r] += static_cast<size_t>(bytes * static_cast<double>(high - low) /
+                                               static_cast<double>(end - begin));
+            }
+        }
+    }
+    for (size_t r = 0; r < ranges.size(); ++r) {
+        huge[r] = std::min(huge[r], static_cast<size_t>(ranges[r].second - ranges[r].first));
+    }
+    return huge;
+}
+
+#ifdef CPUPERF_HAVE_HUGE_PAGES
+// 2 MB aligned anonymous mapping of `bytes` (a multiple of PAGE_BYTES)
+void* mapAligned(size_t bytes) {
+    size_t padded = bytes + HugePages::PAGE_BYTES;
+    void* mapping = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+    uintptr_t start = reinterpret_cast<uintptr_t>(mapping);
+    uintptr_t aligned = (start + HugePages::PAGE_BYTES - 1) / HugePages::PAGE_BYTES * HugePages::PAGE_BYTES;
+    if (aligned > start) {
+        munmap(mapping, aligned - start);
+    }
+    size_t tail = start + padded - (aligned + bytes);
+    if (tail > 0) {
+        munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+    }
+    return reinterpret_cast<void*>(aligned);
+}
+#endif
+
+} // namespace
+
+namespace HugePages {
+
+Mode mode() {
+    return static_cast<Mode>(modeFlag().load(std::memory_order_relaxed));
+}
+
+void setMode(Mode value) {
+    modeFlag().store(static_cast<int>(value), std::memory_order_relaxed);
+}
+
+const char* modeName(Mode value) {
+    switch (value) {
+        case OFF: return "off";
+        case EXPLICIT: return "explicit";
+        default: return "transparent";
+    }
+}
+
+void* allocate(size_t bytes) {
+#ifdef CPUPERF_HAVE_HUGE_PAGES
+    if (bytes >= THRESHOLD) {
+        size_t mapped = roundUp(bytes);
+        Mode current = mode();
+        void* pointer = nullptr;
+        bool explicitPages = false;
+        bool fallback = false;
+#ifdef MAP_HUGETLB
+        if (current == EXPLICIT) {
+            void* mapping = mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            explicitPages = mapping != MAP_FAILED;
+            fallback = !explicitPages;
+            pointer = explicitPages ? mapping : nullptr;
+        }
+#endif
+        if (pointer == nullptr) {
+            pointer = mapAligned(mapped);
+            if (pointer == nullptr) {
+                throw std::bad_alloc();
+            }
+            madvise(pointer, mapped, current == OFF ? MADV_NOHUGEPAGE : MADV_HUGEPAGE);
+        }
+
+        Registry& state = registry();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.live[reinterpret_cast<uintptr_t>(pointer)] = Region{mapped, explicitPages, explicitPages,
+                                                                  explicitPages ? mapped : 0};
+        state.released.fallbacks += fallback ? 1 : 0;
+        return pointer;
+    }
+#endif
+    return ::operator new(std::max<size_t>(bytes, 1), std::align_val_t(ALIGNMENT));
+}
+
+void deallocate(void* pointer, size_t bytes) {
+    if (pointer == nullptr) {
+        return;
+    }
+#ifdef CPUPERF_HAVE_HUGE_PAGES
+    if (bytes >= THRESHOLD) {
+        uintptr_t start = reinterpret_cast<uintptr_t>(pointer);
+        Registry& state = registry();
+        Region region{roundUp(bytes), false, false, 0};
+        {
+            // Book the last measurement (if any); smaps is only read by coverage()
+            std::lock_guard<std::mutex> lock(state.mutex);
+            auto found = state.live.find(start);
+            if (found != state.live.end()) {
+                region = found->second;
+                state.live.erase(found);
+            }
+            state.released.allocations += 1;
+            state.released.bytes += region.bytes;
+            state.released.hugeBytes += region.hugeBytes;
+            state.released.explicitBytes += region.explicitPages ? region.bytes : 0;
+            state.released.unmeasuredBytes += region.measured ? 0 : region.bytes;
+        }
+        munmap(pointer, region.bytes);
+        return;
+    }
+#endif
+    (void)bytes;
+    ::operator delete(pointer, std::align_val_t(ALIGNMENT));
+}
+
+Coverage coverage() {
+    Registry& state = registry();
+    Coverage result;
+    std::vector<Range> transparent;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        result = state.released;
+        for (const auto& entry : state.live) {
+            result.allocations += 1;
+            result.bytes += entry.second.bytes;
+            if (entry.second.explicitPages) {
+                result.hugeBytes += entry.second.bytes;
+                result.explicitBytes += entry.second.bytes;
+            } else {
+                transparent.push_back(Range(entry.first, entry.first + entry.second.bytes));
+            }
+        }
+    }
+    std::vector<size_t> huge = measureTransparent(transparent);
+
+    // Keep each measurement for when the buffer is released
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (size_t r = 0; r < transparent.size(); ++r) {
+        result.hugeBytes += huge[r];
+        auto found = state.live.find(transparent[r].first);
+        if (found != state.live.end() && !found->second.explicitPages) {
+            found->second.measured = true;
+            found->second.hugeBytes = huge[r];
+        }
+    }
+    return result;
+}
+
+std::string describe(const Coverage& coverage) {
+    std::ostringstream text;
+    text << modeName(mode()) << ", " << std::fixed << std::setprecision(1)
+         << coverage.hugeBytes / 1048576.0 << " of " << (coverage.bytes - coverage.unmeasuredBytes) / 1048576.0
+         << " MB in "
+         << coverage.allocations << (coverage.allocations == 1 ? " buffer" : " buffers") << " ("
+         << 100.0 * coverage.share() << "%)";
+    if (coverage.explicitBytes > 0) {
+        text << ", " << coverage.explicitBytes / 1048576.0 << " MB explicit";
+    }
+    if (coverage.fallbacks > 0) {
+        text << ", " << coverage.fallbacks << " explicit fallbacks";
+    }
+    if (coverage.unmeasuredBytes > 0) {
+        text << ", " << coverage.unmeasuredBytes / 1048576.0 << " MB released unmeasured";
+    }
+    return text.str();
+}
+
+} // namespace HugePages
@@ -0,0 +1,128 @@
+#include "../include/IterativeSolver.h"
+#include "../include/Parallel.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+double dot(const std::vector<double>& a, const std::vector<double>& b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+// Preconditioned CG on an operator given as apply(p) -> A p
+template <typename Apply>
+ConjugateGradient::Result preconditionedCG(Apply apply, const std::vector<double>& rhs,
+                                           const std::vector<double>& diagonal,
+                                           int maxIterations, double tolerance) {
+    size_t n = rhs.size();
+    ConjugateGradient::Result result;
+    result.solution.assign(n, 0.0);
+
+    // The kernels inside apply() share one set of workers across iterations
+    Parallel::Team team;
+    Parallel::Team::Scope scope(team);
+
+    std::vector<double> inverseDiagonal(n);
+    for (size_t i = 0; i < n; ++i) {
+        inverseDiagonal[i] = diagonal[i] > 0.0 ? 1.0 / diagonal[i] : 1.0;
+    }
+
+    double rhsNorm = std::sqrt(dot(rhs, rhs));
+    if (rhsNorm == 0.0) {
+        result.converged = true;
+        return result;
+    }
+
+    std::vector<double> r = rhs;
+    std::vector<double> z(n), p(n);
+    for (size_t i = 0; i < n; ++i) {
+        z[i] = inverseDiagonal[i] * r[i];
+    }
+    p = z;
+    double rz = dot(r, z);
+
+    for (int iteration = 1; iteration <= maxIterations; ++iteration) {
+        std::vector<double> ap = apply(p);
+        double pAp = dot(p, ap);
+        if (pAp <= 0.0) {
+            throw std::runtime_error("Conjugate gradient requires a positive definite system");
+        }
+
+        double alpha = rz / pAp;
+        for (size_t i = 0; i < n; ++i) {
+            result.solution[i] += alpha * p[i];
+            r[i] -= alpha * ap[i];
+        }
+
+        result.iterations = iteration;
+        result.relativeResidual = std::sqrt(dot(r, r)) / rhsNorm;
+        if (result.relativeResidual <= tolerance) {
+            result.converged = true;
+            break;
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            z[i] = inverseDiagonal[i] * r[i];
+        }
+        double rzNext = dot(r, z);
+        double beta = rzNext / rz;
+        rz = rzNext;
+        for (size_t i = 0; i < n; ++i) {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+// Constructor
+ConjugateGradient::ConjugateGradient(int maxIterations, double tolerance)
+    : maxIterations(maxIterations), tolerance(tolerance) {
+    if (maxIterations <= 0 || tolerance <= 0.0) {
+        throw std::invalid_argument("Iteration limit and tolerance must be positive");
+    }
+}
+
+// Symmetric positive definite system
+ConjugateGradient::Result ConjugateGradient::solve(const SparseMatrix& A,
+                                                   const std::vector<double>& b) const {
+    if (A.getRows() != A.getCols() || b.size() != A.getRows()) {
+        throw std::invalid_argument("Conjugate gradient needs a square matrix matching the right-hand side");
+    }
+
+    std::vector<double> diagonal(A.getRows());
+    for (size_t i = 0; i < diagonal.size(); ++i) {
+        diagonal[i] = A.at(i, i);
+    }
+    return preconditionedCG([&A](const std::vector<double>& p) { return A.multiply(p); },
+                            b, diagonal, maxIterations, tolerance);
+}
+
+// Ridge least squares through the normal-equations operator A^T A + lambda * I
+ConjugateGradient::Result ConjugateGradient::solveLeastSquares(const SparseMatrix& A,
+                                                               const std::vector<double>& b,
+                                                               double lambda) const {
+    if (b.size() != A.getRows()) {
+        throw std::invalid_argument("Target size does not match design matrix rows");
+    }
+
+    std::vector<double> diagonal = A.columnSquaredNorms();
+    for (double& d : diagonal) {
+        d += lambda;
+    }
+    std::vector<double> rhs = A.transposeMultiply(b);
+
+    auto apply = [&A, lambda](const std::vector<double>& p) {
+        std::vector<double> result = A.transposeMultiply(A.multiply(p));
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] += lambda * p[i];
+        }
+        return result;
+    };
+    return preconditionedCG(apply, rhs, diagonal, maxIterations, tolerance);
+}
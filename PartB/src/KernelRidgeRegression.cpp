@@ -0,0 +1,345 @@
+#include "../include/KernelRidgeRegression.h"
+#include "../include/LUDecomposition.h"
+#include "../include/FileIO.h"
+#include "../include/Parallel.h"
+#include "../include/Summation.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+
+// Gram row pairs per parallel block
+const size_t GRAM_GRAIN = 8;
+const char* MODEL_HEADER = "cpuperf-rff-ridge 1";
+
+} // namespace
+
+// Constructor
+KernelRidgeRegression::KernelRidgeRegression(size_t frequencies, double lambda,
+                                             double gamma, uint64_t seed)
+    : frequencies(frequencies), lambda(lambda), gamma(gamma), seed(seed),
+      intercept(0.0), trainRMSE(0.0), isTrained(false) {
+    if (frequencies == 0) {
+        throw std::invalid_argument("Kernel ridge needs at least one random feature");
+    }
+    if (lambda < 0.0 || gamma < 0.0) {
+        throw std::invalid_argument("Regularization and gamma must not be negative");
+    }
+}
+
+// Standardize a block of rows into a contiguous row-major buffer
+void KernelRidgeRegression::standardize(ConstMatrixView X, size_t begin, size_t end,
+                                        std::vector<double>& batch) const {
+    size_t d = mean.size();
+    batch.resize((end - begin) * d);
+    for (size_t i = begin; i < end; ++i) {
+        double* out = batch.data() + (i - begin) * d;
+        for (size_t j = 0; j < d; ++j) {
+            out[j] = (X(i, j) - mean[j]) / scale[j];
+        }
+    }
+}
+
+// Train on the dataset's features and PRP
+bool KernelRidgeRegression::fit(const Dataset& trainData) {
+    if (trainData.empty()) {
+        std::cerr << "Error: Training dataset is empty" << std::endl;
+        return false;
+    }
+
+    Matrix X(trainData.size(), 6);
+    std::vector<double> y(trainData.size());
+    for (size_t i = 0; i < trainData.size(); ++i) {
+        X[i] = trainData[i].getFeatureVector();
+        y[i] = trainData[i].getTarget();
+    }
+    return fit(X, y);
+}
+
+// Batched fit: accumulate Z^T Z and Z^T y one batch of mapped rows at a time
+bool KernelRidgeRegression::fit(ConstMatrixView X, const std::vector<double>& y) {
+    size_t n = X.getRows();
+    size_t d = X.getCols();
+
+    if (n == 0 || d == 0) {
+        std::cerr << "Error: Training data is empty" << std::endl;
+        return false;
+    }
+    if (y.size() != n) {
+        std::cerr << "Error: Design matrix and targets do not match" << std::endl;
+        return false;
+    }
+
+    try {
+        // Standardization and target centering
+        mean.assign(d, 0.0);
+        scale.assign(d, 0.0);
+        intercept = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < d; ++j) {
+                mean[j] += X(i, j);
+            }
+            intercept += y[i];
+        }
+        for (size_t j = 0; j < d; ++j) {
+            mean[j] /= n;
+        }
+        intercept /= n;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < d; ++j) {
+                double centered = X(i, j) - mean[j];
+                scale[j] += centered * centered;
+            }
+        }
+        for (size_t j = 0; j < d; ++j) {
+            scale[j] = std::sqrt(scale[j] / n);
+            if (scale[j] == 0.0) {
+                scale[j] = 1.0;
+            }
+        }
+
+        featureMap = RandomFourierFeatures(d, frequencies, gamma > 0.0 ? gamma : 1.0 / d, seed);
+        size_t outputs = featureMap.getOutputs();
+
+        // Each batch's Z^T Z and Z^T y entries are compensated dot products,
+        // folded into running compensated sums so the error does not grow
+        // with the batch count (as in NormalEquations::addColumns)
+        std::vector<Summation::KahanBabuska> gramSums(outputs * outputs);
+        std::vector<Summation::KahanBabuska> ztySums(outputs);
+        std::vector<double> batch, mapped, centered;
+
+        for (size_t begin = 0; begin < n; begin += BATCH_ROWS) {
+            size_t end = std::min(n, begin + BATCH_ROWS);
+            size_t rows = end - begin;
+            standardize(X, begin, end, batch);
+            featureMap.transform(batch.data(), rows, mapped);
+            centered.resize(rows);
+            for (size_t i = 0; i < rows; ++i) {
+                centered[i] = y[begin + i] - intercept;
+            }
+
+            // Rows j and outputs-1-j are paired so every block gets the same
+            // share of the upper triangle
+            Parallel::parallelFor((outputs + 1) / 2, GRAM_GRAIN, [&](size_t, size_t pairBegin, size_t pairEnd) {
+                for (size_t pair = pairBegin; pair < pairEnd; ++pair) {
+                    size_t rowsOfPair[2] = {pair, outputs - 1 - pair};
+                    for (size_t r = 0; r < (rowsOfPair[0] == rowsOfPair[1] ? 1u : 2u); ++r) {
+                        size_t j = rowsOfPair[r];
+                        const double* zj = mapped.data() + j * rows;
+                        Summation::KahanBabuska* gramRow = gramSums.data() + j * outputs;
+                        for (size_t l = j; l < outputs; ++l) {
+                            gramRow[l].add(Summation::dot(zj, mapped.data() + l * rows, rows));
+                        }
+                        ztySums[j].add(Summation::dot(zj, centered.data(), rows));
+                    }
+                }
+            });
+        }
+
+        Matrix gram(outputs, outputs);
+        std::vector<double> zty(outputs);
+        for (size_t j = 0; j < outputs; ++j) {
+            for (size_t l = j; l < outputs; ++l) {
+                gram[j][l] = gram[l][j] = gramSums[j * outputs + l].value();
+            }
+            gram[j][j] += lambda;
+            zty[j] = ztySums[j].value();
+        }
+
+        weights = gram.lu().solve(zty);
+        isTrained = true;
+
+        std::vector<double> fitted = predict(X);
+        trainRMSE = std::sqrt(Summation::squaredDifferences(fitted.data(), y.data(), n) / n);
+        return true;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error during kernel ridge training: " << e.what() << std::endl;
+        isTrained = false;
+        return false;
+    }
+}
+
+// Batched predict: map a batch, then one axpy per feature column
+std::vector<double> KernelRidgeRegression::predict(ConstMatrixView X) const {
+    if (!isTrained) {
+        throw std::runtime_error("Model has not been trained yet");
+    }
+    if (X.getCols() != mean.size()) {
+        throw std::invalid_argument("Design matrix column count does not match the model");
+    }
+
+    size_t n = X.getRows();
+    std::vector<double> result(n, intercept);
+    std::vector<double> batch, mapped;
+    for (size_t begin = 0; begin < n; begin += BATCH_ROWS) {
+        size_t end = std::min(n, begin + BATCH_ROWS);
+        size_t rows = end - begin;
+        standardize(X, begin, end, batch);
+        featureMap.transform(batch.data(), rows, mapped);
+
+        double* out = result.data() + begin;
+        for (size_t c = 0; c < weights.size(); ++c) {
+            const double* column = mapped.data() + c * rows;
+            double w = weights[c];
+            for (size_t i = 0; i < rows; ++i) {
+                out[i] += w * column[i];
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<double> KernelRidgeRegression::predict(const Dataset& data) const {
+    Matrix X(data.size(), mean.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        X[i] = data[i].getFeatureVector();
+    }
+    return predict(X);
+}
+
+double KernelRidgeRegression::predict(const DataPoint& point) const {
+    Matrix X(1, mean.size());
+    X[0] = point.getFeatureVector();
+    return predict(X)[0];
+}
+
+// Root mean squared error on PRP
+double KernelRidgeRegression::calculateRMSE(const Dataset& data) const {
+    if (data.empty()) {
+        return 0.0;
+    }
+    std::vector<double> predictions = predict(data);
+    std::vector<double> targets(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        targets[i] = data[i].getTarget();
+    }
+    return std::sqrt(Summation::squaredDifferences(predictions.data(), targets.data(), data.size()) / data.size());
+}
+
+// Save the model; the frequency matrix is rebuilt from the seed on load
+bool KernelRidgeRegression::save(const std::string& filename) const {
+    if (!isTrained) {
+        std::cerr << "Error: Model has not been trained yet" << std::endl;
+        return false;
+    }
+
+    std::ostringstream text;
+    char number[32];
+    auto put = [&](double value) {
+        std::snprintf(number, sizeof(number), " %.17g", value);
+        text << number;
+    };
+
+    text << MODEL_HEADER << "\n";
+    text << "inputs " << mean.size() << "\n";
+    text << "frequencies " << frequencies << "\n";
+    text << "seed " << seed << "\n";
+    text << "gamma";
+    put(featureMap.getGamma());
+    text << "\nlambda";
+    put(lambda);
+    text << "\nintercept";
+    put(intercept);
+    text << "\nmean";
+    for (double value : mean) {
+        put(value);
+    }
+    text << "\nscale";
+    for (double value : scale) {
+        put(value);
+    }
+    text << "\nweights";
+    for (double value : weights) {
+        put(value);
+    }
+    text << "\n";
+
+    FileWriter writer;
+    if (!writer.open(filename) || !writer.write(text.str()) || !writer.close()) {
+        std::cerr << "Error: Could not write model file " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Load a model written by save()
+bool KernelRidgeRegression::load(const std::string& filename) {
+    FileReader reader;
+    std::string buffer;
+    if (!reader.open(filename) || !reader.readAll(buffer)) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+
+    std::istringstream text(buffer);
+    std::string header, version, key;
+    size_t inputs = 0, loadedFrequencies = 0;
+    uint64_t loadedSeed = 0;
+    double loadedGamma = 0.0, loadedLambda = 0.0, loadedIntercept = 0.0;
+
+    text >> header >> version;
+    if (header + " " + version != MODEL_HEADER) {
+        std::cerr << "Error: " << filename << " is not a kernel ridge model" << std::endl;
+        return false;
+    }
+    text >> key >> inputs >> key >> loadedFrequencies >> key >> loadedSeed
+         >> key >> loadedGamma >> key >> loadedLambda >> key >> loadedIntercept;
+    if (!text || inputs == 0 || loadedFrequencies == 0 || loadedGamma <= 0.0) {
+        std::cerr << "Error: Malformed model header in " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<double> loadedMean(inputs), loadedScale(inputs), loadedWeights(2 * loadedFrequencies);
+    text >> key;
+    for (double& value : loadedMean) {
+        text >> value;
+    }
+    text >> key;
+    for (double& value : loadedScale) {
+        text >> value;
+    }
+    text >> key;
+    for (double& value : loadedWeights) {
+        text >> value;
+    }
+    if (!text) {
+        std::cerr << "Error: Truncated model file " << filename << std::endl;
+        return false;
+    }
+
+    frequencies = loadedFrequencies;
+    seed = loadedSeed;
+    gamma = loadedGamma;
+    lambda = loadedLambda;
+    intercept = loadedIntercept;
+    mean = std::move(loadedMean);
+    scale = std::move(loadedScale);
+    weights = std::move(loadedWeights);
+    featureMap = RandomFourierFeatures(inputs, frequencies, gamma, seed);
+    trainRMSE = 0.0;
+    isTrained = true;
+    return true;
+}
+
+// Display model information
+void KernelRidgeRegression::displayModel() const {
+    std::cout << "\n=== Kernel Ridge Regression (Random Fourier Features) ===" << std::endl;
+
+    if (!isTrained) {
+        std::cout << "Model has not been trained yet." << std::endl;
+        return;
+    }
+
+    std::cout << "Random features: " << frequencies << " frequencies ("
+              << featureMap.getOutputs() << " sin/cos columns)" << std::endl;
+    std::cout << "RBF gamma: " << std::setprecision(6) << featureMap.getGamma() << std::endl;
+    std::cout << "Lambda: " << lambda << std::endl;
+    std::cout << "Map seed: " << seed << std::endl;
+    std::cout << "Intercept: " << std::fixed << std::setprecision(4) << intercept << std::endl;
+    std::cout << "Training RMSE: " << trainRMSE << std::endl;
+}
@@ -0,0 +1,208 @@
+#include "../include/LUDecomposition.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// Factor a square matrix
+LUDecomposition::LUDecomposition(ConstMatrixView matrix)
+    : n(matrix.getRows()), factors(n * n), permutation(n), swapSign(1), singular(false) {
+    if (matrix.getRows() != matrix.getCols()) {
+        throw std::invalid_argument("Matrix must be square for LU decomposition");
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            factors[i * n + j] = matrix(i, j);
+        }
+        permutation[i] = i;
+    }
+    factorize();
+}
+
+// Blocked right-looking elimination with partial pivoting
+void LUDecomposition::factorize() {
+    const double EPSILON = 1e-10;
+    double* a = factors.data();
+
+    for (size_t k0 = 0; k0 < n; k0 += BLOCK_SIZE) {
+        size_t k1 = std::min(n, k0 + BLOCK_SIZE);
+
+        // Panel: unblocked elimination of columns k0..k1 (rows k0..n)
+        for (size_t k = k0; k < k1; ++k) {
+            size_t maxRow = k;
+            for (size_t i = k + 1; i < n; ++i) {
+                if (std::abs(a[i * n + k]) > std::abs(a[maxRow * n + k])) {
+                    maxRow = i;
+                }
+            }
+            if (std::abs(a[maxRow * n + k]) < EPSILON) {
+                singular = true;
+                return;
+            }
+            if (maxRow != k) {
+                std::swap_ranges(a + k * n, a + (k + 1) * n, a + maxRow * n);
+                std::swap(permutation[k], permutation[maxRow]);
+                swapSign = -swapSign;
+            }
+
+            double inversePivot = 1.0 / a[k * n + k];
+            for (size_t i = k + 1; i < n; ++i) {
+                double l = (a[i * n + k] *= inversePivot);
+                for (size_t j = k + 1; j < k1; ++j) {
+                    a[i * n + j] -= l * a[k * n + j];
+                }
+            }
+        }
+
+        if (k1 == n) {
+            break;
+        }
+
+        // U12 = L11^(-1) * A12 for the block row
+        for (size_t k = k0; k < k1; ++k) {
+            for (size_t i = k + 1; i < k1; ++i) {
+                double l = a[i * n + k];
+                for (size_t j = k1; j < n; ++j) {
+                    a[i * n + j] -= l * a[k * n + j];
+                }
+            }
+        }
+
+        // Trailing update A22 -= L21 * U12
+        for (size_t i = k1; i < n; ++i) {
+            double* rowI = a + i * n;
+            for (size_t k = k0; k < k1; ++k) {
+                double l = rowI[k];
+                const double* rowK = a + k * n;
+                for (size_t j = k1; j < n; ++j) {
+                    rowI[j] -= l * rowK[j];
+                }
+            }
+        }
+    }
+}
+
+void LUDecomposition::requireNonSingular() const {
+    if (singular) {
+        throw std::runtime_error("Matrix is singular and cannot be inverted");
+    }
+}
+
+// Solve A x = b
+std::vector<double> LUDecomposition::solve(const std::vector<double>& b) const {
+    if (b.size() != n) {
+        throw std::invalid_argument("Right-hand side size does not match matrix size");
+    }
+    requireNonSingular();
+
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) {
+        double sum = b[permutation[i]];
+        for (size_t k = 0; k < i; ++k) {
+            sum -= factors[i * n + k] * x[k];
+        }
+        x[i] = sum;
+    }
+    for (size_t i = n; i-- > 0;) {
+        double sum = x[i];
+        for (size_t k = i + 1; k < n; ++k) {
+            sum -= factors[i * n + k] * x[k];
+        }
+        x[i] = sum / factors[i * n + i];
+    }
+    return x;
+}
+
+// Solve A X = B; the substitutions sweep whole rows of X so every
+// right-hand side advances together
+Matrix LUDecomposition::solveMany(ConstMatrixView B) const {
+    if (B.getRows() != n) {
+        throw std::invalid_argument("Right-hand side rows do not match matrix size");
+    }
+    requireNonSingular();
+
+    size_t m = B.getCols();
+    std::vector<double> x(n * m);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            x[i * m + j] = B(permutation[i], j);
+        }
+    }
+
+    // Forward substitution with unit-diagonal L
+    for (size_t i = 0; i < n; ++i) {
+        double* xi = x.data() + i * m;
+        for (size_t k = 0; k < i; ++k) {
+            double l = factors[i * n + k];
+            const double* xk = x.data() + k * m;
+            for (size_t j = 0; j < m; ++j) {
+                xi[j] -= l * xk[j];
+            }
+        }
+    }
+
+    // Back substitution with U
+    for (size_t i = n; i-- > 0;) {
+        double* xi = x.data() + i * m;
+        for (size_t k = i + 1; k < n; ++k) {
+            double u = factors[i * n + k];
+            const double* xk = x.data() + k * m;
+            for (size_t j = 0; j < m; ++j) {
+                xi[j] -= u * xk[j];
+            }
+        }
+        double inverseDiagonal = 1.0 / factors[i * n + i];
+        for (size_t j = 0; j < m; ++j) {
+            xi[j] *= inverseDiagonal;
+        }
+    }
+
+    Matrix result(n, m);
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<double>& row = result[i];
+        std::copy(x.begin() + i * m, x.begin() + (i + 1) * m, row.begin());
+    }
+    return result;
+}
+
+// Product of the pivots, signed by the row swaps
+double LUDecomposition::determinant() const {
+    if (singular) {
+        return 0.0;
+    }
+    double det = swapSign;
+    for (size_t i = 0; i < n; ++i) {
+        det *= factors[i * n + i];
+    }
+    return det;
+}
+
+// Sum of log|pivot|; does not overflow for large or badly scaled matrices
+double LUDecomposition::logDeterminant() const {
+    if (singular) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    double logDet = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        logDet += std::log(std::abs(factors[i * n + i]));
+    }
+    return logDet;
+}
+
+int LUDecomposition::determinantSign() const {
+    if (singular) {
+        return 0;
+    }
+    int sign = swapSign;
+    for (size_t i = 0; i < n; ++i) {
+        if (factors[i * n + i] < 0.0) {
+            sign = -sign;
+        }
+    }
+    return sign;
+}
+
+// Inverse by solving against the identity
+Matrix LUDecomposition::inverse() const {
+    return solveMany(Matrix::identity(n));
+}
@@ -1,19 +1,93 @@
 #include "../include/LinearRegression.h"
+#include "../include/LUDecomposition.h"
+#include "../include/Parallel.h"
+#include "../include/FileIO.h"
+#include "../include/HugePages.h"
+#include "../include/Summation.h"
+#include "../include/IterativeSolver.h"
 #include <iostream>
 #include <iomanip>
 #include <cmath>
 #include <algorithm>
 #include <numeric>
+#include <sstream>
+#include <cstdio>
+#include <cctype>
+#include <stdexcept>
+
+namespace {
+
+// Rows per triangular solve in predictIntervals(), and rows per parallel block
+const size_t INTERVAL_BATCH = 256;
+const size_t INTERVAL_GRAIN = 4096;
+
+// First line of a saved model file
+const char* MODEL_HEADER = "cpuperf-linear 1";
+
+// Widest sparse design trainSparse() solves through the dense Gram matrix;
+// wider ones go to conjugate gradient
+const size_t DIRECT_SPARSE_FEATURES = 256;
+const int SPARSE_CG_ITERATIONS = 5000;
+const double SPARSE_CG_TOLERANCE = 1e-10;
+
+// Column names: the hardware schema first, then X7, X8, ... for extra columns
+std::vector<std::string> featureNamesFor(size_t count) {
+    std::vector<std::string> names = {"MYCT", "MMIN", "MMAX", "CACH", "CHMIN", "CHMAX"};
+    names.resize(count);
+    for (size_t j = 6; j < count; ++j) {
+        names[j] = "X" + std::to_string(j + 1);
+    }
+    return names;
+}
+
+// Standard normal quantile (Acklam's rational approximation, ~1e-9 relative error)
+double normalQuantile(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    const double low = 0.02425;
+
+    if (p < low) {
+        double q = std::sqrt(-2.0 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    if (p > 1.0 - low) {
+        double q = std::sqrt(-2.0 * std::log(1.0 - p));
+        return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+} // namespace
 
 // Constructor
 LinearRegression::LinearRegression() 
-    : coefficients(6, 0.0), isTrained(false), trainRMSE(0.0), testRMSE(0.0), rSquared(0.0) {}
+    : coefficients(6, 0.0), isTrained(false), trainRMSE(0.0), testRMSE(0.0), rSquared(0.0),
+      residualVariance(0.0), degreesOfFreedom(0.0), hasInference(false), quiet(false) {}
+
+// Record an error for getLastError() and print it unless quiet
+bool LinearRegression::fail(const std::string& message) const {
+    lastError = message;
+    if (!quiet) {
+        std::cerr << "Error: " << message << std::endl;
+    }
+    return false;
+}
 
 // Train the model using normal equation
 bool LinearRegression::train(const Dataset& trainData) {
     if (trainData.empty()) {
-        std::cerr << "Error: Training dataset is empty" << std::endl;
-        return false;
+        return fail("Training dataset is empty");
     }
 
     try {
@@ -27,17 +101,20 @@ bool LinearRegression::train(const Dataset& trainData) {
             y(i, 0) = y_vec[i];
         }
 
-        std::cout << "Design matrix X dimensions: " << X.getRows() << "x" << X.getCols() << std::endl;
-        std::cout << "Target vector y dimensions: " << y.getRows() << "x" << y.getCols() << std::endl;
+        if (!quiet) {
+            std::cout << "Design matrix X dimensions: " << X.getRows() << "x" << X.getCols() << std::endl;
+            std::cout << "Target vector y dimensions: " << y.getRows() << "x" << y.getCols() << std::endl;
+        }
 
-        // Normal equation: theta = (X^T * X)^(-1) * X^T * y
-        Matrix Xt = X.transpose();
-        Matrix XtX = Xt * X;
+        // Normal equation: (X^T * X) * theta = X^T * y, solved from the LU factors;
+        // X^T is never materialized
+        Matrix XtX = X.transposed() * X;
         
-        std::cout << "Computing matrix inverse..." << std::endl;
-        Matrix XtX_inv = XtX.inverse();
-        Matrix Xty = Xt * y;
-        Matrix theta = XtX_inv * Xty;
+        if (!quiet) {
+            std::cout << "Computing LU factorization..." << std::endl;
+        }
+        Matrix Xty = X.transposed() * y;
+        Matrix theta = XtX.lu().solveMany(Xty);
 
         // Extract coefficients
         coefficients.clear();
@@ -46,27 +123,29 @@ bool LinearRegression::train(const Dataset& trainData) {
             coefficients[i] = theta(i, 0);
         }
 
+        scorer = ScoringKernel(coefficients);
         isTrained = true;
         
         // Calculate training RMSE
         trainRMSE = calculateRMSE(trainData);
+        computeInference(XtX, trainRMSE * trainRMSE * X.getRows(), static_cast<double>(X.getRows()));
         
-        std::cout << "Model training completed successfully!" << std::endl;
-        std::cout << "Training RMSE: " << trainRMSE << std::endl;
+        if (!quiet) {
+            std::cout << "Model training completed successfully!" << std::endl;
+            std::cout << "Training RMSE: " << trainRMSE << std::endl;
+        }
         
         return true;
     }
     catch (const std::exception& e) {
-        std::cerr << "Error during training: " << e.what() << std::endl;
-        return false;
+        return fail(std::string("Training failed: ") + e.what());
     }
 }
 
 // Train with regularization (Ridge regression)
 bool LinearRegression::trainWithRegularization(const Dataset& trainData, double lambda) {
     if (trainData.empty()) {
-        std::cerr << "Error: Training dataset is empty" << std::endl;
-        return false;
+        return fail("Training dataset is empty");
     }
 
     try {
@@ -79,15 +158,13 @@ bool LinearRegression::trainWithRegularization(const Dataset& trainData, double
             y(i, 0) = y_vec[i];
         }
 
-        // Ridge regression: theta = (X^T * X + lambda * I)^(-1) * X^T * y
-        Matrix Xt = X.transpose();
-        Matrix XtX = Xt * X;
+        // Ridge regression: (X^T * X + lambda * I) * theta = X^T * y
+        Matrix XtX = X.transposed() * X;
         Matrix I = Matrix::identity(XtX.getRows());
         Matrix regularized = XtX + I * lambda;
         
-        Matrix regularized_inv = regularized.inverse();
-        Matrix Xty = Xt * y;
-        Matrix theta = regularized_inv * Xty;
+        Matrix Xty = X.transposed() * y;
+        Matrix theta = regularized.lu().solveMany(Xty);
 
         // Extract coefficients
         coefficients.clear();
@@ -96,17 +173,94 @@ bool LinearRegression::trainWithRegularization(const Dataset& trainData, double
             coefficients[i] = theta(i, 0);
         }
 
+        scorer = ScoringKernel(coefficients);
         isTrained = true;
         trainRMSE = calculateRMSE(trainData);
+        clearInference();
         
-        std::cout << "Ridge regression training completed successfully!" << std::endl;
-        std::cout << "Lambda: " << lambda << ", Training RMSE: " << trainRMSE << std::endl;
+        if (!quiet) {
+            std::cout << "Ridge regression training completed successfully!" << std::endl;
+            std::cout << "Lambda: " << lambda << ", Training RMSE: " << trainRMSE << std::endl;
+        }
         
         return true;
     }
     catch (const std::exception& e) {
-        std::cerr << "Error during ridge regression training: " << e.what() << std::endl;
-        return false;
+        return fail(std::string("Ridge regression training failed: ") + e.what());
+    }
+}
+
+// Train from accumulated X^T X and X^T y
+bool LinearRegression::trainFromNormalEquations(const NormalEquations& equations, double lambda) {
+    if (equations.getCount() <= 0.0) {
+        return fail("No training rows accumulated");
+    }
+    if (equations.getFeatures() != 6) {
+        return fail("Expected statistics over 6 features");
+    }
+
+    try {
+        coefficients = equations.solve(lambda);
+        scorer = ScoringKernel(coefficients);
+        isTrained = true;
+        double rss = equations.residualSumSquares(coefficients);
+        trainRMSE = std::sqrt(rss / equations.getCount());
+        if (lambda == 0.0) {
+            computeInference(equations.getGram(), rss, equations.getCount());
+        } else {
+            clearInference();
+        }
+        return true;
+    }
+    catch (const std::exception& e) {
+        return fail(std::string("Training failed: ") + e.what());
+    }
+}
+
+// Train from a sparse design of any width. Up to DIRECT_SPARSE_FEATURES
+// columns: X^T X from the sparse Gram kernel and an LU solve, with standard
+// errors when unregularized. Wider designs never form X^T X; conjugate
+// gradient applies X and X^T instead, and no inference is kept.
+bool LinearRegression::trainSparse(const SparseMatrix& X, const std::vector<double>& y, double lambda) {
+    if (X.getRows() == 0 || X.getRows() != y.size()) {
+        return fail("Sparse design and target vector do not match");
+    }
+    if (X.getCols() == 0) {
+        return fail("Sparse design has no feature columns");
+    }
+
+    try {
+        size_t p = X.getCols();
+        Matrix gram;
+        if (p <= DIRECT_SPARSE_FEATURES) {
+            gram = X.gram().toDense();
+            for (size_t j = 0; j < p; ++j) {
+                gram(j, j) += lambda;
+            }
+            coefficients = gram.lu().solve(X.transposeMultiply(y));
+        } else {
+            ConjugateGradient solver(SPARSE_CG_ITERATIONS, SPARSE_CG_TOLERANCE);
+            ConjugateGradient::Result solved = solver.solveLeastSquares(X, y, lambda);
+            if (!solved.converged) {
+                return fail("Conjugate gradient did not converge on the sparse design");
+            }
+            coefficients = std::move(solved.solution);
+        }
+        scorer = ScoringKernel(coefficients);
+        isTrained = true;
+
+        std::vector<double> fitted = X.multiply(coefficients);
+        double sumSquaredErrors = Summation::squaredDifferences(fitted.data(), y.data(), y.size());
+        trainRMSE = std::sqrt(sumSquaredErrors / y.size());
+        if (lambda == 0.0 && p <= DIRECT_SPARSE_FEATURES) {
+            computeInference(gram, sumSquaredErrors, static_cast<double>(y.size()));
+        } else {
+            clearInference();
+        }
+        return true;
+    }
+    catch (const std::exception& e) {
+        return fail(std::string("Sparse training failed: ") + e.what());
     }
 }
 
@@ -125,47 +279,115 @@ double LinearRegression::predict(const std::vector<double>& features) const {
         throw std::runtime_error("Model has not been trained yet");
     }
     
-    if (features.size() != 6) {
-        throw std::invalid_argument("Feature vector must have exactly 6 elements");
+    if (features.size() != coefficients.size()) {
+        throw std::invalid_argument("Feature vector must have one element per coefficient");
     }
 
     double prediction = 0.0;
-    for (size_t i = 0; i < 6; ++i) {
+    for (size_t i = 0; i < coefficients.size(); ++i) {
         prediction += coefficients[i] * features[i];
     }
     
     return prediction;
 }
 
-// Predict multiple values
+// Predict multiple values: features are packed row-major and scored by the
+// kernel specialized for the model's feature count
 std::vector<double> LinearRegression::predict(const Dataset& testData) const {
-    std::vector<double> predictions;
-    predictions.reserve(testData.size());
-    
-    for (size_t i = 0; i < testData.size(); ++i) {
-        predictions.push_back(predict(testData[i]));
+    if (!isTrained) {
+        throw std::runtime_error("Model has not been trained yet");
     }
-    
+    if (coefficients.size() != 6) {
+        throw std::invalid_argument("Model was trained on a wider design; score it with predict(Matrix)");
+    }
+
+    size_t n = testData.size();
+    std::vector<double, HugePages::Allocator<double>> rows(n * 6);
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<double> features = testData[i].getFeatureVector();
+        std::copy(features.begin(), features.end(), rows.begin() + i * 6);
+    }
+    std::vector<double> predictions(n);
+    scorer.score(rows.data(), n, predictions.data());
     return predictions;
 }
 
-// Calculate Root Mean Square Error
-double LinearRegression::calculateRMSE(const Dataset& testData) const {
+std::vector<double> LinearRegression::predict(const Matrix& X) const {
     if (!isTrained) {
         throw std::runtime_error("Model has not been trained yet");
     }
-    
-    double sumSquaredErrors = 0.0;
-    size_t n = testData.size();
-    
-    for (size_t i = 0; i < n; ++i) {
-        double prediction = predict(testData[i]);
-        double actual = testData[i].getTarget();
-        double error = prediction - actual;
-        sumSquaredErrors += error * error;
+    return scorer.score(X);
+}
+
+// Row-major batch (count x coefficients), no copies
+void LinearRegression::predictBatch(const double* rows, size_t count, double* out) const {
+    if (!isTrained) {
+        throw std::runtime_error("Model has not been trained yet");
     }
-    
-    return std::sqrt(sumSquaredErrors / n);
+    scorer.score(rows, count, out);
+}
+
+// Batched intervals: x^T (X^T X)^(-1) x from one triangular solve per row batch
+std::vector<LinearRegression::PredictionInterval> LinearRegression::predictIntervals(
+    const Matrix& X, double confidence, bool forNewObservation) const {
+    if (!isTrained) {
+        throw std::runtime_error("Model has not been trained yet");
+    }
+    if (!hasInference) {
+        throw std::runtime_error("Standard errors are only available for unregularized fits");
+    }
+    size_t p = coefficients.size();
+    if (X.getCols() != p) {
+        throw std::invalid_argument("Design matrix must have one column per coefficient");
+    }
+
+    double critical = tCriticalValue(confidence, degreesOfFreedom);
+    double noise = forNewObservation ? 1.0 : 0.0;
+    size_t n = X.getRows();
+    std::vector<PredictionInterval> result(n);
+
+    Parallel::parallelFor(n, INTERVAL_GRAIN, [&](size_t, size_t begin, size_t end) {
+        std::vector<double> batch(INTERVAL_BATCH * p);
+        std::vector<double> forms(INTERVAL_BATCH);
+        for (size_t start = begin; start < end; start += INTERVAL_BATCH) {
+            size_t rows = std::min(INTERVAL_BATCH, end - start);
+            for (size_t i = 0; i < rows; ++i) {
+                const std::vector<double>& x = X[start + i];
+                std::copy(x.begin(), x.end(), batch.begin() + i * p);
+            }
+            gramFactor.quadraticForms(batch.data(), rows, forms.data());
+
+            for (size_t i = 0; i < rows; ++i) {
+                const double* x = batch.data() + i * p;
+                double prediction = 0.0;
+                for (size_t j = 0; j < p; ++j) {
+                    prediction += coefficients[j] * x[j];
+                }
+                double standardError = std::sqrt(residualVariance * (forms[i] + noise));
+                result[start + i] = {prediction, standardError,
+                                     prediction - critical * standardError,
+                                     prediction + critical * standardError};
+            }
+        }
+    });
+    return result;
+}
+
+std::vector<LinearRegression::PredictionInterval> LinearRegression::predictIntervals(
+    const Dataset& data, double confidence, bool forNewObservation) const {
+    return predictIntervals(createDesignMatrix(data), confidence, forNewObservation);
+}
+
+LinearRegression::PredictionInterval LinearRegression::predictInterval(
+    const DataPoint& point, double confidence, bool forNewObservation) const {
+    Matrix X(1, 6);
+    X[0] = point.getFeatureVector();
+    return predictIntervals(X, confidence, forNewObservation)[0];
+}
+
+// Calculate Root Mean Square Error
+double LinearRegression::calculateRMSE(const Dataset& testData) const {
+    return std::sqrt(calculateMSE(testData));
 }
 
 // Calculate Mean Square Error
@@ -174,17 +396,9 @@ double LinearRegression::calculateMSE(const Dataset& testData) const {
         throw std::runtime_error("Model has not been trained yet");
     }
     
-    double sumSquaredErrors = 0.0;
-    size_t n = testData.size();
-    
-    for (size_t i = 0; i < n; ++i) {
-        double prediction = predict(testData[i]);
-        double actual = testData[i].getTarget();
-        double error = prediction - actual;
-        sumSquaredErrors += error * error;
-    }
-    
-    return sumSquaredErrors / n;
+    std::vector<double> predictions = predict(testData);
+    std::vector<double> actuals = createTargetVector(testData);
+    return Summation::squaredDifferences(predictions.data(), actuals.data(), actuals.size()) / actuals.size();
 }
 
 // Calculate Mean Absolute Error
@@ -193,16 +407,9 @@ double LinearRegression::calculateMAE(const Dataset& testData) const {
         throw std::runtime_error("Model has not been trained yet");
     }
     
-    double sumAbsoluteErrors = 0.0;
-    size_t n = testData.size();
-    
-    for (size_t i = 0; i < n; ++i) {
-        double prediction = predict(testData[i]);
-        double actual = testData[i].getTarget();
-        sumAbsoluteErrors += std::abs(prediction - actual);
-    }
-    
-    return sumAbsoluteErrors / n;
+    std::vector<double> predictions = predict(testData);
+    std::vector<double> actuals = createTargetVector(testData);
+    return Summation::absoluteDifferences(predictions.data(), actuals.data(), actuals.size()) / actuals.size();
 }
 
 // Calculate R-squared
@@ -211,26 +418,13 @@ double LinearRegression::calculateRSquared(const Dataset& testData) const {
         throw std::runtime_error("Model has not been trained yet");
     }
     
-    // Calculate mean of actual values
-    double meanActual = 0.0;
-    size_t n = testData.size();
-    
-    for (size_t i = 0; i < n; ++i) {
-        meanActual += testData[i].getTarget();
-    }
-    meanActual /= n;
+    std::vector<double> predictions = predict(testData);
+    std::vector<double> actuals = createTargetVector(testData);
+    size_t n = actuals.size();
     
-    // Calculate sum of squares
-    double totalSumSquares = 0.0;  // TSS
-    double residualSumSquares = 0.0;  // RSS
-    
-    for (size_t i = 0; i < n; ++i) {
-        double actual = testData[i].getTarget();
-        double prediction = predict(testData[i]);
-        
-        totalSumSquares += (actual - meanActual) * (actual - meanActual);
-        residualSumSquares += (actual - prediction) * (actual - prediction);
-    }
+    // TSS about the mean of the actual values, RSS about the predictions
+    double totalSumSquares = Summation::squaredDeviations(actuals.data(), n, Summation::mean(actuals));
+    double residualSumSquares = Summation::squaredDifferences(actuals.data(), predictions.data(), n);
     
     // R² = 1 - (RSS / TSS)
     if (totalSumSquares == 0.0) {
@@ -253,13 +447,250 @@ void LinearRegression::displayModel() const {
     std::cout << "Training RMSE: " << std::fixed << std::setprecision(4) << trainRMSE << std::endl;
     
     std::cout << "\nModel Coefficients:" << std::endl;
-    std::vector<std::string> featureNames = {"MYCT", "MMIN", "MMAX", "CACH", "CHMIN", "CHMAX"};
+    std::vector<std::string> featureNames = featureNamesFor(coefficients.size());
     
+    if (!hasInference) {
+        for (size_t i = 0; i < coefficients.size(); ++i) {
+            std::cout << "  " << featureNames[i] << ": " 
+                      << std::setw(12) << std::fixed << std::setprecision(6) 
+                      << coefficients[i] << std::endl;
+        }
+        return;
+    }
+    
+    std::vector<double> tStatistics = getTStatistics();
+    std::cout << "  " << std::setw(8) << "" << std::setw(12) << "Estimate"
+              << std::setw(12) << "Std.Error" << std::setw(10) << "t value" << std::endl;
+    for (size_t i = 0; i < coefficients.size(); ++i) {
+        std::cout << "  " << std::setw(8) << std::left << featureNames[i] + ":" << std::right
+                  << std::setw(12) << std::fixed << std::setprecision(6) << coefficients[i]
+                  << std::setw(12) << coefficientStandardErrors[i]
+                  << std::setw(10) << std::setprecision(3) << tStatistics[i] << std::endl;
+    }
+    std::cout << "Residual standard error: " << std::setprecision(4) << std::sqrt(residualVariance)
+              << " on " << std::setprecision(0) << degreesOfFreedom << " degrees of freedom" << std::endl;
+}
+
+// Coefficient / standard error
+std::vector<double> LinearRegression::getTStatistics() const {
+    std::vector<double> result(coefficientStandardErrors.size(), 0.0);
+    for (size_t i = 0; i < result.size(); ++i) {
+        if (coefficientStandardErrors[i] > 0.0) {
+            result[i] = coefficients[i] / coefficientStandardErrors[i];
+        }
+    }
+    return result;
+}
+
+// Student t quantile from the normal quantile by the Cornish-Fisher expansion
+// (relative error below 0.1% for 5 or more degrees of freedom)
+double LinearRegression::tCriticalValue(double confidence, double degreesOfFreedom) {
+    if (confidence <= 0.0 || confidence >= 1.0) {
+        throw std::invalid_argument("Confidence level must be between 0 and 1");
+    }
+    if (degreesOfFreedom <= 0.0) {
+        throw std::invalid_argument("Degrees of freedom must be positive");
+    }
+
+    double z = normalQuantile(0.5 + confidence / 2.0);
+    double v = degreesOfFreedom;
+    double z2 = z * z;
+    double g1 = z * (z2 + 1.0) / 4.0;
+    double g2 = z * ((5.0 * z2 + 16.0) * z2 + 3.0) / 96.0;
+    double g3 = z * (((3.0 * z2 + 19.0) * z2 + 17.0) * z2 - 15.0) / 384.0;
+    double g4 = z * ((((79.0 * z2 + 776.0) * z2 + 1482.0) * z2 - 1920.0) * z2 - 945.0) / 92160.0;
+    return z + g1 / v + g2 / (v * v) + g3 / (v * v * v) + g4 / (v * v * v * v);
+}
+
+// Cholesky factor of X^T X, residual variance and coefficient standard errors
+void LinearRegression::computeInference(const Matrix& gram, double residualSumSquares, double rows) {
+    clearInference();
+    double freedom = rows - static_cast<double>(gram.getRows());
+    if (freedom <= 0.0) {
+        return;
+    }
+
+    try {
+        gramFactor = CholeskyDecomposition(gram);
+    }
+    catch (const std::exception&) {
+        return;
+    }
+
+    degreesOfFreedom = freedom;
+    residualVariance = residualSumSquares / freedom;
+    std::vector<double> diagonal = gramFactor.inverseDiagonal();
+    coefficientStandardErrors.resize(diagonal.size());
+    for (size_t j = 0; j < diagonal.size(); ++j) {
+        coefficientStandardErrors[j] = std::sqrt(residualVariance * diagonal[j]);
+    }
+    hasInference = true;
+}
+
+void LinearRegression::clearInference() {
+    gramFactor = CholeskyDecomposition();
+    residualVariance = 0.0;
+    degreesOfFreedom = 0.0;
+    coefficientStandardErrors.clear();
+    hasInference = false;
+}
+
+// Generated header: constants are printed with 17 significant digits so
+// the compiled model reproduces predict() bit for bit (same summation order)
+bool LinearRegression::exportHeader(const std::string& filename, const std::string& namespaceName) const {
+    if (!isTrained) {
+        return fail("Model has not been trained yet");
+    }
+
+    std::vector<std::string> featureNames = featureNamesFor(coefficients.size());
+    std::string guard;
+    for (char c : namespaceName) {
+        guard += std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : '_';
+    }
+    guard += "_H";
+
+    char number[32];
+    auto literal = [&number](double value) {
+        std::snprintf(number, sizeof(number), "%.17g", value);
+        std::string text = number;
+        if (text.find_first_of(".eEn") == std::string::npos) {
+            text += ".0";
+        }
+        return text;
+    };
+
+    std::ostringstream header;
+    header << "// Generated by cpu_performance_predictor --emit-header. Do not edit.\n";
+    header << "// PRP = sum of COEFFICIENTS[j] * feature j over the raw hardware features.\n";
+    header << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+    header << "#include <cstddef>\n\n";
+    header << "namespace " << namespaceName << " {\n\n";
+    header << "constexpr std::size_t FEATURE_COUNT = " << coefficients.size() << ";\n\n";
+
+    header << "constexpr const char* FEATURE_NAMES[FEATURE_COUNT] = {";
+    for (size_t i = 0; i < featureNames.size(); ++i) {
+        header << (i > 0 ? ", " : "") << "\"" << featureNames[i] << "\"";
+    }
+    header << "};\n\n";
+
+    header << "constexpr double COEFFICIENTS[FEATURE_COUNT] = {\n";
     for (size_t i = 0; i < coefficients.size(); ++i) {
-        std::cout << "  " << featureNames[i] << ": " 
-                  << std::setw(12) << std::fixed << std::setprecision(6) 
-                  << coefficients[i] << std::endl;
+        header << "    " << literal(coefficients[i]) << (i + 1 < coefficients.size() ? "," : "")
+               << "  // " << featureNames[i] << "\n";
+    }
+    header << "};\n\n";
+    header << "constexpr double TRAIN_RMSE = " << literal(trainRMSE) << ";\n\n";
+
+    // Unrolled scalar form; arguments follow the schema order
+    header << "constexpr double predict(";
+    for (size_t i = 0; i < featureNames.size(); ++i) {
+        std::string argument = featureNames[i];
+        for (char& c : argument) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        header << (i > 0 ? ", " : "") << "double " << argument;
     }
+    header << ") noexcept {\n    return ";
+    for (size_t i = 0; i < featureNames.size(); ++i) {
+        std::string argument = featureNames[i];
+        for (char& c : argument) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        header << (i > 0 ? "\n         + " : "") << "COEFFICIENTS[" << i << "] * " << argument;
+    }
+    header << ";\n}\n\n";
+
+    header << "// One row of FEATURE_COUNT values\n";
+    header << "constexpr double predict(const double* x) noexcept {\n    return predict(";
+    for (size_t i = 0; i < featureNames.size(); ++i) {
+        header << (i > 0 ? ", " : "") << "x[" << i << "]";
+    }
+    header << ");\n}\n\n";
+
+    header << "// Row-major batch (count x FEATURE_COUNT)\n";
+    header << "inline void predictBatch(const double* rows, std::size_t count, double* out) noexcept {\n";
+    header << "    for (std::size_t i = 0; i < count; ++i) {\n";
+    header << "        out[i] = predict(rows + i * FEATURE_COUNT);\n";
+    header << "    }\n}\n\n";
+
+    header << "} // namespace " << namespaceName << "\n\n";
+    header << "#endif // " << guard << "\n";
+
+    FileWriter writer;
+    if (!writer.open(filename) || !writer.write(header.str()) || !writer.close()) {
+        return fail("Could not write " + filename);
+    }
+    return true;
+}
+
+bool LinearRegression::save(const std::string& filename) const {
+    if (!isTrained) {
+        return fail("Model has not been trained yet");
+    }
+
+    std::ostringstream text;
+    char number[32];
+    auto put = [&](double value) {
+        std::snprintf(number, sizeof(number), " %.17g", value);
+        text << number;
+    };
+
+    text << MODEL_HEADER << "\n";
+    text << "features " << coefficients.size() << "\n";
+    text << "coefficients";
+    for (double value : coefficients) {
+        put(value);
+    }
+    text << "\ntrain_rmse";
+    put(trainRMSE);
+    text << "\n";
+
+    FileWriter writer;
+    if (!writer.open(filename) || !writer.write(text.str()) || !writer.close()) {
+        return fail("Could not write model file " + filename);
+    }
+    return true;
+}
+
+// Coefficients only; the inference state of the original fit is not stored
+bool LinearRegression::load(const std::string& filename) {
+    FileReader reader;
+    std::string buffer;
+    if (!reader.open(filename) || !reader.readAll(buffer)) {
+        return fail("Could not open file " + filename);
+    }
+
+    std::istringstream text(buffer);
+    std::string header, version, key;
+    size_t features = 0;
+    text >> header >> version;
+    if (header + " " + version != MODEL_HEADER) {
+        return fail(filename + " is not a linear model");
+    }
+    text >> key >> features;
+    if (!text || features == 0) {
+        return fail("Malformed model header in " + filename);
+    }
+
+    std::vector<double> loadedCoefficients(features);
+    double loadedRMSE = 0.0;
+    text >> key;
+    for (double& value : loadedCoefficients) {
+        text >> value;
+    }
+    text >> key >> loadedRMSE;
+    if (!text) {
+        return fail("Truncated model file " + filename);
+    }
+
+    coefficients = std::move(loadedCoefficients);
+    scorer = ScoringKernel(coefficients);
+    trainRMSE = loadedRMSE;
+    testRMSE = 0.0;
+    rSquared = 0.0;
+    clearInference();
+    isTrained = true;
+    return true;
 }
 
 // Display equation
@@ -272,7 +703,7 @@ void LinearRegression::displayEquation() const {
     std::cout << "\n=== Linear Regression Equation ===" << std::endl;
     std::cout << "PRP = ";
     
-    std::vector<std::string> featureNames = {"MYCT", "MMIN", "MMAX", "CACH", "CHMIN", "CHMAX"};
+    std::vector<std::string> featureNames = featureNamesFor(coefficients.size());
     
     for (size_t i = 0; i < coefficients.size(); ++i) {
         if (i > 0) {
@@ -290,29 +721,61 @@ double LinearRegression::crossValidate(const Dataset& data, int folds) const {
         throw std::invalid_argument("Number of folds cannot be greater than dataset size");
     }
     
+    // Augmented design Z = [X | y], built once. A fold's training Gram matrix
+    // Z^T Z sums the row ranges before and after the held-out fold; its
+    // blocks are X^T X and X^T y, read through views
+    Matrix X = createDesignMatrix(data);
+    size_t n = data.size();
+    size_t p = X.getCols();
+    Matrix Z(n, p + 1);
+    Z.colRange(0, p).copyFrom(X.view());
+    for (size_t i = 0; i < n; ++i) {
+        Z(i, p) = data[i].getTarget();
+    }
+    
     std::vector<double> foldRMSEs;
-    size_t foldSize = data.size() / folds;
+    size_t foldSize = n / folds;
     
     for (int fold = 0; fold < folds; ++fold) {
-        // Create temporary training and validation sets
-        Dataset trainSet, validSet;
+        size_t begin = fold * foldSize;
+        size_t end = (fold == folds - 1) ? n : begin + foldSize;
+        ConstMatrixView before = Z.rowRange(0, begin);
+        ConstMatrixView after = Z.rowRange(end, n);
+        Matrix gram = Matrix::TransposedView(before) * before + Matrix::TransposedView(after) * after;
         
-        for (size_t i = 0; i < data.size(); ++i) {
-            if (i >= fold * foldSize && i < (fold + 1) * foldSize && fold < folds - 1) {
-                validSet.addDataPoint(data[i]);
-            } else if (fold == folds - 1 && i >= fold * foldSize) {
-                validSet.addDataPoint(data[i]);
-            } else {
-                trainSet.addDataPoint(data[i]);
+        size_t trainRows = n - (end - begin);
+        LUDecomposition lu(gram.block(0, 0, p, p));
+        if (lu.isSingular()) {
+            if (!quiet) {
+                std::cout << "Fold " << (fold + 1) << "/" << folds << ": training design is singular, skipped"
+                          << std::endl;
             }
+            continue;
         }
+        Matrix theta = lu.solveMany(gram.block(0, p, p, 1));
         
-        // Train temporary model
-        LinearRegression tempModel;
-        if (tempModel.train(trainSet)) {
-            double foldRMSE = tempModel.calculateRMSE(validSet);
-            foldRMSEs.push_back(foldRMSE);
+        // Score the held-out rows in place
+        std::vector<double> foldCoefficients(p);
+        for (size_t j = 0; j < p; ++j) {
+            foldCoefficients[j] = theta(j, 0);
+        }
+        if (!quiet) {
+            // Training RSS at the least-squares solution: y^T y - theta^T X^T y
+            double trainSquaredErrors = gram(p, p);
+            for (size_t j = 0; j < p; ++j) {
+                trainSquaredErrors -= foldCoefficients[j] * gram(j, p);
+            }
+            std::cout << "Fold " << (fold + 1) << "/" << folds << ": trained on " << trainRows
+                      << " samples, training RMSE: " << std::sqrt(std::max(0.0, trainSquaredErrors) / trainRows)
+                      << std::endl;
+        }
+        std::vector<double> predictions = ScoringKernel(foldCoefficients).score(Z.block(begin, 0, end - begin, p));
+        std::vector<double> actuals(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            actuals[i - begin] = Z(i, p);
         }
+        double sumSquaredErrors = Summation::squaredDifferences(predictions.data(), actuals.data(), actuals.size());
+        foldRMSEs.push_back(std::sqrt(sumSquaredErrors / (end - begin)));
     }
     
     // Calculate average RMSE
@@ -320,7 +783,7 @@ double LinearRegression::crossValidate(const Dataset& data, int folds) const {
         return -1.0;  // Error indicator
     }
     
-    double avgRMSE = std::accumulate(foldRMSEs.begin(), foldRMSEs.end(), 0.0) / foldRMSEs.size();
+    double avgRMSE = Summation::mean(foldRMSEs);
     
     std::cout << "Cross-validation results (" << folds << " folds):" << std::endl;
     for (int i = 0; i < static_cast<int>(foldRMSEs.size()); ++i) {
@@ -364,5 +827,5 @@ double LinearRegression::calculateMean(const std::vector<double>& values) const
         return 0.0;
     }
     
-    return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    return Summation::mean(values);
 }
@@ -1,21 +1,190 @@
 #include "../include/Matrix.h"
+#include "../include/LUDecomposition.h"
+#include "../include/Numa.h"
+#include "../include/Parallel.h"
+#include "../include/ScanTuning.h"
+#include "../include/Summation.h"
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
+#include <algorithm>
 #include <cmath>
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Recursion stops at leaf tiles of at most TRANSPOSE_LEAF x TRANSPOSE_LEAF
+// (two 8 KB tiles fit in L1); in-place swaps use the same block edge
+const size_t TRANSPOSE_LEAF = 32;
+// Rows per parallel block in the transposed-view products, and rows summed
+// plainly before each fold into the compensated per-block totals
+const size_t ROW_GRAIN = 4096;
+const size_t GRAM_CHUNK = 1024;
+
+// dst[c][dstCol + r] = src[r][srcCol + c] for a 4x4 tile
+inline void transposeTile(const double* const* src, size_t srcCol, double* const* dst, size_t dstCol) {
+#if defined(__AVX2__)
+    __m256d r0 = _mm256_loadu_pd(src[0] + srcCol);
+    __m256d r1 = _mm256_loadu_pd(src[1] + srcCol);
+    __m256d r2 = _mm256_loadu_pd(src[2] + srcCol);
+    __m256d r3 = _mm256_loadu_pd(src[3] + srcCol);
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+    _mm256_storeu_pd(dst[0] + dstCol, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(dst[1] + dstCol, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(dst[2] + dstCol, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(dst[3] + dstCol, _mm256_permute2f128_pd(t1, t3, 0x31));
+#elif defined(__SSE2__)
+    // Four 2x2 transposes
+    for (size_t r = 0; r < 4; r += 2) {
+        for (size_t c = 0; c < 4; c += 2) {
+            __m128d a = _mm_loadu_pd(src[r] + srcCol + c);
+            __m128d b = _mm_loadu_pd(src[r + 1] + srcCol + c);
+            _mm_storeu_pd(dst[c] + dstCol + r, _mm_unpacklo_pd(a, b));
+            _mm_storeu_pd(dst[c + 1] + dstCol + r, _mm_unpackhi_pd(a, b));
+        }
+    }
+#else
+    for (size_t r = 0; r < 4; ++r) {
+        for (size_t c = 0; c < 4; ++c) {
+            dst[c][dstCol + r] = src[r][srcCol + c];
+        }
+    }
+#endif
+}
+
+// Leaf: 4x4 tiles, then the ragged right and bottom edges
+void transposeLeaf(const double* const* src, double* const* dst,
+                   size_t rowBegin, size_t rowEnd, size_t colBegin, size_t colEnd) {
+    size_t rowTiles = rowBegin + (rowEnd - rowBegin) / 4 * 4;
+    size_t colTiles = colBegin + (colEnd - colBegin) / 4 * 4;
+    for (size_t i = rowBegin; i < rowTiles; i += 4) {
+        for (size_t j = colBegin; j < colTiles; j += 4) {
+            transposeTile(src + i, j, dst + j, i);
+        }
+        for (size_t r = i; r < i + 4; ++r) {
+            for (size_t j = colTiles; j < colEnd; ++j) {
+                dst[j][r] = src[r][j];
+            }
+        }
+    }
+    for (size_t i = rowTiles; i < rowEnd; ++i) {
+        for (size_t j = colBegin; j < colEnd; ++j) {
+            dst[j][i] = src[i][j];
+        }
+    }
+}
+
+// Split the longer side (on a multiple of 4) until the block fits a leaf
+void transposeRecursive(const double* const* src, double* const* dst,
+                        size_t rowBegin, size_t rowEnd, size_t colBegin, size_t colEnd) {
+    size_t height = rowEnd - rowBegin;
+    size_t width = colEnd - colBegin;
+    if (height <= TRANSPOSE_LEAF && width <= TRANSPOSE_LEAF) {
+        transposeLeaf(src, dst, rowBegin, rowEnd, colBegin, colEnd);
+    } else if (height >= width) {
+        size_t middle = rowBegin + (height / 2 + 3) / 4 * 4;
+        transposeRecursive(src, dst, rowBegin, middle, colBegin, colEnd);
+        transposeRecursive(src, dst, middle, rowEnd, colBegin, colEnd);
+    } else {
+        size_t middle = colBegin + (width / 2 + 3) / 4 * 4;
+        transposeRecursive(src, dst, rowBegin, rowEnd, colBegin, middle);
+        transposeRecursive(src, dst, rowBegin, rowEnd, middle, colEnd);
+    }
+}
+
+// Exchange the h x w block at (i, j) with the w x h block at (j, i); a
+// diagonal block (i == j) is transposed onto itself
+void swapBlocks(double* const* rowPointers, size_t i, size_t j, size_t h, size_t w) {
+    if (h == 4 && w == 4) {
+        double upper[16], lower[16];
+        double* upperRows[4] = {upper, upper + 4, upper + 8, upper + 12};
+        double* lowerRows[4] = {lower, lower + 4, lower + 8, lower + 12};
+        transposeTile(rowPointers + i, j, upperRows, 0);
+        if (i != j) {
+            transposeTile(rowPointers + j, i, lowerRows, 0);
+        }
+        for (size_t r = 0; r < 4; ++r) {
+            std::copy(upper + 4 * r, upper + 4 * r + 4, rowPointers[j + r] + i);
+            if (i != j) {
+                std::copy(lower + 4 * r, lower + 4 * r + 4, rowPointers[i + r] + j);
+            }
+        }
+        return;
+    }
+    for (size_t r = 0; r < h; ++r) {
+        for (size_t c = (i == j) ? r + 1 : 0; c < w; ++c) {
+            std::swap(rowPointers[i + r][j + c], rowPointers[j + c][i + r]);
+        }
+    }
+}
+
+// Row i of a view as contiguous memory, gathered into scratch when the
+// view's columns are strided
+const double* contiguousRow(const ConstMatrixView& view, size_t i, std::vector<double>& scratch) {
+    if (view.hasUnitColumnStep()) {
+        return view.rowData(i);
+    }
+    scratch.resize(view.getCols());
+    for (size_t j = 0; j < scratch.size(); ++j) {
+        scratch[j] = view(i, j);
+    }
+    return scratch.data();
+}
+
+// Rows the Gram scans prefetch ahead under the GRAM tuning (0 = off)
+size_t gramLookahead(size_t cols) {
+    size_t bytes = ScanTuning::get(ScanTuning::GRAM).prefetchBytes;
+    return bytes == 0 ? 0 : std::max<size_t>(1, bytes / (std::max<size_t>(cols, 1) * sizeof(double)));
+}
+
+// Prefetch every cache line of row i of a view, if it exists and is contiguous
+inline void prefetchRow(const ConstMatrixView& view, size_t i) {
+    if (i < view.getRows() && view.hasUnitColumnStep()) {
+        const char* row = reinterpret_cast<const char*>(view.rowData(i));
+        for (size_t offset = 0; offset < view.getCols() * sizeof(double); offset += 64) {
+            ScanTuning::prefetch(row + offset);
+        }
+    }
+}
+
+} // namespace
+
 // Default constructor
 Matrix::Matrix() : rows(0), cols(0) {}
 
 // Constructor with dimensions
+// With pinned threads on a multi-node machine, rows are allocated by the
+// ROW_GRAIN blocks that the row-parallel kernels later scan them from, so
+// they are first touched on the scanning thread's node. Otherwise placement
+// does not matter and the rows are allocated here, without a thread team
 Matrix::Matrix(size_t rows, size_t cols) : rows(rows), cols(cols) {
-    data.resize(rows, std::vector<double>(cols, 0.0));
+    if (!Parallel::pinning() || Numa::nodeCount() < 2) {
+        data.assign(rows, std::vector<double>(cols, 0.0));
+        return;
+    }
+    data.resize(rows);
+    Parallel::parallelFor(rows, ROW_GRAIN, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            data[i].assign(cols, 0.0);
+        }
+    });
 }
 
 // Constructor from 2D vector
 Matrix::Matrix(const std::vector<std::vector<double>>& data) 
     : data(data), rows(data.size()), cols(data.empty() ? 0 : data[0].size()) {}
 
+// Materialize a view
+Matrix::Matrix(ConstMatrixView view) : Matrix(view.getRows(), view.getCols()) {
+    this->view().copyFrom(view);
+}
+
 // Copy constructor
 Matrix::Matrix(const Matrix& other) 
     : data(other.data), rows(other.rows), cols(other.cols) {}
@@ -92,18 +261,27 @@ Matrix Matrix::operator-(const Matrix& other) const {
 
 // Matrix multiplication
 Matrix Matrix::operator*(const Matrix& other) const {
-    if (cols != other.rows) {
+    return multiply(view(), other.view());
+}
+
+// i-k-j order: each output row accumulates scaled rows of b, so both
+// operands stream along rows. Every element still sums over k in order.
+Matrix Matrix::multiply(ConstMatrixView a, ConstMatrixView b) {
+    if (a.getCols() != b.getRows()) {
         throw std::invalid_argument("Matrix dimensions incompatible for multiplication");
     }
     
-    Matrix result(rows, other.cols);
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < other.cols; ++j) {
-            double sum = 0.0;
-            for (size_t k = 0; k < cols; ++k) {
-                sum += data[i][k] * other(k, j);
+    Matrix result(a.getRows(), b.getCols());
+    std::vector<double> scratchA, scratchB;
+    for (size_t i = 0; i < a.getRows(); ++i) {
+        const double* aRow = contiguousRow(a, i, scratchA);
+        double* out = result.data[i].data();
+        for (size_t k = 0; k < a.getCols(); ++k) {
+            const double* bRow = contiguousRow(b, k, scratchB);
+            double factor = aRow[k];
+            for (size_t j = 0; j < b.getCols(); ++j) {
+                out[j] += factor * bRow[j];
             }
-            result(i, j) = sum;
         }
     }
     return result;
@@ -122,77 +300,177 @@ Matrix Matrix::operator*(double scalar) const {
 
 // Transpose
 Matrix Matrix::transpose() const {
+    return transposed().materialize();
+}
+
+Matrix Matrix::TransposedView::materialize() const {
+    size_t rows = source.getRows();
+    size_t cols = source.getCols();
     Matrix result(cols, rows);
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            result(j, i) = data[i][j];
+    if (!source.hasUnitColumnStep()) {
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                result.data[j][i] = source(i, j);
+            }
         }
+        return result;
     }
+
+    std::vector<const double*> sourceRows(rows);
+    std::vector<double*> target(cols);
+    for (size_t i = 0; i < rows; ++i) {
+        sourceRows[i] = source.rowData(i);
+    }
+    for (size_t j = 0; j < cols; ++j) {
+        target[j] = result.data[j].data();
+    }
+    transposeRecursive(sourceRows.data(), target.data(), 0, rows, 0, cols);
     return result;
 }
 
-// Inverse using Gaussian elimination with partial pivoting
-Matrix Matrix::inverse() const {
+// In-place transpose: blocks above the diagonal swap with their mirror
+// images, visited TRANSPOSE_LEAF at a time so both stay cache resident
+void Matrix::transposeInPlace() {
     if (!isSquare()) {
-        throw std::invalid_argument("Matrix must be square to compute inverse");
+        throw std::invalid_argument("In-place transpose requires a square matrix");
     }
-    
-    const double EPSILON = 1e-10;
-    size_t n = rows;
-    
-    // Create augmented matrix [A|I]
-    Matrix augmented(n, 2 * n);
-    for (size_t i = 0; i < n; ++i) {
-        for (size_t j = 0; j < n; ++j) {
-            augmented(i, j) = data[i][j];
-        }
-        augmented(i, i + n) = 1.0;  // Identity matrix on the right
+
+    std::vector<double*> rowPointers(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        rowPointers[i] = data[i].data();
     }
-    
-    // Forward elimination with partial pivoting
-    for (size_t i = 0; i < n; ++i) {
-        // Find pivot
-        size_t maxRow = i;
-        for (size_t k = i + 1; k < n; ++k) {
-            if (std::abs(augmented(k, i)) > std::abs(augmented(maxRow, i))) {
-                maxRow = k;
+    for (size_t blockRow = 0; blockRow < rows; blockRow += TRANSPOSE_LEAF) {
+        size_t blockRowEnd = std::min(rows, blockRow + TRANSPOSE_LEAF);
+        for (size_t blockCol = blockRow; blockCol < rows; blockCol += TRANSPOSE_LEAF) {
+            size_t blockColEnd = std::min(rows, blockCol + TRANSPOSE_LEAF);
+            for (size_t i = blockRow; i < blockRowEnd; i += 4) {
+                size_t h = std::min<size_t>(4, blockRowEnd - i);
+                for (size_t j = (blockRow == blockCol) ? i : blockCol; j < blockColEnd; j += 4) {
+                    swapBlocks(rowPointers.data(), i, j, h, std::min<size_t>(4, blockColEnd - j));
+                }
             }
         }
-        
-        // Check for singular matrix
-        if (std::abs(augmented(maxRow, i)) < EPSILON) {
-            throw std::runtime_error("Matrix is singular and cannot be inverted");
+    }
+}
+
+// A^T * B = sum over rows i of A[i]^T B[i]; each row block sums
+// GRAM_CHUNK-row partial products into compensated totals, merged in block
+// order, so the error does not grow with the row count. A^T * A fills only
+// the upper triangle and mirrors it.
+Matrix Matrix::TransposedView::operator*(ConstMatrixView other) const {
+    if (source.getRows() != other.getRows()) {
+        throw std::invalid_argument("Matrix dimensions incompatible for multiplication");
+    }
+
+    size_t p = source.getCols();
+    size_t q = other.getCols();
+    bool symmetric = source.sameWindow(other);
+    size_t n = source.getRows();
+    std::vector<std::vector<Summation::KahanBabuska>> partials(Parallel::blockCount(n, ROW_GRAIN),
+                                                               std::vector<Summation::KahanBabuska>(p * q));
+    size_t ahead = gramLookahead(symmetric ? p : p + q);
+    Parallel::parallelFor(n, ROW_GRAIN, [&](size_t block, size_t begin, size_t end) {
+        Summation::KahanBabuska* total = partials[block].data();
+        std::vector<double> chunk(p * q);
+        double* sum = chunk.data();
+        std::vector<double> scratchA, scratchB;
+        for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += GRAM_CHUNK) {
+            size_t chunkEnd = std::min(end, chunkBegin + GRAM_CHUNK);
+            std::fill(chunk.begin(), chunk.end(), 0.0);
+            for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+                if (ahead != 0) {
+                    prefetchRow(source, i + ahead);
+                    if (!symmetric) {
+                        prefetchRow(other, i + ahead);
+                    }
+                }
+                const double* a = contiguousRow(source, i, scratchA);
+                const double* b = symmetric ? a : contiguousRow(other, i, scratchB);
+                for (size_t r = 0; r < p; ++r) {
+                    double* sumRow = sum + r * q;
+                    for (size_t c = symmetric ? r : 0; c < q; ++c) {
+                        sumRow[c] += a[r] * b[c];
+                    }
+                }
+            }
+            for (size_t e = 0; e < p * q; ++e) {
+                total[e].add(sum[e]);
+            }
         }
-        
-        // Swap rows if needed
-        if (maxRow != i) {
-            augmented.swapRows(i, maxRow);
+    });
+
+    Matrix result(p, q);
+    for (size_t r = 0; r < p; ++r) {
+        for (size_t c = symmetric ? r : 0; c < q; ++c) {
+            Summation::KahanBabuska entry;
+            for (const std::vector<Summation::KahanBabuska>& partial : partials) {
+                entry.merge(partial[r * q + c]);
+            }
+            result.data[r][c] = entry.value();
         }
-        
-        // Make diagonal element 1
-        double pivot = augmented(i, i);
-        augmented.multiplyRow(i, 1.0 / pivot);
-        
-        // Eliminate column
-        for (size_t k = 0; k < n; ++k) {
-            if (k != i) {
-                double factor = augmented(k, i);
-                augmented.addRowMultiple(i, k, -factor);
+    }
+    if (symmetric) {
+        for (size_t r = 0; r < p; ++r) {
+            for (size_t c = 0; c < r; ++c) {
+                result.data[r][c] = result.data[c][r];
             }
         }
     }
-    
-    // Extract the inverse matrix from the right side of augmented matrix
-    Matrix result(n, n);
-    for (size_t i = 0; i < n; ++i) {
-        for (size_t j = 0; j < n; ++j) {
-            result(i, j) = augmented(i, j + n);
+    return result;
+}
+
+std::vector<double> Matrix::TransposedView::operator*(const std::vector<double>& v) const {
+    if (source.getRows() != v.size()) {
+        throw std::invalid_argument("Vector size incompatible for multiplication");
+    }
+
+    size_t p = source.getCols();
+    size_t n = source.getRows();
+    std::vector<std::vector<Summation::KahanBabuska>> partials(Parallel::blockCount(n, ROW_GRAIN),
+                                                               std::vector<Summation::KahanBabuska>(p));
+    size_t ahead = gramLookahead(p);
+    Parallel::parallelFor(n, ROW_GRAIN, [&](size_t block, size_t begin, size_t end) {
+        Summation::KahanBabuska* total = partials[block].data();
+        std::vector<double> sum(p);
+        std::vector<double> scratch;
+        for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += GRAM_CHUNK) {
+            size_t chunkEnd = std::min(end, chunkBegin + GRAM_CHUNK);
+            std::fill(sum.begin(), sum.end(), 0.0);
+            for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+                if (ahead != 0) {
+                    prefetchRow(source, i + ahead);
+                }
+                const double* a = contiguousRow(source, i, scratch);
+                for (size_t r = 0; r < p; ++r) {
+                    sum[r] += a[r] * v[i];
+                }
+            }
+            for (size_t r = 0; r < p; ++r) {
+                total[r].add(sum[r]);
+            }
+        }
+    });
+
+    std::vector<double> result(p, 0.0);
+    for (size_t r = 0; r < p; ++r) {
+        Summation::KahanBabuska entry;
+        for (const std::vector<Summation::KahanBabuska>& partial : partials) {
+            entry.merge(partial[r]);
         }
+        result[r] = entry.value();
     }
-    
     return result;
 }
 
+// Inverse from the partial-pivoted LU factorization
+Matrix Matrix::inverse() const {
+    if (!isSquare()) {
+        throw std::invalid_argument("Matrix must be square to compute inverse");
+    }
+    
+    return lu().inverse();
+}
+
 // Determinant
 double Matrix::determinant() const {
     if (!isSquare()) {
@@ -207,39 +485,13 @@ double Matrix::determinant() const {
         return data[0][0] * data[1][1] - data[0][1] * data[1][0];
     }
     
-    // Use LU decomposition for larger matrices
-    Matrix temp(*this);
-    double det = 1.0;
-    const double EPSILON = 1e-10;
-    
-    for (size_t i = 0; i < rows; ++i) {
-        // Find pivot
-        size_t maxRow = i;
-        for (size_t k = i + 1; k < rows; ++k) {
-            if (std::abs(temp(k, i)) > std::abs(temp(maxRow, i))) {
-                maxRow = k;
-            }
-        }
-        
-        if (std::abs(temp(maxRow, i)) < EPSILON) {
-            return 0.0;  // Singular matrix
-        }
-        
-        if (maxRow != i) {
-            temp.swapRows(i, maxRow);
-            det *= -1.0;  // Row swap changes sign
-        }
-        
-        det *= temp(i, i);
-        
-        // Eliminate below diagonal
-        for (size_t k = i + 1; k < rows; ++k) {
-            double factor = temp(k, i) / temp(i, i);
-            temp.addRowMultiple(i, k, -factor);
-        }
-    }
-    
-    return det;
+    // Product of the LU pivots for larger matrices
+    return lu().determinant();
+}
+
+// LU factorization
+LUDecomposition Matrix::lu() const {
+    return LUDecomposition(*this);
 }
 
 // Identity matrix
@@ -0,0 +1,111 @@
+#include "../include/MetricAccumulator.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Running sums in the serialized form, as (sum, compensation) pairs
+const size_t SERIALIZED_SUMS = 7;
+
+} // namespace
+
+// Add one row
+void MetricAccumulator::add(double actual, double predicted) {
+    double error = predicted - actual;
+    count.add(1.0);
+    sumSquaredErrors.add(error * error);
+    sumAbsoluteErrors.add(std::abs(error));
+    sumActual.add(actual);
+    sumActualSquares.add(actual * actual);
+    if (actual != 0.0) {  // Avoid division by zero
+        sumPercentageErrors.add(std::abs(error / actual) * 100.0);
+        percentageCount.add(1.0);
+    }
+}
+
+// Add a batch: one compensated reduction per statistic
+void MetricAccumulator::addBatch(const double* actual, const double* predicted, size_t rows) {
+    count.add(static_cast<double>(rows));
+    sumSquaredErrors.add(Summation::squaredDifferences(predicted, actual, rows));
+    sumAbsoluteErrors.add(Summation::absoluteDifferences(predicted, actual, rows));
+    sumActual.add(Summation::compensated(actual, rows));
+    sumActualSquares.add(Summation::dot(actual, actual, rows));
+
+    std::vector<double> percentageErrors;
+    percentageErrors.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        if (actual[i] != 0.0) {
+            percentageErrors.push_back(std::abs((predicted[i] - actual[i]) / actual[i]) * 100.0);
+        }
+    }
+    sumPercentageErrors.add(Summation::compensated(percentageErrors));
+    percentageCount.add(static_cast<double>(percentageErrors.size()));
+}
+
+// Merge partial metrics
+void MetricAccumulator::merge(const MetricAccumulator& other) {
+    count.merge(other.count);
+    sumSquaredErrors.merge(other.sumSquaredErrors);
+    sumAbsoluteErrors.merge(other.sumAbsoluteErrors);
+    sumActual.merge(other.sumActual);
+    sumActualSquares.merge(other.sumActualSquares);
+    sumPercentageErrors.merge(other.sumPercentageErrors);
+    percentageCount.merge(other.percentageCount);
+}
+
+double MetricAccumulator::getMSE() const {
+    double rows = count.value();
+    return rows > 0.0 ? sumSquaredErrors.value() / rows : 0.0;
+}
+
+double MetricAccumulator::getRMSE() const {
+    return std::sqrt(getMSE());
+}
+
+double MetricAccumulator::getMAE() const {
+    double rows = count.value();
+    return rows > 0.0 ? sumAbsoluteErrors.value() / rows : 0.0;
+}
+
+// R² = 1 - RSS / TSS
+double MetricAccumulator::getRSquared() const {
+    double rows = count.value();
+    if (rows <= 0.0) {
+        return 0.0;
+    }
+    double total = sumActual.value();
+    double totalSumSquares = std::max(0.0, sumActualSquares.value() - total * total / rows);
+    return totalSumSquares == 0.0 ? 1.0 : 1.0 - sumSquaredErrors.value() / totalSumSquares;
+}
+
+double MetricAccumulator::getMAPE() const {
+    double rows = percentageCount.value();
+    return rows > 0.0 ? sumPercentageErrors.value() / rows : 0.0;
+}
+
+// Every running sum as (sum, compensation), in member order
+std::vector<double> MetricAccumulator::serialize() const {
+    std::vector<double> data;
+    data.reserve(2 * SERIALIZED_SUMS);
+    for (const Summation::KahanBabuska* value : {&count, &sumSquaredErrors, &sumAbsoluteErrors, &sumActual,
+                                                 &sumActualSquares, &sumPercentageErrors, &percentageCount}) {
+        data.push_back(value->getSum());
+        data.push_back(value->getCompensation());
+    }
+    return data;
+}
+
+MetricAccumulator MetricAccumulator::deserialize(const double* data, size_t length) {
+    if (length != 2 * SERIALIZED_SUMS) {
+        throw std::invalid_argument("Serialized metrics have the wrong length");
+    }
+    MetricAccumulator result;
+    for (Summation::KahanBabuska* value : {&result.count, &result.sumSquaredErrors, &result.sumAbsoluteErrors,
+                                           &result.sumActual, &result.sumActualSquares,
+                                           &result.sumPercentageErrors, &result.percentageCount}) {
+        *value = Summation::KahanBabuska(data[0], data[1]);
+        data += 2;
+    }
+    return result;
+}
@@ -0,0 +1,224 @@
+#include "../include/MultiTargetRegression.h"
+#include "../include/LUDecomposition.h"
+#include "../include/Summation.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Rows per column-major batch when accumulating X^T X and X^T Y
+const size_t BATCH_ROWS = 1024;
+
+} // namespace
+
+// Constructor
+MultiTargetRegression::MultiTargetRegression()
+    : features(6), targetNames({"PRP", "ERP"}), isTrained(false) {}
+
+// Train on PRP and ERP
+bool MultiTargetRegression::train(const Dataset& trainData, double lambda) {
+    if (trainData.empty()) {
+        std::cerr << "Error: Training dataset is empty" << std::endl;
+        return false;
+    }
+    return train(createDesignMatrix(trainData), createTargetMatrix(trainData),
+                 {"PRP", "ERP"}, lambda);
+}
+
+// One pass over the rows builds X^T X and X^T Y; one factorization solves all targets.
+// Rows are packed into column-major batches; each batch contributes one
+// compensated dot product per entry, folded into running compensated sums.
+bool MultiTargetRegression::train(const Matrix& X, const Matrix& Y,
+                                  const std::vector<std::string>& names, double lambda) {
+    size_t n = X.getRows();
+    size_t p = X.getCols();
+    size_t k = Y.getCols();
+
+    if (n == 0 || p == 0 || k == 0) {
+        std::cerr << "Error: Training data is empty" << std::endl;
+        return false;
+    }
+    if (Y.getRows() != n || names.size() != k) {
+        std::cerr << "Error: Design matrix, targets and target names do not match" << std::endl;
+        return false;
+    }
+
+    try {
+        std::vector<Summation::KahanBabuska> gramSums(p * p);
+        std::vector<Summation::KahanBabuska> xtySums(p * k);
+        std::vector<double> columns, targets;
+        for (size_t begin = 0; begin < n; begin += BATCH_ROWS) {
+            size_t rows = std::min(BATCH_ROWS, n - begin);
+            columns.resize(p * rows);
+            targets.resize(k * rows);
+            for (size_t i = 0; i < rows; ++i) {
+                const std::vector<double>& x = X[begin + i];
+                const std::vector<double>& y = Y[begin + i];
+                for (size_t j = 0; j < p; ++j) {
+                    columns[j * rows + i] = x[j];
+                }
+                for (size_t t = 0; t < k; ++t) {
+                    targets[t * rows + i] = y[t];
+                }
+            }
+            for (size_t j = 0; j < p; ++j) {
+                const double* xj = columns.data() + j * rows;
+                for (size_t l = j; l < p; ++l) {
+                    gramSums[j * p + l].add(Summation::dot(xj, columns.data() + l * rows, rows));
+                }
+                for (size_t t = 0; t < k; ++t) {
+                    xtySums[j * k + t].add(Summation::dot(xj, targets.data() + t * rows, rows));
+                }
+            }
+        }
+
+        Matrix gram(p, p);
+        Matrix xty(p, k);
+        for (size_t j = 0; j < p; ++j) {
+            for (size_t l = j; l < p; ++l) {
+                gram[j][l] = gram[l][j] = gramSums[j * p + l].value();
+            }
+            gram[j][j] += lambda;
+            for (size_t t = 0; t < k; ++t) {
+                xty[j][t] = xtySums[j * k + t].value();
+            }
+        }
+
+        coefficients = gram.lu().solveMany(xty);
+        features = p;
+        targetNames = names;
+        isTrained = true;
+
+        // Training RMSE per target from one batched predict
+        Matrix fitted = predict(X);
+        trainRMSE.assign(k, 0.0);
+        std::vector<double> fittedColumn(n), targetColumn(n);
+        for (size_t t = 0; t < k; ++t) {
+            for (size_t i = 0; i < n; ++i) {
+                fittedColumn[i] = fitted[i][t];
+                targetColumn[i] = Y[i][t];
+            }
+            trainRMSE[t] = std::sqrt(Summation::squaredDifferences(fittedColumn.data(), targetColumn.data(), n) / n);
+        }
+        return true;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error during multi-target training: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Predict every target for one point
+std::vector<double> MultiTargetRegression::predict(const DataPoint& point) const {
+    if (!isTrained) {
+        throw std::runtime_error("Model has not been trained yet");
+    }
+    if (features != 6) {
+        throw std::invalid_argument("Model was not trained on the 6 hardware features");
+    }
+
+    std::vector<double> x = point.getFeatureVector();
+    std::vector<double> result(targetNames.size(), 0.0);
+    for (size_t j = 0; j < features; ++j) {
+        const std::vector<double>& row = coefficients[j];
+        for (size_t t = 0; t < result.size(); ++t) {
+            result[t] += x[j] * row[t];
+        }
+    }
+    return result;
+}
+
+// Batched predict: each output row accumulates feature-scaled coefficient rows
+Matrix MultiTargetRegression::predict(const Matrix& X) const {
+    if (!isTrained) {
+        throw std::runtime_error("Model has not been trained yet");
+    }
+    if (X.getCols() != features) {
+        throw std::invalid_argument("Design matrix column count does not match the model");
+    }
+
+    size_t k = targetNames.size();
+    Matrix result(X.getRows(), k);
+    for (size_t i = 0; i < X.getRows(); ++i) {
+        const std::vector<double>& x = X[i];
+        std::vector<double>& out = result[i];
+        for (size_t j = 0; j < features; ++j) {
+            const std::vector<double>& row = coefficients[j];
+            double xj = x[j];
+            for (size_t t = 0; t < k; ++t) {
+                out[t] += xj * row[t];
+            }
+        }
+    }
+    return result;
+}
+
+Matrix MultiTargetRegression::predict(const Dataset& data) const {
+    return predict(createDesignMatrix(data));
+}
+
+// Targets as an n x 2 matrix (PRP, ERP)
+Matrix MultiTargetRegression::createTargetMatrix(const Dataset& data) {
+    Matrix Y(data.size(), 2);
+    for (size_t i = 0; i < data.size(); ++i) {
+        Y[i][0] = data[i].getPRP();
+        Y[i][1] = data[i].getERP();
+    }
+    return Y;
+}
+
+// Features as an n x 6 matrix
+Matrix MultiTargetRegression::createDesignMatrix(const Dataset& data) {
+    Matrix X(data.size(), 6);
+    for (size_t i = 0; i < data.size(); ++i) {
+        X[i] = data[i].getFeatureVector();
+    }
+    return X;
+}
+
+// Coefficients of one target
+std::vector<double> MultiTargetRegression::getCoefficients(size_t target) const {
+    if (target >= targetNames.size()) {
+        throw std::out_of_range("Target index out of range");
+    }
+    std::vector<double> result(coefficients.getRows());
+    for (size_t j = 0; j < result.size(); ++j) {
+        result[j] = coefficients[j][target];
+    }
+    return result;
+}
+
+// Display model information
+void MultiTargetRegression::displayModel() const {
+    std::cout << "\n=== Multi-Target Linear Regression Model ===" << std::endl;
+
+    if (!isTrained) {
+        std::cout << "Model has not been trained yet." << std::endl;
+        return;
+    }
+
+    std::vector<std::string> featureNames = {"MYCT", "MMIN", "MMAX", "CACH", "CHMIN", "CHMAX"};
+
+    std::cout << std::setw(8) << "";
+    for (const std::string& name : targetNames) {
+        std::cout << std::setw(14) << name;
+    }
+    std::cout << std::endl;
+
+    for (size_t j = 0; j < features; ++j) {
+        std::cout << std::setw(8) << (j < featureNames.size() ? featureNames[j] : "x" + std::to_string(j + 1));
+        for (size_t t = 0; t < targetNames.size(); ++t) {
+            std::cout << std::setw(14) << std::fixed << std::setprecision(6) << coefficients[j][t];
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << std::setw(8) << "RMSE";
+    for (double rmse : trainRMSE) {
+        std::cout << std::setw(14) << std::fixed << std::setprecision(4) << rmse;
+    }
+    std::cout << std::endl;
+}
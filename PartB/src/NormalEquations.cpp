@@ -0,0 +1,204 @@
+#include "../include/NormalEquations.h"
+#include "../include/LUDecomposition.h"
+#include <algorithm>
+#include <stdexcept>
+
+// Constructor
+NormalEquations::NormalEquations(size_t features)
+    : features(features), xtx(features * features), xty(features) {}
+
+// Add a single row
+void NormalEquations::addRow(const double* x, double y, double weight) {
+    if (weight == 0.0) {
+        return;
+    }
+    for (size_t j = 0; j < features; ++j) {
+        double wx = weight * x[j];
+        for (size_t k = 0; k < features; ++k) {
+            xtx[j * features + k].add(wx * x[k]);
+        }
+        xty[j].add(wx * y);
+    }
+    yty.add(weight * y * y);
+    sumY.add(weight * y);
+    count.add(weight);
+}
+
+// Add a column-major batch: each Gram entry is one compensated dot product
+// over the batch
+void NormalEquations::addColumns(const double* const* columns, const double* target,
+                                 size_t rows, const double* weights) {
+    std::vector<double> weighted(weights ? rows : 0);
+
+    for (size_t j = 0; j < features; ++j) {
+        const double* xj = columns[j];
+        if (weights) {
+            for (size_t i = 0; i < rows; ++i) {
+                weighted[i] = weights[i] * xj[i];
+            }
+            xj = weighted.data();
+        }
+
+        for (size_t k = j; k < features; ++k) {
+            double sum = Summation::dot(xj, columns[k], rows);
+            xtx[j * features + k].add(sum);
+            if (k != j) {
+                xtx[k * features + j].add(sum);
+            }
+        }
+        xty[j].add(Summation::dot(xj, target, rows));
+    }
+
+    if (weights) {
+        for (size_t i = 0; i < rows; ++i) {
+            weighted[i] = weights[i] * target[i];
+        }
+        yty.add(Summation::dot(weighted.data(), target, rows));
+        sumY.add(Summation::compensated(weighted.data(), rows));
+        count.add(Summation::compensated(weights, rows));
+    } else {
+        yty.add(Summation::dot(target, target, rows));
+        sumY.add(Summation::compensated(target, rows));
+        count.add(static_cast<double>(rows));
+    }
+}
+
+// Merge partial statistics
+void NormalEquations::merge(const NormalEquations& other) {
+    if (other.features != features) {
+        throw std::invalid_argument("Cannot merge normal equations of different sizes");
+    }
+    for (size_t i = 0; i < xtx.size(); ++i) {
+        xtx[i].merge(other.xtx[i]);
+    }
+    for (size_t j = 0; j < features; ++j) {
+        xty[j].merge(other.xty[j]);
+    }
+    yty.merge(other.yty);
+    sumY.merge(other.sumY);
+    count.merge(other.count);
+}
+
+// Reset
+void NormalEquations::clear() {
+    for (Summation::KahanBabuska& entry : xtx) {
+        entry.clear();
+    }
+    for (Summation::KahanBabuska& entry : xty) {
+        entry.clear();
+    }
+    yty.clear();
+    sumY.clear();
+    count.clear();
+}
+
+// Every running sum as (sum, compensation), in member order
+std::vector<double> NormalEquations::serialize() const {
+    std::vector<double> data;
+    data.reserve(1 + 2 * (xtx.size() + xty.size() + 3));
+    data.push_back(static_cast<double>(features));
+    auto put = [&data](const Summation::KahanBabuska& value) {
+        data.push_back(value.getSum());
+        data.push_back(value.getCompensation());
+    };
+    for (const Summation::KahanBabuska& entry : xtx) {
+        put(entry);
+    }
+    for (const Summation::KahanBabuska& entry : xty) {
+        put(entry);
+    }
+    put(yty);
+    put(sumY);
+    put(count);
+    return data;
+}
+
+NormalEquations NormalEquations::deserialize(const double* data, size_t length) {
+    if (length == 0 || data[0] < 0.0 || data[0] != static_cast<double>(static_cast<size_t>(data[0]))) {
+        throw std::invalid_argument("Serialized normal equations have no valid feature count");
+    }
+    size_t features = static_cast<size_t>(data[0]);
+    if (length != 1 + 2 * (features * features + features + 3)) {
+        throw std::invalid_argument("Serialized normal equations have the wrong length");
+    }
+
+    NormalEquations result(features);
+    const double* next = data + 1;
+    auto get = [&next]() {
+        Summation::KahanBabuska value(next[0], next[1]);
+        next += 2;
+        return value;
+    };
+    for (Summation::KahanBabuska& entry : result.xtx) {
+        entry = get();
+    }
+    for (Summation::KahanBabuska& entry : result.xty) {
+        entry = get();
+    }
+    result.yty = get();
+    result.sumY = get();
+    result.count = get();
+    return result;
+}
+
+// Solve the (optionally ridge-regularized) normal equation
+std::vector<double> NormalEquations::solve(double lambda) const {
+    if (getCount() <= 0.0) {
+        throw std::runtime_error("No rows accumulated");
+    }
+
+    Matrix gram = getGram();
+    for (size_t j = 0; j < features; ++j) {
+        gram(j, j) += lambda;
+    }
+
+    return gram.lu().solve(getXty());
+}
+
+// RSS = y'y - 2 theta'X'y + theta'X'X theta
+double NormalEquations::residualSumSquares(const std::vector<double>& coefficients) const {
+    if (coefficients.size() != features) {
+        throw std::invalid_argument("Coefficient count does not match feature count");
+    }
+    double quadratic = 0.0;
+    double linear = 0.0;
+    for (size_t j = 0; j < features; ++j) {
+        double row = 0.0;
+        for (size_t k = 0; k < features; ++k) {
+            row += xtx[j * features + k].value() * coefficients[k];
+        }
+        quadratic += coefficients[j] * row;
+        linear += coefficients[j] * xty[j].value();
+    }
+    return std::max(0.0, getYty() - 2.0 * linear + quadratic);
+}
+
+// TSS = y'y - n * mean(y)^2
+double NormalEquations::totalSumSquares() const {
+    double rows = getCount();
+    if (rows <= 0.0) {
+        return 0.0;
+    }
+    double total = getSumY();
+    return std::max(0.0, getYty() - total * total / rows);
+}
+
+// Gram matrix X^T X
+Matrix NormalEquations::getGram() const {
+    Matrix gram(features, features);
+    for (size_t j = 0; j < features; ++j) {
+        for (size_t k = 0; k < features; ++k) {
+            gram(j, k) = xtx[j * features + k].value();
+        }
+    }
+    return gram;
+}
+
+// X^T y
+std::vector<double> NormalEquations::getXty() const {
+    std::vector<double> result(features);
+    for (size_t j = 0; j < features; ++j) {
+        result[j] = xty[j].value();
+    }
+    return result;
+}
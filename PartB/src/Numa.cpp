@@ -0,0 +1,261 @@
+#include "../include/Numa.h"
+#include "../include/HugePages.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#define CPUPERF_HAVE_AFFINITY 1
+#include <sched.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CPUPERF_HAVE_SYSCONF 1
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/mempolicy.h>)
+#define CPUPERF_HAVE_MBIND 1
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace {
+
+struct Node {
+    int id;                       // kernel node number
+    std::vector<int> cpus;        // usable CPUs, ascending
+};
+
+// Parse a sysfs list such as "0-3,8-11"
+std::vector<int> parseList(const std::string& text) {
+    std::vector<int> values;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find(',', pos);
+        std::string range = text.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        size_t dash = range.find('-');
+        char* tail = nullptr;
+        long first = std::strtol(range.c_str(), &tail, 10);
+        if (tail != range.c_str()) {
+            long last = dash == std::string::npos ? first : std::strtol(range.c_str() + dash + 1, nullptr, 10);
+            for (long v = first; v <= last; ++v) {
+                values.push_back(static_cast<int>(v));
+            }
+        }
+        if (end == std::string::npos) {
+            break;
+        }
+        pos = end + 1;
+    }
+    return values;
+}
+
+std::string readLine(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+#ifdef CPUPERF_HAVE_AFFINITY
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < hardware; ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    return cpus;
+}
+
+// Nodes that own at least one CPU we may run on; read once
+const std::vector<Node>& topology() {
+    static const std::vector<Node> nodes = []() {
+        std::vector<int> allowed = allowedCpus();
+        std::vector<Node> result;
+        for (int id : parseList(readLine("/sys/devices/system/node/online"))) {
+            std::string path = "/sys/devices/system/node/node" + std::to_string(id) + "/cpulist";
+            Node node{id, {}};
+            for (int cpu : parseList(readLine(path))) {
+                if (std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+                    node.cpus.push_back(cpu);
+                }
+            }
+            if (!node.cpus.empty()) {
+                result.push_back(node);
+            }
+        }
+        if (result.empty()) {
+            result.push_back(Node{0, allowed});
+        }
+        return result;
+    }();
+    return nodes;
+}
+
+size_t pageSize() {
+#ifdef CPUPERF_HAVE_SYSCONF
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+#ifdef CPUPERF_HAVE_MBIND
+// mbind over the whole pages inside the range
+bool applyPolicy(void* address, size_t bytes, int mode, const std::vector<int>& nodeIds) {
+    const size_t page = pageSize();
+    uintptr_t begin = (reinterpret_cast<uintptr_t>(address) + page - 1) / page * page;
+    uintptr_t end = (reinterpret_cast<uintptr_t>(address) + bytes) / page * page;
+    if (end <= begin) {
+        return true;
+    }
+    const size_t bits = 8 * sizeof(unsigned long);
+    int highest = *std::max_element(nodeIds.begin(), nodeIds.end());
+    std::vector<unsigned long> mask(static_cast<size_t>(highest) / bits + 1, 0);
+    for (int id : nodeIds) {
+        mask[static_cast<size_t>(id) / bits] |= 1UL << (static_cast<size_t>(id) % bits);
+    }
+    return syscall(SYS_mbind, begin, end - begin, mode, mask.data(), mask.size() * bits + 1, 0) == 0;
+}
+#endif
+
+} // namespace
+
+namespace Numa {
+
+size_t nodeCount() {
+    return topology().size();
+}
+
+const std::vector<int>& nodeCpus(size_t node) {
+    return topology()[node].cpus;
+}
+
+// Equal runs of consecutive blocks per node
+size_t nodeForBlock(size_t block, size_t blocks) {
+    return blocks == 0 ? 0 : std::min(nodeCount() - 1, block * nodeCount() / blocks);
+}
+
+int cpuForBlock(size_t block, size_t blocks) {
+    size_t node = nodeForBlock(block, blocks);
+    size_t firstBlock = (node * blocks + nodeCount() - 1) / nodeCount();
+    const std::vector<int>& cpus = nodeCpus(node);
+    return cpus[(block - firstBlock) % cpus.size()];
+}
+
+bool pinCurrentThread(int cpu) {
+#ifdef CPUPERF_HAVE_AFFINITY
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+ScopedPin::ScopedPin(int cpu) : pinned(false) {
+#ifdef CPUPERF_HAVE_AFFINITY
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &set)) {
+                previous.push_back(c);
+            }
+        }
+        pinned = pinCurrentThread(cpu);
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+ScopedPin::~ScopedPin() {
+#ifdef CPUPERF_HAVE_AFFINITY
+    if (pinned) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int c : previous) {
+            CPU_SET(c, &set);
+        }
+        sched_setaffinity(0, sizeof(set), &set);
+    }
+#endif
+}
+
+void* allocatePages(size_t bytes) {
+    return bytes == 0 ? nullptr : HugePages::allocate(bytes);
+}
+
+void freePages(void* pages, size_t bytes) {
+    HugePages::deallocate(pages, bytes);
+}
+
+bool bindToNode(void* address, size_t bytes, size_t node) {
+#ifdef CPUPERF_HAVE_MBIND
+    return node < nodeCount() && applyPolicy(address, bytes, MPOL_BIND, {topology()[node].id});
+#else
+    (void)address;
+    (void)bytes;
+    (void)node;
+    return false;
+#endif
+}
+
+bool interleave(void* address, size_t bytes) {
+#ifdef CPUPERF_HAVE_MBIND
+    std::vector<int> ids;
+    for (const Node& node : topology()) {
+        ids.push_back(node.id);
+    }
+    return applyPolicy(address, bytes, MPOL_INTERLEAVE, ids);
+#else
+    (void)address;
+    (void)bytes;
+    return false;
+#endif
+}
+
+int nodeOfAddress(const void* address) {
+#ifdef CPUPERF_HAVE_MBIND
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, address, MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+        return -1;
+    }
+    for (size_t n = 0; n < nodeCount(); ++n) {
+        if (topology()[n].id == node) {
+            return static_cast<int>(n);
+        }
+    }
+    return -1;
+#else
+    (void)address;
+    return -1;
+#endif
+}
+
+} // namespace Numa
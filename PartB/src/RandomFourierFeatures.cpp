@@ -0,0 +1,91 @@
+#include "../include/RandomFourierFeatures.h"
+#include "../include/CpuDispatch.h"
+#include "../include/HugePages.h"
+#include "../include/Parallel.h"
+#include "../include/SplitMix64.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Frequencies per parallel block in transform()
+const size_t FREQUENCY_GRAIN = 16;
+
+} // namespace
+
+// Default constructor
+RandomFourierFeatures::RandomFourierFeatures()
+    : inputs(0), frequencies(0), gamma(0.0), seed(0) {}
+
+// Draw the frequency matrix from the seed
+RandomFourierFeatures::RandomFourierFeatures(size_t inputs, size_t frequencies,
+                                             double gamma, uint64_t seed)
+    : inputs(inputs), frequencies(frequencies), gamma(gamma), seed(seed),
+      weights(inputs * frequencies) {
+    if (inputs == 0 || frequencies == 0) {
+        throw std::invalid_argument("Feature map needs at least one input and one frequency");
+    }
+    if (gamma <= 0.0) {
+        throw std::invalid_argument("RBF gamma must be positive");
+    }
+
+    // Box-Muller pairs scaled to N(0, 2 * gamma)
+    const double TWO_PI = 6.28318530717958647693;
+    double scale = std::sqrt(2.0 * gamma);
+    SplitMix64 random(seed);
+    for (size_t i = 0; i < weights.size(); i += 2) {
+        double radius = std::sqrt(-2.0 * std::log(random.uniform()));
+        double theta = TWO_PI * random.uniform();
+        weights[i] = scale * radius * std::cos(theta);
+        if (i + 1 < weights.size()) {
+            weights[i + 1] = scale * radius * std::sin(theta);
+        }
+    }
+}
+
+// Batch transform, one output column (and its sin/cos partner) at a time
+void RandomFourierFeatures::transform(const double* batch, size_t rows,
+                                      std::vector<double>& out) const {
+    out.assign(getOutputs() * rows, 0.0);
+    if (rows == 0) {
+        return;
+    }
+
+    // Column-major copy of the inputs so every projection is a sequence of axpys
+    std::vector<double, HugePages::Allocator<double>> columns(inputs * rows);
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t d = 0; d < inputs; ++d) {
+            columns[d * rows + i] = batch[i * inputs + d];
+        }
+    }
+
+    double norm = std::sqrt(1.0 / frequencies);
+    Parallel::parallelFor(frequencies, FREQUENCY_GRAIN, [&](size_t, size_t begin, size_t end) {
+        std::vector<double> angles(rows);
+        for (size_t j = begin; j < end; ++j) {
+            const double* w = weights.data() + j * inputs;
+            for (size_t i = 0; i < rows; ++i) {
+                angles[i] = w[0] * columns[i];
+            }
+            for (size_t d = 1; d < inputs; ++d) {
+                const double* column = columns.data() + d * rows;
+                for (size_t i = 0; i < rows; ++i) {
+                    angles[i] += w[d] * column[i];
+                }
+            }
+
+            double* cosines = out.data() + j * rows;
+            double* sines = out.data() + (frequencies + j) * rows;
+            sinCos(angles.data(), rows, sines, cosines);
+            for (size_t i = 0; i < rows; ++i) {
+                cosines[i] *= norm;
+                sines[i] *= norm;
+            }
+        }
+    });
+}
+
+// Vectorized sin/cos at the dispatched instruction-set level
+void RandomFourierFeatures::sinCos(const double* angles, size_t n, double* sines, double* cosines) {
+    CpuDispatch::kernels().sinCos(angles, n, sines, cosines);
+}
@@ -0,0 +1,60 @@
+#include "../include/ScanTuning.h"
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+const char* const KERNEL_NAMES[ScanTuning::KERNEL_COUNT] = {"PREDICT", "METRICS", "GRAM"};
+// Defaults from scan_bench on 1 GB inputs: prefetching 4 KB ahead made the
+// PREDICT and METRICS scans 35-50% faster; the Gram scan over separately
+// allocated rows is compute bound and gained nothing
+const size_t DEFAULT_PREFETCH_BYTES[ScanTuning::KERNEL_COUNT] = {4096, 4096, 0};
+
+struct Slot {
+    std::atomic<size_t> prefetchBytes;
+    std::atomic<bool> streamingStores;
+};
+
+// Settings per kernel, seeded from the environment on first use
+Slot* slots() {
+    static Slot table[ScanTuning::KERNEL_COUNT];
+    static const bool seeded = []() {
+        for (int k = 0; k < ScanTuning::KERNEL_COUNT; ++k) {
+            std::string suffix = KERNEL_NAMES[k];
+            const char* prefetch = std::getenv(("CPUPERF_PREFETCH_" + suffix).c_str());
+            const char* stream = std::getenv(("CPUPERF_STREAM_" + suffix).c_str());
+            long bytes = prefetch != nullptr ? std::strtol(prefetch, nullptr, 10)
+                                             : static_cast<long>(DEFAULT_PREFETCH_BYTES[k]);
+            table[k].prefetchBytes.store(bytes > 0 ? static_cast<size_t>(bytes) : 0);
+            table[k].streamingStores.store(stream != nullptr && std::strtol(stream, nullptr, 10) > 0);
+        }
+        return true;
+    }();
+    (void)seeded;
+    return table;
+}
+
+} // namespace
+
+namespace ScanTuning {
+
+Settings get(Kernel kernel) {
+    Slot& slot = slots()[kernel];
+    Settings settings;
+    settings.prefetchBytes = slot.prefetchBytes.load(std::memory_order_relaxed);
+    settings.streamingStores = slot.streamingStores.load(std::memory_order_relaxed);
+    return settings;
+}
+
+void set(Kernel kernel, const Settings& settings) {
+    Slot& slot = slots()[kernel];
+    slot.prefetchBytes.store(settings.prefetchBytes, std::memory_order_relaxed);
+    slot.streamingStores.store(settings.streamingStores, std::memory_order_relaxed);
+}
+
+const char* kernelName(Kernel kernel) {
+    return KERNEL_NAMES[kernel];
+}
+
+} // namespace ScanTuning
@@ -0,0 +1,212 @@
+#include "../include/ScoringKernel.h"
+#include "../include/CpuDispatch.h"
+#include "../include/Parallel.h"
+#include "../include/ScanTuning.h"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Rows per parallel block, and rows packed per kernel call in score(Matrix)
+const size_t ROW_GRAIN = 4096;
+const size_t PACK_ROWS = 256;
+// Blocked GEMV: a 2 KB coefficient slice stays in L1 across a block of rows
+const size_t COLUMN_BLOCK = ScoringKernel::MAX_ROW_LOOP;
+const size_t ROW_BLOCK = 32;
+// Tuned scoring runs the kernel on tiles of TILE_ROWS rows, prefetching one
+// tile's worth of input ahead; outputs shorter than STREAM_MIN_ROWS are
+// likely still cached when read, so they are never streamed
+const size_t TILE_ROWS = 64;
+const size_t STREAM_MIN_ROWS = 1 << 16;
+const size_t CACHE_LINE = 64;
+
+// Fully unrolled dot products for P features; the fold expands to one
+// statement per column, evaluated left to right
+template <size_t P, size_t... J>
+inline void scoreUnrolled(const double* coefficients, double intercept, const double* rows,
+                          size_t count, double* out, std::index_sequence<J...>) {
+    const double c[P] = {coefficients[J]...};
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const double* x = rows + i * P;
+        double s0 = intercept, s1 = intercept, s2 = intercept, s3 = intercept;
+        ((s0 += c[J] * x[J], s1 += c[J] * x[P + J],
+          s2 += c[J] * x[2 * P + J], s3 += c[J] * x[3 * P + J]), ...);
+        out[i] = s0;
+        out[i + 1] = s1;
+        out[i + 2] = s2;
+        out[i + 3] = s3;
+    }
+    for (; i < count; ++i) {
+        const double* x = rows + i * P;
+        double sum = intercept;
+        ((sum += c[J] * x[J]), ...);
+        out[i] = sum;
+    }
+}
+
+template <size_t P>
+void scoreFixed(const double* coefficients, size_t, double intercept,
+                const double* rows, size_t count, double* out) {
+    scoreUnrolled<P>(coefficients, intercept, rows, count, out, std::make_index_sequence<P>());
+}
+
+// Blocked GEMV for models past the specialized range: rows are processed
+// in blocks, columns in slices, partial sums carried in out[]
+void scoreBlocked(const double* coefficients, size_t features, double intercept,
+                  const double* rows, size_t count, double* out) {
+    for (size_t rowBegin = 0; rowBegin < count; rowBegin += ROW_BLOCK) {
+        size_t rowEnd = std::min(count, rowBegin + ROW_BLOCK);
+        std::fill(out + rowBegin, out + rowEnd, intercept);
+
+        for (size_t colBegin = 0; colBegin < features; colBegin += COLUMN_BLOCK) {
+            size_t width = std::min(features, colBegin + COLUMN_BLOCK) - colBegin;
+            const double* c = coefficients + colBegin;
+
+            size_t i = rowBegin;
+            for (; i + 4 <= rowEnd; i += 4) {
+                const double* x0 = rows + i * features + colBegin;
+                const double* x1 = x0 + features;
+                const double* x2 = x1 + features;
+                const double* x3 = x2 + features;
+                double s0 = out[i], s1 = out[i + 1], s2 = out[i + 2], s3 = out[i + 3];
+                for (size_t j = 0; j < width; ++j) {
+                    s0 += c[j] * x0[j];
+                    s1 += c[j] * x1[j];
+                    s2 += c[j] * x2[j];
+                    s3 += c[j] * x3[j];
+                }
+                out[i] = s0;
+                out[i + 1] = s1;
+                out[i + 2] = s2;
+                out[i + 3] = s3;
+            }
+            for (; i < rowEnd; ++i) {
+                const double* x = rows + i * features + colBegin;
+                double sum = out[i];
+                for (size_t j = 0; j < width; ++j) {
+                    sum += c[j] * x[j];
+                }
+                out[i] = sum;
+            }
+        }
+    }
+}
+
+template <size_t... P>
+std::array<ScoringKernel::Kernel, sizeof...(P)> specializedKernels(std::index_sequence<P...>) {
+    return {{&scoreFixed<P + 1>...}};
+}
+
+// SPECIALIZED[p - 1] scores p features
+const std::array<ScoringKernel::Kernel, ScoringKernel::MAX_SPECIALIZED> SPECIALIZED =
+    specializedKernels(std::make_index_sequence<ScoringKernel::MAX_SPECIALIZED>());
+
+} // namespace
+
+// Default constructor: no features, every row scores the intercept
+ScoringKernel::ScoringKernel() : intercept(0.0), kernel(&scoreBlocked) {}
+
+// Pick the kernel for this feature count once
+ScoringKernel::ScoringKernel(const std::vector<double>& coefficients, double intercept)
+    : coefficients(coefficients), intercept(intercept), kernel(&scoreBlocked) {
+    if (isSpecialized()) {
+        kernel = SPECIALIZED[coefficients.size() - 1];
+    } else if (coefficients.size() <= MAX_ROW_LOOP) {
+        kernel = &scoreGeneric;
+    }
+}
+
+bool ScoringKernel::isSpecialized() const {
+    return !coefficients.empty() && coefficients.size() <= MAX_SPECIALIZED;
+}
+
+const char* ScoringKernel::kernelName() const {
+    if (isSpecialized()) {
+        return "unrolled";
+    }
+    return kernel == &scoreGeneric ? "generic" : "blocked";
+}
+
+// Untuned, one kernel call. Tuned (ScanTuning::PREDICT), tile by tile:
+// prefetch the input prefetchBytes ahead, and with streaming stores score
+// into an L1 tile that is copied out with non-temporal stores
+void ScoringKernel::score(const double* rows, size_t count, double* out) const {
+    ScanTuning::Settings tuning = ScanTuning::get(ScanTuning::PREDICT);
+    bool streaming = tuning.streamingStores && count >= STREAM_MIN_ROWS;
+    if (tuning.prefetchBytes == 0 && !streaming) {
+        kernel(coefficients.data(), coefficients.size(), intercept, rows, count, out);
+        return;
+    }
+
+    size_t features = coefficients.size();
+    const char* inputEnd = reinterpret_cast<const char*>(rows + count * features);
+    double tile[TILE_ROWS];
+    for (size_t begin = 0; begin < count; begin += TILE_ROWS) {
+        size_t tileRows = std::min(TILE_ROWS, count - begin);
+        const double* x = rows + begin * features;
+        if (tuning.prefetchBytes != 0) {
+            const char* first = reinterpret_cast<const char*>(x) + tuning.prefetchBytes;
+            const char* last = std::min(first + tileRows * features * sizeof(double), inputEnd);
+            for (const char* line = first; line < last; line += CACHE_LINE) {
+                ScanTuning::prefetch(line);
+            }
+        }
+        if (streaming) {
+            kernel(coefficients.data(), features, intercept, x, tileRows, tile);
+            ScanTuning::streamCopy(out + begin, tile, tileRows);
+        } else {
+            kernel(coefficients.data(), features, intercept, x, tileRows, out + begin);
+        }
+    }
+    if (streaming) {
+        ScanTuning::fence();
+    }
+}
+
+// Columns are read in place; vectorized across rows by the dispatched kernel
+void ScoringKernel::scoreColumns(const float* const* columns, size_t count, double* out) const {
+    CpuDispatch::kernels().scoreColumns(coefficients.data(), coefficients.size(), intercept, columns, count, out);
+}
+
+// Matrix rows are separate vectors (and views may be strided), so each block packs PACK_ROWS of them
+// into a contiguous buffer before calling the kernel
+std::vector<double> ScoringKernel::score(ConstMatrixView X) const {
+    size_t features = coefficients.size();
+    if (X.getCols() != features) {
+        throw std::invalid_argument("Design matrix column count does not match the model");
+    }
+
+    size_t n = X.getRows();
+    std::vector<double> result(n);
+    Parallel::parallelFor(n, ROW_GRAIN, [&](size_t, size_t begin, size_t end) {
+        std::vector<double> packed(PACK_ROWS * features);
+        for (size_t batchBegin = begin; batchBegin < end; batchBegin += PACK_ROWS) {
+            size_t batchEnd = std::min(end, batchBegin + PACK_ROWS);
+            for (size_t i = batchBegin; i < batchEnd; ++i) {
+                double* row = packed.data() + (i - batchBegin) * features;
+                for (size_t j = 0; j < features; ++j) {
+                    row[j] = X(i, j);
+                }
+            }
+            score(packed.data(), batchEnd - batchBegin, result.data() + batchBegin);
+        }
+    });
+    return result;
+}
+
+// One loop over coefficients.size() per row
+void ScoringKernel::scoreGeneric(const double* coefficients, size_t features, double intercept,
+                                 const double* rows, size_t count, double* out) {
+    for (size_t i = 0; i < count; ++i) {
+        const double* x = rows + i * features;
+        double sum = intercept;
+        for (size_t j = 0; j < features; ++j) {
+            sum += coefficients[j] * x[j];
+        }
+        out[i] = sum;
+    }
+}
@@ -0,0 +1,364 @@
+#include "../include/SharedDataset.h"
+#include "../include/Numa.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CPUPERF_HAVE_SHM 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char SEGMENT_MAGIC[8] = {'C', 'P', 'U', 'P', 'E', 'R', 'F', '1'};
+const uint32_t SEGMENT_VERSION = 1;
+const size_t SECTION_ALIGNMENT = 64;
+
+// Fixed-size header at offset 0; section offsets are from the segment start
+struct SegmentHeader {
+    char magic[8];                // written last
+    uint32_t version;
+    uint32_t featureCount;
+    uint64_t rows;
+    uint64_t entries;             // dictionary entries
+    uint64_t stringBytes;
+    uint64_t columnsOffset;       // COLUMN_COUNT x rows int32, column-major
+    uint64_t featuresOffset;      // rows x FEATURE_COUNT double, row-major
+    uint64_t codesOffset;         // rows vendor codes, then rows model codes
+    uint64_t entryOffsetsOffset;  // entries + 1 uint64
+    uint64_t stringsOffset;
+    uint64_t totalBytes;
+};
+
+size_t alignUp(size_t value) {
+    return (value + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+// shm_open wants "/name" with no further slashes
+bool segmentName(const std::string& name, std::string& path) {
+    path = !name.empty() && name[0] == '/' ? name : "/" + name;
+    if (path.size() < 2 || path.find('/', 1) != std::string::npos) {
+        std::cerr << "Error: Invalid shared segment name '" << name << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Section [offset, offset + bytes) is aligned and inside the segment
+bool sectionFits(uint64_t offset, uint64_t bytes, uint64_t total) {
+    return offset % SECTION_ALIGNMENT == 0 && offset >= sizeof(SegmentHeader) &&
+           offset <= total && bytes <= total - offset;
+}
+
+// Interns strings in first-seen order
+class Dictionary {
+public:
+    uint32_t intern(const std::string& value) {
+        auto found = codes.find(value);
+        if (found != codes.end()) {
+            return found->second;
+        }
+        uint32_t code = static_cast<uint32_t>(offsets.size() - 1);
+        codes.emplace(value, code);
+        strings += value;
+        offsets.push_back(strings.size());
+        return code;
+    }
+
+    const std::string& getStrings() const { return strings; }
+    const std::vector<uint64_t>& getOffsets() const { return offsets; }
+    size_t size() const { return offsets.size() - 1; }
+
+private:
+    std::unordered_map<std::string, uint32_t> codes;
+    std::string strings;
+    std::vector<uint64_t> offsets{0};
+};
+
+} // namespace
+
+// Constructor
+SharedDataset::SharedDataset() {
+    reset();
+}
+
+SharedDataset::~SharedDataset() {
+    detach();
+}
+
+SharedDataset::SharedDataset(SharedDataset&& other) noexcept {
+    take(other);
+}
+
+SharedDataset& SharedDataset::operator=(SharedDataset&& other) noexcept {
+    if (this != &other) {
+        detach();
+        take(other);
+    }
+    return *this;
+}
+
+void SharedDataset::reset() {
+    base = nullptr;
+    length = 0;
+    rows = 0;
+    entries = 0;
+    for (size_t c = 0; c < COLUMN_COUNT; ++c) {
+        columns[c] = nullptr;
+    }
+    features = nullptr;
+    vendorCodes = nullptr;
+    modelCodes = nullptr;
+    entryOffsets = nullptr;
+    strings = nullptr;
+}
+
+// Adopt another instance's mapping
+void SharedDataset::take(SharedDataset& other) {
+    base = other.base;
+    length = other.length;
+    rows = other.rows;
+    entries = other.entries;
+    for (size_t c = 0; c < COLUMN_COUNT; ++c) {
+        columns[c] = other.columns[c];
+    }
+    features = other.features;
+    vendorCodes = other.vendorCodes;
+    modelCodes = other.modelCodes;
+    entryOffsets = other.entryOffsets;
+    strings = other.strings;
+    other.reset();
+}
+
+std::string_view SharedDataset::entry(uint32_t code) const {
+    return std::string_view(strings + entryOffsets[code],
+                            static_cast<size_t>(entryOffsets[code + 1] - entryOffsets[code]));
+}
+
+// Copy back into an ordinary Dataset
+Dataset SharedDataset::toDataset() const {
+    Dataset result;
+    result.getData().reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        result.addDataPoint(DataPoint(std::string(getVendor(i)), std::string(getModel(i)),
+                                      columns[MYCT][i], columns[MMIN][i], columns[MMAX][i],
+                                      columns[CACH][i], columns[CHMIN][i], columns[CHMAX][i],
+                                      columns[PRP][i], columns[ERP][i]));
+    }
+    return result;
+}
+
+#ifdef CPUPERF_HAVE_SHM
+
+// Build the image in a fresh segment; readers reject it until the magic lands
+bool SharedDataset::publish(const Dataset& data, const std::string& name) {
+    std::string path;
+    if (!segmentName(name, path)) {
+        return false;
+    }
+
+    Dictionary dictionary;
+    std::vector<uint32_t> codes(2 * data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        codes[i] = dictionary.intern(data[i].getVendor());
+        codes[data.size() + i] = dictionary.intern(data[i].getModel());
+    }
+
+    SegmentHeader header{};
+    header.version = SEGMENT_VERSION;
+    header.featureCount = static_cast<uint32_t>(FEATURE_COUNT);
+    header.rows = data.size();
+    header.entries = dictionary.size();
+    header.stringBytes = dictionary.getStrings().size();
+    header.columnsOffset = alignUp(sizeof(SegmentHeader));
+    header.featuresOffset = alignUp(header.columnsOffset + COLUMN_COUNT * data.size() * sizeof(int32_t));
+    header.codesOffset = alignUp(header.featuresOffset + FEATURE_COUNT * data.size() * sizeof(double));
+    header.entryOffsetsOffset = alignUp(header.codesOffset + codes.size() * sizeof(uint32_t));
+    header.stringsOffset = alignUp(header.entryOffsetsOffset + (header.entries + 1) * sizeof(uint64_t));
+    header.totalBytes = alignUp(header.stringsOffset + header.stringBytes);
+
+    // Replace rather than overwrite, so processes still attached to an older
+    // image keep a consistent view of it
+    shm_unlink(path.c_str());
+    int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "Error: Cannot create shared segment " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(header.totalBytes)) != 0) {
+        std::cerr << "Error: Cannot size shared segment " << path << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        shm_unlink(path.c_str());
+        return false;
+    }
+    void* mapping = mmap(nullptr, header.totalBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: Cannot map shared segment " << path << ": " << std::strerror(errno) << std::endl;
+        shm_unlink(path.c_str());
+        return false;
+    }
+
+    // Readers may run on any socket: spread the pages instead of placing
+    // them all on the publisher's node
+    if (Numa::nodeCount() > 1) {
+        Numa::interleave(mapping, header.totalBytes);
+    }
+
+    unsigned char* image = static_cast<unsigned char*>(mapping);
+    int32_t* columnData = reinterpret_cast<int32_t*>(image + header.columnsOffset);
+    double* featureData = reinterpret_cast<double*>(image + header.featuresOffset);
+    size_t n = data.size();
+    for (size_t i = 0; i < n; ++i) {
+        const DataPoint& point = data[i];
+        const int32_t values[COLUMN_COUNT] = {point.getMYCT(), point.getMMIN(), point.getMMAX(),
+                                              point.getCACH(), point.getCHMIN(), point.getCHMAX(),
+                                              point.getPRP(), point.getERP()};
+        for (size_t c = 0; c < COLUMN_COUNT; ++c) {
+            columnData[c * n + i] = values[c];
+        }
+        for (size_t f = 0; f < FEATURE_COUNT; ++f) {
+            featureData[i * FEATURE_COUNT + f] = static_cast<double>(values[f]);
+        }
+    }
+    if (!codes.empty()) {
+        std::memcpy(image + header.codesOffset, codes.data(), codes.size() * sizeof(uint32_t));
+    }
+    std::memcpy(image + header.entryOffsetsOffset, dictionary.getOffsets().data(),
+                dictionary.getOffsets().size() * sizeof(uint64_t));
+    if (header.stringBytes > 0) {
+        std::memcpy(image + header.stringsOffset, dictionary.getStrings().data(), header.stringBytes);
+    }
+    std::memcpy(image, &header, sizeof(header));
+
+    // Everything above is visible before the magic that marks the image complete
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(image, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+
+    munmap(mapping, header.totalBytes);
+    return true;
+}
+
+bool SharedDataset::unpublish(const std::string& name) {
+    std::string path;
+    if (!segmentName(name, path)) {
+        return false;
+    }
+    if (shm_unlink(path.c_str()) != 0) {
+        std::cerr << "Error: Cannot remove shared segment " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Map read-only and validate every section before exposing pointers
+bool SharedDataset::attach(const std::string& name) {
+    detach();
+    std::string path;
+    if (!segmentName(name, path)) {
+        return false;
+    }
+    int fd = shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        std::cerr << "Error: Cannot open shared segment " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < sizeof(SegmentHeader)) {
+        std::cerr << "Error: Shared segment " << path << " is too small" << std::endl;
+        close(fd);
+        return false;
+    }
+    size_t total = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, total, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: Cannot map shared segment " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    const unsigned char* image = static_cast<const unsigned char*>(mapping);
+    SegmentHeader header;
+    std::memcpy(&header, image, sizeof(header));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    uint64_t n = header.rows;
+    bool valid = std::memcmp(header.magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) == 0 &&
+                 header.version == SEGMENT_VERSION && header.featureCount == FEATURE_COUNT &&
+                 header.totalBytes == total && n <= total / sizeof(double) &&
+                 header.entries < total / sizeof(uint64_t) &&
+                 sectionFits(header.columnsOffset, COLUMN_COUNT * n * sizeof(int32_t), total) &&
+                 sectionFits(header.featuresOffset, FEATURE_COUNT * n * sizeof(double), total) &&
+                 sectionFits(header.codesOffset, 2 * n * sizeof(uint32_t), total) &&
+                 sectionFits(header.entryOffsetsOffset, (header.entries + 1) * sizeof(uint64_t), total) &&
+                 sectionFits(header.stringsOffset, header.stringBytes, total);
+    if (valid) {
+        // Dictionary offsets ascend within the strings, and every code names an entry
+        const uint64_t* offsets = reinterpret_cast<const uint64_t*>(image + header.entryOffsetsOffset);
+        valid = offsets[0] == 0 && offsets[header.entries] == header.stringBytes;
+        for (uint64_t e = 0; valid && e < header.entries; ++e) {
+            valid = offsets[e] <= offsets[e + 1];
+        }
+        const uint32_t* codes = reinterpret_cast<const uint32_t*>(image + header.codesOffset);
+        for (uint64_t i = 0; valid && i < 2 * n; ++i) {
+            valid = codes[i] < header.entries;
+        }
+    }
+    if (!valid) {
+        std::cerr << "Error: Shared segment " << path << " is not a published dataset" << std::endl;
+        munmap(mapping, total);
+        return false;
+    }
+
+    base = image;
+    length = total;
+    rows = static_cast<size_t>(n);
+    entries = static_cast<size_t>(header.entries);
+    const int32_t* columnData = reinterpret_cast<const int32_t*>(image + header.columnsOffset);
+    for (size_t c = 0; c < COLUMN_COUNT; ++c) {
+        columns[c] = columnData + c * rows;
+    }
+    features = reinterpret_cast<const double*>(image + header.featuresOffset);
+    vendorCodes = reinterpret_cast<const uint32_t*>(image + header.codesOffset);
+    modelCodes = vendorCodes + rows;
+    entryOffsets = reinterpret_cast<const uint64_t*>(image + header.entryOffsetsOffset);
+    strings = reinterpret_cast<const char*>(image + header.stringsOffset);
+    return true;
+}
+
+void SharedDataset::detach() {
+    if (base != nullptr) {
+        munmap(const_cast<unsigned char*>(base), length);
+    }
+    reset();
+}
+
+#else
+
+bool SharedDataset::publish(const Dataset&, const std::string&) {
+    std::cerr << "Error: Shared datasets need POSIX shared memory" << std::endl;
+    return false;
+}
+
+bool SharedDataset::unpublish(const std::string&) {
+    return false;
+}
+
+bool SharedDataset::attach(const std::string&) {
+    std::cerr << "Error: Shared datasets need POSIX shared memory" << std::endl;
+    return false;
+}
+
+void SharedDataset::detach() {
+    reset();
+}
+
+#endif // CPUPERF_HAVE_SHM
@@ -0,0 +1,61 @@
+#include "../include/SimdKernels.h"
+
+// Built with -mavx2; without it (or off x86) this level is not offered
+namespace SimdKernels {
+
+#if defined(__AVX2__)
+namespace {
+
+struct Avx2Lane {
+    using Vec = __m256d;
+    static constexpr size_t WIDTH = 4;
+
+    static Vec load(const double* p) { return _mm256_loadu_pd(p); }
+    static Vec loadFloat(const float* p) { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+    static void store(double* p, Vec a) { _mm256_storeu_pd(p, a); }
+    static Vec set1(double a) { return _mm256_set1_pd(a); }
+    static Vec zero() { return _mm256_setzero_pd(); }
+    static Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+    static Vec absolute(Vec a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+
+    static void quadrant(Vec shifted, Vec s, Vec c, Vec& sine, Vec& cosine) {
+        const __m256i oneBit = _mm256_set1_epi64x(1);
+        const __m256i twoBit = _mm256_set1_epi64x(2);
+        __m256i q = _mm256_castpd_si256(shifted);
+        __m256d swap = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(q, oneBit), 63));
+        __m256d sinSign = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(q, twoBit), 62));
+        __m256d cosSign = _mm256_castsi256_pd(
+            _mm256_slli_epi64(_mm256_and_si256(_mm256_add_epi64(q, oneBit), twoBit), 62));
+        sine = _mm256_xor_pd(_mm256_blendv_pd(s, c, swap), sinSign);
+        cosine = _mm256_xor_pd(_mm256_blendv_pd(c, s, swap), cosSign);
+    }
+
+    static void classify(const char* p, char delimiter, uint64_t& delimiters, uint64_t& newlines) {
+        const __m256i delim = _mm256_set1_epi8(delimiter);
+        const __m256i newline = _mm256_set1_epi8('\n');
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        uint64_t dLo = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, delim)));
+        uint64_t dHi = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, delim)));
+        uint64_t nLo = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, newline)));
+        uint64_t nHi = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, newline)));
+        delimiters = dLo | (dHi << 32);
+        newlines = nLo | (nHi << 32);
+    }
+};
+
+} // namespace
+#endif
+
+const CpuDispatch::Kernels* avx2() {
+#if defined(__AVX2__)
+    static const CpuDispatch::Kernels kernels = makeKernels<Avx2Lane>(CpuDispatch::AVX2);
+    return &kernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace SimdKernels
@@ -0,0 +1,60 @@
+#include "../include/SimdKernels.h"
+
+// Built with -mavx512f -mavx512bw -mavx512dq -mavx512vl (the Skylake-SP
+// and Zen 4 subset); without them (or off x86) this level is not offered
+namespace SimdKernels {
+
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512DQ__)
+namespace {
+
+struct Avx512Lane {
+    using Vec = __m512d;
+    static constexpr size_t WIDTH = 8;
+
+    static Vec load(const double* p) { return _mm512_loadu_pd(p); }
+    // Zero-masked form: the plain one starts from _mm512_undefined_pd(), which GCC 12 reports
+    static Vec loadFloat(const float* p) { return _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(p)); }
+    static void store(double* p, Vec a) { _mm512_storeu_pd(p, a); }
+    static Vec set1(double a) { return _mm512_set1_pd(a); }
+    static Vec zero() { return _mm512_setzero_pd(); }
+    static Vec add(Vec a, Vec b) { return _mm512_add_pd(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm512_sub_pd(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm512_mul_pd(a, b); }
+    static Vec absolute(Vec a) { return _mm512_abs_pd(a); }
+
+    // Swap and both signs are mask registers
+    static void quadrant(Vec shifted, Vec s, Vec c, Vec& sine, Vec& cosine) {
+        const __m512i oneBit = _mm512_set1_epi64(1);
+        const __m512i twoBit = _mm512_set1_epi64(2);
+        const __m512d signBit = _mm512_set1_pd(-0.0);
+        __m512i q = _mm512_castpd_si512(shifted);
+        __mmask8 swap = _mm512_test_epi64_mask(q, oneBit);
+        __mmask8 sinNegative = _mm512_test_epi64_mask(q, twoBit);
+        __mmask8 cosNegative = _mm512_test_epi64_mask(_mm512_add_epi64(q, oneBit), twoBit);
+        __m512d sinValue = _mm512_mask_blend_pd(swap, s, c);
+        __m512d cosValue = _mm512_mask_blend_pd(swap, c, s);
+        sine = _mm512_mask_xor_pd(sinValue, sinNegative, sinValue, signBit);
+        cosine = _mm512_mask_xor_pd(cosValue, cosNegative, cosValue, signBit);
+    }
+
+    // One compare per character class yields the 64-bit bitmap directly
+    static void classify(const char* p, char delimiter, uint64_t& delimiters, uint64_t& newlines) {
+        __m512i block = _mm512_loadu_si512(p);
+        delimiters = _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8(delimiter));
+        newlines = _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8('\n'));
+    }
+};
+
+} // namespace
+#endif
+
+const CpuDispatch::Kernels* avx512() {
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512DQ__)
+    static const CpuDispatch::Kernels kernels = makeKernels<Avx512Lane>(CpuDispatch::AVX512);
+    return &kernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace SimdKernels
@@ -0,0 +1,15 @@
+#include "../include/SimdKernels.h"
+
+// Built with the project's generic flags: SSE2 on x86-64, scalar elsewhere
+namespace SimdKernels {
+
+const CpuDispatch::Kernels* baseline() {
+#if defined(__SSE2__)
+    static const CpuDispatch::Kernels kernels = makeKernels<Sse2Lane>(CpuDispatch::BASELINE);
+#else
+    static const CpuDispatch::Kernels kernels = makeKernels<ScalarLane>(CpuDispatch::BASELINE);
+#endif
+    return &kernels;
+}
+
+} // namespace SimdKernels
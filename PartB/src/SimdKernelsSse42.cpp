@@ -0,0 +1,35 @@
+#include "../include/SimdKernels.h"
+
+// Built with -msse4.2; without it (or off x86) this level is not offered
+namespace SimdKernels {
+
+#if defined(__SSE4_2__)
+namespace {
+
+// SSE2 lanes with blendv for the sin/cos quadrant swap
+struct Sse42Lane : Sse2Lane {
+    static void quadrant(Vec shifted, Vec s, Vec c, Vec& sine, Vec& cosine) {
+        const __m128i oneBit = _mm_set1_epi64x(1);
+        const __m128i twoBit = _mm_set1_epi64x(2);
+        __m128i q = _mm_castpd_si128(shifted);
+        __m128d swap = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(q, oneBit), 63));
+        __m128d sinSign = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(q, twoBit), 62));
+        __m128d cosSign = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(_mm_add_epi64(q, oneBit), twoBit), 62));
+        sine = _mm_xor_pd(_mm_blendv_pd(s, c, swap), sinSign);
+        cosine = _mm_xor_pd(_mm_blendv_pd(c, s, swap), cosSign);
+    }
+};
+
+} // namespace
+#endif
+
+const CpuDispatch::Kernels* sse42() {
+#if defined(__SSE4_2__)
+    static const CpuDispatch::Kernels kernels = makeKernels<Sse42Lane>(CpuDispatch::SSE42);
+    return &kernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace SimdKernels
@@ -0,0 +1,315 @@
+#include "../include/SparseMatrix.h"
+#include "../include/Parallel.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// Rows (or columns) per parallel block in the SpMV and multiply kernels
+const size_t ROW_GRAIN = 4096;
+// Gram rows per block; each row touches many entries, so blocks are smaller
+const size_t GRAM_GRAIN = 64;
+
+} // namespace
+
+// Default constructor
+SparseMatrix::SparseMatrix() : rows(0), cols(0), format(Format::CSR), pointers(1, 0) {}
+
+// All-zero matrix of the given size
+SparseMatrix::SparseMatrix(size_t rows, size_t cols, Format format)
+    : rows(rows), cols(cols), format(format),
+      pointers((format == Format::CSR ? rows : cols) + 1, 0) {}
+
+// Build from triplets
+SparseMatrix SparseMatrix::fromTriplets(size_t rows, size_t cols, std::vector<Triplet> triplets,
+                                        Format format) {
+    SparseMatrix result(rows, cols, format);
+    bool csr = format == Format::CSR;
+
+    for (const Triplet& t : triplets) {
+        if (t.row >= rows || t.col >= cols) {
+            throw std::out_of_range("Sparse matrix entry out of range");
+        }
+    }
+
+    std::sort(triplets.begin(), triplets.end(), [csr](const Triplet& a, const Triplet& b) {
+        size_t majorA = csr ? a.row : a.col, majorB = csr ? b.row : b.col;
+        size_t minorA = csr ? a.col : a.row, minorB = csr ? b.col : b.row;
+        return majorA != majorB ? majorA < majorB : minorA < minorB;
+    });
+
+    for (size_t i = 0; i < triplets.size();) {
+        size_t major = csr ? triplets[i].row : triplets[i].col;
+        size_t minor = csr ? triplets[i].col : triplets[i].row;
+        double sum = 0.0;
+        for (; i < triplets.size() && (csr ? triplets[i].row : triplets[i].col) == major &&
+               (csr ? triplets[i].col : triplets[i].row) == minor; ++i) {
+            sum += triplets[i].value;
+        }
+        if (sum != 0.0) {
+            result.indices.push_back(minor);
+            result.values.push_back(sum);
+            ++result.pointers[major + 1];
+        }
+    }
+    for (size_t m = 0; m < result.majorSize(); ++m) {
+        result.pointers[m + 1] += result.pointers[m];
+    }
+    return result;
+}
+
+// Build from a dense matrix
+SparseMatrix SparseMatrix::fromDense(const Matrix& dense, Format format) {
+    SparseMatrix result(dense.getRows(), dense.getCols(), Format::CSR);
+    for (size_t i = 0; i < dense.getRows(); ++i) {
+        const std::vector<double>& row = dense[i];
+        for (size_t j = 0; j < row.size(); ++j) {
+            if (row[j] != 0.0) {
+                result.indices.push_back(j);
+                result.values.push_back(row[j]);
+            }
+        }
+        result.pointers[i + 1] = result.values.size();
+    }
+    return format == Format::CSR ? result : result.convert();
+}
+
+// Fraction of stored entries
+double SparseMatrix::density() const {
+    if (rows == 0 || cols == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(values.size()) / (static_cast<double>(rows) * cols);
+}
+
+// Element lookup
+double SparseMatrix::at(size_t row, size_t col) const {
+    if (row >= rows || col >= cols) {
+        throw std::out_of_range("Sparse matrix indices out of range");
+    }
+    size_t major = format == Format::CSR ? row : col;
+    size_t minor = format == Format::CSR ? col : row;
+    auto begin = indices.begin() + pointers[major];
+    auto end = indices.begin() + pointers[major + 1];
+    auto it = std::lower_bound(begin, end, minor);
+    return (it != end && *it == minor) ? values[it - indices.begin()] : 0.0;
+}
+
+// Counting-sort transposition of the storage into the other layout
+SparseMatrix SparseMatrix::convert() const {
+    Format other = format == Format::CSR ? Format::CSC : Format::CSR;
+    SparseMatrix result(rows, cols, other);
+    result.indices.resize(values.size());
+    result.values.resize(values.size());
+
+    for (size_t e = 0; e < indices.size(); ++e) {
+        ++result.pointers[indices[e] + 1];
+    }
+    for (size_t m = 0; m < minorSize(); ++m) {
+        result.pointers[m + 1] += result.pointers[m];
+    }
+
+    // Walking majors in order keeps the new minor indices sorted
+    std::vector<size_t> next(result.pointers.begin(), result.pointers.end() - 1);
+    for (size_t major = 0; major < majorSize(); ++major) {
+        for (size_t e = pointers[major]; e < pointers[major + 1]; ++e) {
+            size_t slot = next[indices[e]]++;
+            result.indices[slot] = major;
+            result.values[slot] = values[e];
+        }
+    }
+    return result;
+}
+
+SparseMatrix SparseMatrix::toCSR() const {
+    return format == Format::CSR ? *this : convert();
+}
+
+SparseMatrix SparseMatrix::toCSC() const {
+    return format == Format::CSC ? *this : convert();
+}
+
+// CSR of A is CSC of A^T, so only the dimensions and layout tag change
+SparseMatrix SparseMatrix::transpose() const {
+    SparseMatrix result(*this);
+    std::swap(result.rows, result.cols);
+    result.format = format == Format::CSR ? Format::CSC : Format::CSR;
+    return result;
+}
+
+// Dense copy
+Matrix SparseMatrix::toDense() const {
+    Matrix result(rows, cols);
+    for (size_t major = 0; major < majorSize(); ++major) {
+        for (size_t e = pointers[major]; e < pointers[major + 1]; ++e) {
+            if (format == Format::CSR) {
+                result[major][indices[e]] = values[e];
+            } else {
+                result[indices[e]][major] = values[e];
+            }
+        }
+    }
+    return result;
+}
+
+// One dot product per major slice; blocks of slices run in parallel
+std::vector<double> SparseMatrix::gatherMultiply(const std::vector<double>& x) const {
+    std::vector<double> y(majorSize(), 0.0);
+    Parallel::parallelFor(majorSize(), ROW_GRAIN, [&](size_t, size_t begin, size_t end) {
+        for (size_t major = begin; major < end; ++major) {
+            double sum = 0.0;
+            for (size_t e = pointers[major]; e < pointers[major + 1]; ++e) {
+                sum += values[e] * x[indices[e]];
+            }
+            y[major] = sum;
+        }
+    });
+    return y;
+}
+
+// Each block scatters into its own partial vector; the partials are summed
+std::vector<double> SparseMatrix::scatterMultiply(const std::vector<double>& x) const {
+    size_t blocks = Parallel::blockCount(majorSize(), ROW_GRAIN);
+    std::vector<std::vector<double>> partial(std::max<size_t>(blocks, 1),
+                                             std::vector<double>(minorSize(), 0.0));
+
+    Parallel::parallelFor(majorSize(), ROW_GRAIN, [&](size_t block, size_t begin, size_t end) {
+        std::vector<double>& y = partial[block];
+        for (size_t major = begin; major < end; ++major) {
+            double xm = x[major];
+            for (size_t e = pointers[major]; e < pointers[major + 1]; ++e) {
+                y[indices[e]] += values[e] * xm;
+            }
+        }
+    });
+
+    std::vector<double>& y = partial[0];
+    for (size_t b = 1; b < partial.size(); ++b) {
+        for (size_t m = 0; m < y.size(); ++m) {
+            y[m] += partial[b][m];
+        }
+    }
+    return std::move(y);
+}
+
+// A * x
+std::vector<double> SparseMatrix::multiply(const std::vector<double>& x) const {
+    if (x.size() != cols) {
+        throw std::invalid_argument("Vector size does not match sparse matrix columns");
+    }
+    return format == Format::CSR ? gatherMultiply(x) : scatterMultiply(x);
+}
+
+// A^T * x
+std::vector<double> SparseMatrix::transposeMultiply(const std::vector<double>& x) const {
+    if (x.size() != rows) {
+        throw std::invalid_argument("Vector size does not match sparse matrix rows");
+    }
+    return format == Format::CSC ? gatherMultiply(x) : scatterMultiply(x);
+}
+
+// Sparse * dense, parallel by row blocks of the CSR form
+Matrix SparseMatrix::multiply(const Matrix& dense) const {
+    if (dense.getRows() != cols) {
+        throw std::invalid_argument("Matrix dimensions incompatible for multiplication");
+    }
+
+    SparseMatrix converted;
+    const SparseMatrix* csr = this;
+    if (format != Format::CSR) {
+        converted = convert();
+        csr = &converted;
+    }
+
+    size_t k = dense.getCols();
+    Matrix result(rows, k);
+    Parallel::parallelFor(rows, ROW_GRAIN / 4, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            std::vector<double>& out = result[i];
+            for (size_t e = csr->pointers[i]; e < csr->pointers[i + 1]; ++e) {
+                const std::vector<double>& row = dense[csr->indices[e]];
+                double v = csr->values[e];
+                for (size_t t = 0; t < k; ++t) {
+                    out[t] += v * row[t];
+                }
+            }
+        }
+    });
+    return result;
+}
+
+// A^T A row by row (Gustavson): row j combines the rows of A that column j touches
+SparseMatrix SparseMatrix::gram() const {
+    SparseMatrix csrStorage, cscStorage;
+    const SparseMatrix* csr = this;
+    const SparseMatrix* csc = this;
+    if (format == Format::CSR) {
+        cscStorage = convert();
+        csc = &cscStorage;
+    } else {
+        csrStorage = convert();
+        csr = &csrStorage;
+    }
+
+    struct BlockRows {
+        std::vector<size_t> counts;
+        std::vector<size_t> indices;
+        std::vector<double> values;
+    };
+    size_t blocks = std::max<size_t>(1, Parallel::blockCount(cols, GRAM_GRAIN));
+    std::vector<BlockRows> output(blocks);
+
+    Parallel::parallelFor(cols, GRAM_GRAIN, [&](size_t block, size_t begin, size_t end) {
+        BlockRows& out = output[block];
+        std::vector<double> accumulator(cols, 0.0);
+        std::vector<size_t> marker(cols, static_cast<size_t>(-1));
+        std::vector<size_t> touched;
+
+        for (size_t j = begin; j < end; ++j) {
+            touched.clear();
+            for (size_t e = csc->pointers[j]; e < csc->pointers[j + 1]; ++e) {
+                size_t i = csc->indices[e];
+                double v = csc->values[e];
+                for (size_t f = csr->pointers[i]; f < csr->pointers[i + 1]; ++f) {
+                    size_t k = csr->indices[f];
+                    if (marker[k] != j) {
+                        marker[k] = j;
+                        accumulator[k] = 0.0;
+                        touched.push_back(k);
+                    }
+                    accumulator[k] += v * csr->values[f];
+                }
+            }
+            std::sort(touched.begin(), touched.end());
+            for (size_t k : touched) {
+                out.indices.push_back(k);
+                out.values.push_back(accumulator[k]);
+            }
+            out.counts.push_back(touched.size());
+        }
+    });
+
+    SparseMatrix result(cols, cols, Format::CSR);
+    size_t row = 0;
+    for (BlockRows& out : output) {
+        for (size_t count : out.counts) {
+            result.pointers[row + 1] = result.pointers[row] + count;
+            ++row;
+        }
+        result.indices.insert(result.indices.end(), out.indices.begin(), out.indices.end());
+        result.values.insert(result.values.end(), out.values.begin(), out.values.end());
+    }
+    return result;
+}
+
+// Squared column norms
+std::vector<double> SparseMatrix::columnSquaredNorms() const {
+    std::vector<double> norms(cols, 0.0);
+    for (size_t major = 0; major < majorSize(); ++major) {
+        for (size_t e = pointers[major]; e < pointers[major + 1]; ++e) {
+            size_t col = format == Format::CSR ? indices[e] : major;
+            norms[col] += values[e] * values[e];
+        }
+    }
+    return norms;
+}
@@ -0,0 +1,311 @@
+#include "../include/StreamingPipeline.h"
+#include "../include/CsvScanner.h"
+#include "../include/FileIO.h"
+#include "../include/SpscQueue.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Parsed integer fields, 8 per row: MYCT, MMIN, MMAX, CACH, CHMIN, CHMAX, PRP, ERP
+struct RecordBatch {
+    std::vector<int> values;
+    size_t rows = 0;
+};
+
+// Feature columns plus per-row train/test weights
+struct ColumnBatch {
+    std::array<std::vector<double>, 6> columns;
+    std::vector<double> target;
+    std::vector<double> trainWeight;
+    std::vector<double> testWeight;
+    size_t rows = 0;
+};
+
+const size_t RECORD_FIELDS = 8;
+
+// SplitMix64 finalizer, used to hash row indices
+uint64_t mix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Blocking push that accounts the time spent waiting for room
+template <typename T>
+void timedPush(SpscQueue<T>& queue, T item, StreamingPipeline::StageMetrics& metrics) {
+    Clock::time_point start = Clock::now();
+    queue.push(std::move(item));
+    metrics.outputWaitSeconds += secondsSince(start);
+}
+
+// Blocking pop that accounts the time spent waiting for input
+template <typename T>
+bool timedPop(SpscQueue<T>& queue, T& item, StreamingPipeline::StageMetrics& metrics) {
+    Clock::time_point start = Clock::now();
+    bool ok = queue.pop(item);
+    metrics.inputWaitSeconds += secondsSince(start);
+    return ok;
+}
+
+} // namespace
+
+// Constructors
+StreamingPipeline::StreamingPipeline() : StreamingPipeline(PipelineConfig()) {}
+
+StreamingPipeline::StreamingPipeline(const PipelineConfig& config)
+    : config(config), trainStats(6), testStats(6) {
+    if (config.trainRatio < 0.0 || config.trainRatio > 1.0) {
+        throw std::invalid_argument("Train ratio must be between 0 and 1");
+    }
+    if (config.batchRows == 0 || config.queueCapacity == 0) {
+        throw std::invalid_argument("Batch size and queue capacity must be positive");
+    }
+}
+
+// Hash-based Bernoulli assignment, independent of arrival order
+bool StreamingPipeline::isTrainingRow(uint64_t rowIndex) const {
+    double u = static_cast<double>(mix64(config.seed ^ mix64(rowIndex)) >> 11) * 0x1.0p-53;
+    return u < config.trainRatio;
+}
+
+// Run all four stages over one read of the file
+bool StreamingPipeline::run(const std::string& filename, LinearRegression& model) {
+    FileReader reader;
+    if (!reader.open(filename)) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+
+    trainStats.clear();
+    testStats.clear();
+    result = Result();
+    result.stages.resize(4);
+    result.stages[0].name = "reader";
+    result.stages[1].name = "parser";
+    result.stages[2].name = "transform";
+    result.stages[3].name = "accumulate";
+
+    SpscQueue<std::string> textQueue(config.queueCapacity);
+    SpscQueue<RecordBatch> recordQueue(config.queueCapacity);
+    SpscQueue<ColumnBatch> columnQueue(config.queueCapacity);
+    std::atomic<bool> failed(false);
+    Clock::time_point wallStart = Clock::now();
+
+    // Stage 1: line-aligned text chunks
+    std::thread readerThread([&]() {
+        StageMetrics& metrics = result.stages[0];
+        std::string carry;
+        bool ok = reader.readBlocks([&](const char* block, size_t length) {
+            Clock::time_point start = Clock::now();
+            size_t end = length;
+            while (end > 0 && block[end - 1] != '\n') {
+                --end;
+            }
+            if (end == 0) {
+                carry.append(block, length);  // no line break in this block yet
+                metrics.busySeconds += secondsSince(start);
+                return true;
+            }
+
+            std::string chunk;
+            chunk.reserve(carry.size() + end);
+            chunk.append(carry).append(block, end);
+            carry.assign(block + end, length - end);
+
+            // Bytes are counted as they leave the stage, so a carried
+            // partial line is counted once, with the chunk that ends it
+            metrics.batches++;
+            metrics.bytes += chunk.size();
+            metrics.busySeconds += secondsSince(start);
+            timedPush(textQueue, std::move(chunk), metrics);
+            return true;
+        });
+        if (!carry.empty()) {
+            metrics.batches++;
+            metrics.bytes += carry.size();
+            timedPush(textQueue, std::move(carry), metrics);
+        }
+        if (!ok) {
+            std::cerr << "Error: Failed while reading " << filename << std::endl;
+            failed = true;
+        }
+        textQueue.close();
+    });
+
+    // Stage 2: structural scan and integer parsing
+    std::thread parserThread([&]() {
+        StageMetrics& metrics = result.stages[1];
+        RecordBatch batch;
+        batch.values.reserve(config.batchRows * RECORD_FIELDS);
+        size_t lineNumber = 1;
+        std::string chunk;
+
+        while (timedPop(textQueue, chunk, metrics)) {
+            Clock::time_point start = Clock::now();
+            std::vector<RecordBatch> ready;
+            lineNumber += CsvScanner::forEachRecord(chunk.data(), chunk.size(),
+                [&](const CsvScanner::Field* fields, size_t count, size_t line) {
+                    DataPoint point;
+                    if (!Dataset::parseRecord(fields, count, line, point)) {
+                        return;
+                    }
+                    int values[RECORD_FIELDS] = {point.getMYCT(), point.getMMIN(), point.getMMAX(),
+                                                 point.getCACH(), point.getCHMIN(), point.getCHMAX(),
+                                                 point.getPRP(), point.getERP()};
+                    batch.values.insert(batch.values.end(), values, values + RECORD_FIELDS);
+                    if (++batch.rows == config.batchRows) {
+                        ready.push_back(std::move(batch));
+                        batch = RecordBatch();
+                        batch.values.reserve(config.batchRows * RECORD_FIELDS);
+                    }
+                }, lineNumber);
+            metrics.bytes += chunk.size();
+            metrics.busySeconds += secondsSince(start);
+
+            for (RecordBatch& full : ready) {
+                metrics.batches++;
+                metrics.rows += full.rows;
+                timedPush(recordQueue, std::move(full), metrics);
+            }
+        }
+        if (batch.rows > 0) {
+            metrics.batches++;
+            metrics.rows += batch.rows;
+            timedPush(recordQueue, std::move(batch), metrics);
+        }
+        recordQueue.close();
+    });
+
+    // Stage 3: column layout and train/test routing
+    std::thread transformThread([&]() {
+        StageMetrics& metrics = result.stages[2];
+        RecordBatch records;
+        uint64_t rowIndex = 0;
+
+        while (timedPop(recordQueue, records, metrics)) {
+            Clock::time_point start = Clock::now();
+            ColumnBatch batch;
+            batch.rows = records.rows;
+            for (auto& column : batch.columns) {
+                column.resize(records.rows);
+            }
+            batch.target.resize(records.rows);
+            batch.trainWeight.resize(records.rows);
+            batch.testWeight.resize(records.rows);
+
+            for (size_t i = 0; i < records.rows; ++i) {
+                const int* row = &records.values[i * RECORD_FIELDS];
+                for (size_t j = 0; j < 6; ++j) {
+                    batch.columns[j][i] = static_cast<double>(row[j]);
+                }
+                batch.target[i] = static_cast<double>(row[6]);
+                bool train = isTrainingRow(rowIndex++);
+                batch.trainWeight[i] = train ? 1.0 : 0.0;
+                batch.testWeight[i] = train ? 0.0 : 1.0;
+            }
+
+            metrics.batches++;
+            metrics.rows += records.rows;
+            metrics.bytes += records.rows * 6 * sizeof(double);
+            metrics.busySeconds += secondsSince(start);
+            timedPush(columnQueue, std::move(batch), metrics);
+        }
+        columnQueue.close();
+    });
+
+    // Stage 4: X^T X / X^T y accumulation for both splits
+    std::thread accumulateThread([&]() {
+        StageMetrics& metrics = result.stages[3];
+        ColumnBatch batch;
+
+        while (timedPop(columnQueue, batch, metrics)) {
+            Clock::time_point start = Clock::now();
+            const double* columns[6];
+            for (size_t j = 0; j < 6; ++j) {
+                columns[j] = batch.columns[j].data();
+            }
+            trainStats.addColumns(columns, batch.target.data(), batch.rows, batch.trainWeight.data());
+            testStats.addColumns(columns, batch.target.data(), batch.rows, batch.testWeight.data());
+
+            metrics.batches++;
+            metrics.rows += batch.rows;
+            metrics.bytes += batch.rows * 6 * sizeof(double);
+            metrics.busySeconds += secondsSince(start);
+        }
+    });
+
+    readerThread.join();
+    parserThread.join();
+    transformThread.join();
+    accumulateThread.join();
+    reader.close();
+
+    if (failed) {
+        return false;
+    }
+
+    // Solve on the training statistics, score on the test statistics
+    if (!model.trainFromNormalEquations(trainStats, config.lambda)) {
+        return false;
+    }
+
+    result.coefficients = model.getCoefficients();
+    result.trainRows = trainStats.getCount();
+    result.testRows = testStats.getCount();
+    result.trainRMSE = std::sqrt(trainStats.residualSumSquares(result.coefficients) / result.trainRows);
+    if (result.testRows > 0.0) {
+        double rss = testStats.residualSumSquares(result.coefficients);
+        double tss = testStats.totalSumSquares();
+        result.testMSE = rss / result.testRows;
+        result.testRMSE = std::sqrt(result.testMSE);
+        result.testRSquared = tss == 0.0 ? 1.0 : 1.0 - rss / tss;
+    }
+    result.wallSeconds = secondsSince(wallStart);
+    return true;
+}
+
+// Display results and per-stage throughput
+void StreamingPipeline::displayResults() const {
+    std::cout << "\n=== Streaming Pipeline ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << "Training rows:   " << std::setprecision(0) << result.trainRows << std::endl;
+    std::cout << "Test rows:       " << result.testRows << std::endl;
+    std::cout << std::setprecision(4);
+    std::cout << "Training RMSE:   " << result.trainRMSE << std::endl;
+    std::cout << "Test RMSE:       " << result.testRMSE << std::endl;
+    std::cout << "Test MSE:        " << result.testMSE << std::endl;
+    std::cout << "Test R²:         " << result.testRSquared << std::endl;
+    std::cout << "Wall time:       " << result.wallSeconds * 1000.0 << " ms" << std::endl;
+
+    std::cout << "\n" << std::setw(12) << "Stage" << std::setw(10) << "Batches"
+              << std::setw(12) << "Rows" << std::setw(10) << "MB"
+              << std::setw(11) << "Busy ms" << std::setw(11) << "Starved"
+              << std::setw(11) << "Blocked" << std::setw(12) << "MB/s" << std::endl;
+    std::cout << std::string(89, '-') << std::endl;
+
+    for (const StageMetrics& stage : result.stages) {
+        double megabytes = stage.bytes / (1024.0 * 1024.0);
+        double throughput = stage.busySeconds > 0.0 ? megabytes / stage.busySeconds : 0.0;
+        std::cout << std::setw(12) << stage.name
+                  << std::setw(10) << stage.batches
+                  << std::setw(12) << stage.rows
+                  << std::setw(10) << std::setprecision(2) << megabytes
+                  << std::setw(11) << stage.busySeconds * 1000.0
+                  << std::setw(11) << stage.inputWaitSeconds * 1000.0
+                  << std::setw(11) << stage.outputWaitSeconds * 1000.0
+                  << std::setw(12) << throughput << std::endl;
+    }
+}
@@ -0,0 +1,120 @@
+#include "../include/Summation.h"
+#include "../include/CpuDispatch.h"
+#include "../include/Parallel.h"
+#include "../include/ScanTuning.h"
+#include <algorithm>
+
+namespace {
+
+// Pairwise recursion stops at blocks this small and sums them in a loop
+const size_t PAIRWISE_BLOCK = 128;
+// parallelSum chunk; fixed so the merge order never depends on the thread count
+const size_t PARALLEL_CHUNK = 1 << 16;
+
+// Lane sums from the dispatched kernel (REDUCE_LANES sums, then their
+// errors) merged in lane order with Kahan-Babuska; the tail is scalar, so
+// the result is the same at every instruction-set level. run(ahead, lanes)
+// calls the kernel, termAt(i) is the scalar term of element i
+template <typename Run, typename TermAt>
+double compensatedSum(Run run, TermAt termAt, size_t n) {
+    Summation::KahanBabuska total;
+    double lanes[2 * CpuDispatch::REDUCE_LANES];
+    // METRICS tuning: prefetch the inputs a fixed distance ahead
+    size_t ahead = ScanTuning::get(ScanTuning::METRICS).prefetchBytes / sizeof(double);
+    size_t i = run(ahead, lanes);
+    if (i != 0) {
+        for (double lane : lanes) {
+            total.add(lane);
+        }
+    }
+    for (; i < n; ++i) {
+        total.add(termAt(i));
+    }
+    return total.value();
+}
+
+template <typename Term>
+double compensatedReduce(CpuDispatch::Kernels::Reduce kernel, Term term,
+                         const double* a, const double* b, size_t n) {
+    return compensatedSum([&](size_t ahead, double* lanes) { return kernel(a, b, n, ahead, lanes); },
+                          [&](size_t i) { return term(a[i], b[i]); }, n);
+}
+
+double pairwiseRange(const double* values, size_t n) {
+    if (n <= PAIRWISE_BLOCK) {
+        double sum = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += values[i];
+        }
+        return sum;
+    }
+    size_t half = n / 2;
+    return pairwiseRange(values, half) + pairwiseRange(values + half, n - half);
+}
+
+} // namespace
+
+namespace Summation {
+
+// Left to right, one rounding per term
+double naive(const double* values, size_t n) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+double pairwise(const double* values, size_t n) {
+    return pairwiseRange(values, n);
+}
+
+// Scalar Kahan-Babuska, one term at a time
+double kahanBabuska(const double* values, size_t n) {
+    KahanBabuska total;
+    for (size_t i = 0; i < n; ++i) {
+        total.add(values[i]);
+    }
+    return total.value();
+}
+
+double compensated(const double* values, size_t n) {
+    return compensatedReduce(CpuDispatch::kernels().values,
+                             [](double a, double) { return a; }, values, values, n);
+}
+
+double dot(const double* a, const double* b, size_t n) {
+    return compensatedReduce(CpuDispatch::kernels().products,
+                             [](double x, double y) { return x * y; }, a, b, n);
+}
+
+double squaredDifferences(const double* a, const double* b, size_t n) {
+    return compensatedReduce(CpuDispatch::kernels().squaredDifferences,
+                             [](double x, double y) { return (x - y) * (x - y); }, a, b, n);
+}
+
+double absoluteDifferences(const double* a, const double* b, size_t n) {
+    return compensatedReduce(CpuDispatch::kernels().absoluteDifferences,
+                             [](double x, double y) { return std::abs(x - y); }, a, b, n);
+}
+
+double squaredDeviations(const double* values, size_t n, double center) {
+    CpuDispatch::Kernels::ReduceAbout kernel = CpuDispatch::kernels().squaredDeviations;
+    return compensatedSum([&](size_t ahead, double* lanes) { return kernel(values, center, n, ahead, lanes); },
+                          [&](size_t i) { return (values[i] - center) * (values[i] - center); }, n);
+}
+
+// Chunks are summed independently and merged in order
+double parallelSum(const double* values, size_t n) {
+    size_t chunks = (n + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+    std::vector<double> partials(chunks, 0.0);
+    Parallel::parallelFor(chunks, 1, [&](size_t, size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            size_t first = c * PARALLEL_CHUNK;
+            partials[c] = compensated(values + first, std::min(n, first + PARALLEL_CHUNK) - first);
+        }
+    });
+    return kahanBabuska(partials.data(), chunks);
+}
+
+} // namespace Summation
@@ -0,0 +1,235 @@
+#include "../include/cpuperf.h"
+#include "../include/Dataset.h"
+#include "../include/DriftMonitor.h"
+#include "../include/LinearRegression.h"
+#include "../include/ScoringKernel.h"
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Handle behind the C API: the coefficients and the kernel that scores them.
+// Never modified after creation, so concurrent predicts need no locking; the
+// optional drift monitor synchronizes internally
+struct cpuperf_model {
+    std::vector<double> coefficients;
+    ScoringKernel scorer;
+    std::unique_ptr<DriftMonitor> monitor;
+
+    explicit cpuperf_model(const std::vector<double>& coefficients)
+        : coefficients(coefficients), scorer(coefficients) {}
+};
+
+namespace {
+
+thread_local std::string lastError;
+
+int fail(int status, const std::string& message) {
+    lastError = message;
+    return status;
+}
+
+cpuperf_model* failNull(int status, const std::string& message) {
+    fail(status, message);
+    return nullptr;
+}
+
+// Hand scored rows to the drift monitor, if any; a failed allocation only
+// loses the sample, never the predictions
+void monitorRows(const cpuperf_model* model, const double* rows, size_t n) {
+    if (model->monitor) {
+        try {
+            model->monitor->observe(rows, n);
+        } catch (const std::exception&) {
+        }
+    }
+}
+
+void monitorColumns(const cpuperf_model* model, const float* const* columns, size_t n) {
+    if (model->monitor) {
+        try {
+            model->monitor->observeColumns(columns, n);
+        } catch (const std::exception&) {
+        }
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+int cpuperf_api_version(void) {
+    return CPUPERF_API_VERSION;
+}
+
+const char* cpuperf_status_string(int status) {
+    switch (status) {
+        case CPUPERF_OK: return "ok";
+        case CPUPERF_INVALID_ARGUMENT: return "invalid argument";
+        case CPUPERF_IO_ERROR: return "I/O error";
+        case CPUPERF_TRAINING_FAILED: return "training failed";
+        case CPUPERF_INTERNAL_ERROR: return "internal error";
+        default: return "unknown status";
+    }
+}
+
+const char* cpuperf_last_error(void) {
+    return lastError.c_str();
+}
+
+cpuperf_model* cpuperf_model_train(const char* data_path, double lambda) {
+    if (data_path == nullptr || lambda < 0.0) {
+        return failNull(CPUPERF_INVALID_ARGUMENT, "cpuperf_model_train: null path or negative lambda");
+    }
+    try {
+        Dataset dataset;
+        dataset.setQuiet(true);
+        if (!dataset.loadFromFile(data_path)) {
+            return failNull(CPUPERF_IO_ERROR, std::string("Could not load ") + data_path + ": " +
+                                                  dataset.getLastError());
+        }
+        LinearRegression model;
+        model.setQuiet(true);
+        bool trained = lambda > 0.0 ? model.trainWithRegularization(dataset, lambda) : model.train(dataset);
+        if (!trained) {
+            return failNull(CPUPERF_TRAINING_FAILED, std::string("Could not train a model from ") + data_path +
+                                                         ": " + model.getLastError());
+        }
+        return new cpuperf_model(model.getCoefficients());
+    } catch (const std::exception& e) {
+        return failNull(CPUPERF_INTERNAL_ERROR, e.what());
+    }
+}
+
+cpuperf_model* cpuperf_model_load(const char* path) {
+    if (path == nullptr) {
+        return failNull(CPUPERF_INVALID_ARGUMENT, "cpuperf_model_load: null path");
+    }
+    try {
+        LinearRegression model;
+        model.setQuiet(true);
+        if (!model.load(path)) {
+            return failNull(CPUPERF_IO_ERROR, std::string("Could not load a model from ") + path + ": " +
+                                                  model.getLastError());
+        }
+        if (model.getCoefficients().size() != CPUPERF_FEATURES) {
+            return failNull(CPUPERF_INVALID_ARGUMENT, std::string(path) + " holds a model over " +
+                                                          std::to_string(model.getCoefficients().size()) +
+                                                          " features; the C API expects 6");
+        }
+        return new cpuperf_model(model.getCoefficients());
+    } catch (const std::exception& e) {
+        return failNull(CPUPERF_INTERNAL_ERROR, e.what());
+    }
+}
+
+cpuperf_model* cpuperf_model_create(const double* coefficients, size_t count) {
+    if (coefficients == nullptr || count != CPUPERF_FEATURES) {
+        return failNull(CPUPERF_INVALID_ARGUMENT, "cpuperf_model_create: expected 6 coefficients");
+    }
+    try {
+        return new cpuperf_model(std::vector<double>(coefficients, coefficients + count));
+    } catch (const std::exception& e) {
+        return failNull(CPUPERF_INTERNAL_ERROR, e.what());
+    }
+}
+
+void cpuperf_model_free(cpuperf_model* model) {
+    delete model;
+}
+
+int cpuperf_model_coefficients(const cpuperf_model* model, double* out, size_t count) {
+    if (model == nullptr || out == nullptr || count < model->coefficients.size()) {
+        return fail(CPUPERF_INVALID_ARGUMENT, "cpuperf_model_coefficients: null argument or short buffer");
+    }
+    for (size_t i = 0; i < model->coefficients.size(); ++i) {
+        out[i] = model->coefficients[i];
+    }
+    return CPUPERF_OK;
+}
+
+int cpuperf_predict(const cpuperf_model* model, const double* rows, size_t n, double* out) {
+    if (model == nullptr || ((rows == nullptr || out == nullptr) && n != 0)) {
+        return fail(CPUPERF_INVALID_ARGUMENT, "cpuperf_predict: null argument");
+    }
+    model->scorer.score(rows, n, out);
+    monitorRows(model, rows, n);
+    return CPUPERF_OK;
+}
+
+int cpuperf_predict_batch(const cpuperf_model* model, const float* cols, size_t n, double* out) {
+    if (model == nullptr || ((cols == nullptr || out == nullptr) && n != 0)) {
+        return fail(CPUPERF_INVALID_ARGUMENT, "cpuperf_predict_batch: null argument");
+    }
+    const float* columns[CPUPERF_FEATURES];
+    for (size_t j = 0; j < CPUPERF_FEATURES; ++j) {
+        columns[j] = cols + j * n;
+    }
+    model->scorer.scoreColumns(columns, n, out);
+    monitorColumns(model, columns, n);
+    return CPUPERF_OK;
+}
+
+int cpuperf_predict_columns(const cpuperf_model* model, const float* const* columns, size_t n, double* out) {
+    if (model == nullptr || ((columns == nullptr || out == nullptr) && n != 0)) {
+        return fail(CPUPERF_INVALID_ARGUMENT, "cpuperf_predict_columns: null argument");
+    }
+    for (size_t j = 0; j < CPUPERF_FEATURES && n != 0; ++j) {
+        if (columns[j] == nullptr) {
+            return fail(CPUPERF_INVALID_ARGUMENT, "cpuperf_predict_columns: null column");
+        }
+    }
+    model->scorer.scoreColumns(columns, n, out);
+    monitorColumns(model, columns, n);
+    return CPUPERF_OK;
+}
+
+int cpuperf_model_monitor_drift(cpuperf_model* model, const char* baseline_path, size_t sample_stride) {
+    if (model == nullptr || baseline_path == nullptr) {
+        return fail(CPUPERF_INVALID_ARGUMENT, "cpuperf_model_monitor_drift: null argument");
+    }
+    try {
+        DriftBaseline baseline;
+        baseline.setQuiet(true);
+        if (!baseline.load(baseline_path)) {
+            return fail(CPUPERF_IO_ERROR, std::string("Could not load a drift baseline from ") + baseline_path +
+                                              ": " + baseline.getLastError());
+        }
+        if (baseline.featureCount() != CPUPERF_FEATURES) {
+            return fail(CPUPERF_INVALID_ARGUMENT, "cpuperf_model_monitor_drift: baseline has the wrong feature count");
+        }
+        DriftConfig config;
+        if (sample_stride != 0) {
+            config.sampleStride = sample_stride;
+        }
+        model->monitor.reset(new DriftMonitor(baseline, config));
+        return CPUPERF_OK;
+    } catch (const std::exception& e) {
+        return fail(CPUPERF_INTERNAL_ERROR, e.what());
+    }
+}
+
+int cpuperf_drift_scores(const cpuperf_model* model, double* psi, double* ks, size_t count, int* drifted) {
+    if (model == nullptr || !model->monitor || count < CPUPERF_FEATURES) {
+        return fail(CPUPERF_INVALID_ARGUMENT, "cpuperf_drift_scores: no drift monitor or short buffer");
+    }
+    try {
+        DriftMonitor::Report report = model->monitor->report();
+        for (size_t j = 0; j < CPUPERF_FEATURES; ++j) {
+            if (psi != nullptr) {
+                psi[j] = report.features[j].psi;
+            }
+            if (ks != nullptr) {
+                ks[j] = report.features[j].ks;
+            }
+        }
+        if (drifted != nullptr) {
+            *drifted = report.drifted ? 1 : 0;
+        }
+        return CPUPERF_OK;
+    } catch (const std::exception& e) {
+        return fail(CPUPERF_INTERNAL_ERROR, e.what());
+    }
+}
+
+} // extern "C"
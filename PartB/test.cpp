@@ -1,8 +1,37 @@
 #include "include/Dataset.h"
 #include "include/LinearRegression.h"
 #include "include/Evaluator.h"
+#include "include/MultiTargetRegression.h"
+#include "include/LUDecomposition.h"
+#include "include/IterativeSolver.h"
+#include "include/KernelRidgeRegression.h"
+#include "include/Ensemble.h"
+#include "include/ScoringKernel.h"
+#include "include/StreamingPipeline.h"
+#include "include/Summation.h"
+#include "include/NormalEquations.h"
+#include "include/DistributedTrainer.h"
+#include "include/SharedDataset.h"
+#include "include/Numa.h"
+#include "include/HugePages.h"
+#include "include/CpuDispatch.h"
+#include "include/CsvScanner.h"
+#include "include/FileIO.h"
+#include "include/RandomFourierFeatures.h"
+#include "include/ScanTuning.h"
+#include "include/Parallel.h"
+#include "include/DriftMonitor.h"
+#include "include/cpuperf.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 /**
  * @brief Simple test program to validate the linear regression implementation
@@ -48,6 +77,128 @@ void testMatrixOperations() {
         std::cout << "Error computing inverse: " << e.what() << std::endl;
     }
     
+    // Tiled transpose, in-place transpose and the lazy view on ragged sizes
+    Matrix E(37, 6), S(35, 35);
+    for (size_t i = 0; i < 37; ++i) {
+        for (size_t j = 0; j < 6; ++j) {
+            E(i, j) = std::sin(1.0 + i * 6 + j);
+        }
+    }
+    for (size_t i = 0; i < 35; ++i) {
+        for (size_t j = 0; j < 35; ++j) {
+            S(i, j) = i * 35.0 + j;
+        }
+    }
+    Matrix Et = E.transpose();
+    Matrix St = S;
+    St.transposeInPlace();
+    Matrix gramCopy = Et * E;
+    Matrix gramView = E.transposed() * E;
+    size_t transposeErrors = 0;
+    double gramDifference = 0.0;
+    for (size_t i = 0; i < 37; ++i) {
+        for (size_t j = 0; j < 6; ++j) {
+            transposeErrors += (Et(j, i) == E(i, j) && E.transposed()(j, i) == E(i, j)) ? 0 : 1;
+        }
+    }
+    for (size_t i = 0; i < 35; ++i) {
+        for (size_t j = 0; j < 35; ++j) {
+            transposeErrors += (St(j, i) == S(i, j)) ? 0 : 1;
+        }
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        for (size_t j = 0; j < 6; ++j) {
+            gramDifference = std::max(gramDifference, std::abs(gramCopy(i, j) - gramView(i, j)));
+        }
+    }
+    std::cout << "Transpose mismatches: " << transposeErrors
+              << ", max |X^T X - view product|: " << gramDifference << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testMatrixViews() {
+    std::cout << "=== Testing Matrix Views ===" << std::endl;
+    
+    Matrix A(6, 5);
+    for (size_t i = 0; i < 6; ++i) {
+        for (size_t j = 0; j < 5; ++j) {
+            A(i, j) = i * 10.0 + j;
+        }
+    }
+    
+    // Block, strided and column slices index the source
+    ConstMatrixView inner = A.block(1, 1, 4, 3);
+    ConstMatrixView everyOther = A.view().strided(2, 2);
+    ConstMatrixView lastColumn = A.view().column(4);
+    std::cout << "block(1,1,4,3)(2,1) = " << inner(2, 1)
+              << ", strided(2,2) is " << everyOther.getRows() << "x" << everyOther.getCols()
+              << " with (2,2) = " << everyOther(2, 2)
+              << ", column(4)(5,0) = " << lastColumn(5, 0) << std::endl;
+    
+    // Writes through a view land in the source
+    Matrix B(6, 5);
+    B.block(0, 0, 3, 5).copyFrom(A.rowRange(3, 6));
+    B.rowRange(3, 6).fill(-1.0);
+    std::cout << "B(0,0) = " << B(0, 0) << ", B(5,4) = " << B(5, 4) << std::endl;
+    
+    // Kernels on views match kernels on copies
+    Matrix product = Matrix::multiply(inner, A.block(0, 0, 3, 2));
+    Matrix expected = Matrix(inner) * Matrix(A.block(0, 0, 3, 2));
+    Matrix gram = Matrix::TransposedView(everyOther) * everyOther;
+    Matrix expectedGram = Matrix(everyOther).transpose() * Matrix(everyOther);
+    double difference = 0.0;
+    for (size_t i = 0; i < product.getRows(); ++i) {
+        for (size_t j = 0; j < product.getCols(); ++j) {
+            difference = std::max(difference, std::abs(product(i, j) - expected(i, j)));
+        }
+    }
+    for (size_t i = 0; i < gram.getRows(); ++i) {
+        for (size_t j = 0; j < gram.getCols(); ++j) {
+            difference = std::max(difference, std::abs(gram(i, j) - expectedGram(i, j)));
+        }
+    }
+    std::cout << "Max difference, view kernels vs copies: " << difference << std::endl;
+    
+    try {
+        A.block(4, 0, 3, 1);
+        std::cout << "Out-of-range block was not rejected!" << std::endl;
+    } catch (const std::out_of_range&) {
+        std::cout << "Out-of-range block rejected" << std::endl;
+    }
+    
+    std::cout << std::endl;
+}
+
+void testLUDecomposition() {
+    std::cout << "=== Testing LU Decomposition ===" << std::endl;
+    
+    Matrix A(3, 3);
+    A(0, 0) = 2; A(0, 1) = 1; A(0, 2) = 1;
+    A(1, 0) = 4; A(1, 1) = -6; A(1, 2) = 0;
+    A(2, 0) = -2; A(2, 1) = 7; A(2, 2) = 2;
+    
+    LUDecomposition lu = A.lu();
+    std::cout << "det(A) = " << lu.determinant() << " (expected -16)" << std::endl;
+    std::cout << "log|det(A)| = " << lu.logDeterminant() 
+              << ", sign = " << lu.determinantSign() << std::endl;
+    
+    // Same factors solve several right-hand sides
+    std::vector<double> x = lu.solve({5, -2, 9});
+    std::cout << "Solution of A x = [5, -2, 9] (expected [1, 1, 2]): ";
+    for (double v : x) {
+        std::cout << v << " ";
+    }
+    std::cout << std::endl;
+    
+    std::cout << "A * A^(-1) (should be identity):" << std::endl;
+    (A * lu.inverse()).display();
+    
+    Matrix S(2, 2);
+    S(0, 0) = 1; S(0, 1) = 2;
+    S(1, 0) = 2; S(1, 1) = 4;
+    std::cout << "Singular matrix detected: " << (S.lu().isSingular() ? "yes" : "no") << std::endl;
+    
     std::cout << std::endl;
 }
 
@@ -70,6 +221,163 @@ void testDatasetLoading() {
     std::cout << std::endl;
 }
 
+void testCsvScanner() {
+    std::cout << "=== Testing CSV Scanner ===" << std::endl;
+    
+    // CRLF endings, a blank line, untrimmed fields and a last line without a newline
+    std::string text = "a,b,c\r\n1, 2 ,3\r\n\r\n  last,row  ";
+    std::vector<std::string> records;
+    std::vector<size_t> lines;
+    size_t consumed = CsvScanner::forEachRecord(text.data(), text.size(),
+        [&](const CsvScanner::Field* fields, size_t count, size_t lineNumber) {
+            std::string record;
+            for (size_t f = 0; f < count; ++f) {
+                record += (f > 0 ? "|" : "") + std::string(fields[f].begin, fields[f].length);
+            }
+            records.push_back(record);
+            lines.push_back(lineNumber);
+        });
+    bool small = consumed == 4 && records == std::vector<std::string>{"a|b|c", "1| 2 |3", "last|row"} &&
+                 lines == std::vector<size_t>{1, 2, 4};
+    
+    // Many blocks: every field must match a plain split of the same text
+    std::string large;
+    std::vector<std::string> expected;
+    for (int row = 0; row < 500; ++row) {
+        std::string record;
+        for (int f = 0; f <= row % 7; ++f) {
+            std::string field(static_cast<size_t>(1 + (row * 13 + f * 7) % 23), static_cast<char>('a' + f));
+            large += (f > 0 ? "," : "") + field;
+            record += (f > 0 ? "|" : "") + field;
+        }
+        large += row % 3 == 0 ? "\r\n" : "\n";
+        expected.push_back(record);
+    }
+    large.pop_back();  // no newline after the last record
+    std::vector<std::string> scanned;
+    CsvScanner::forEachRecord(large.data(), large.size(),
+        [&](const CsvScanner::Field* fields, size_t count, size_t) {
+            std::string record;
+            for (size_t f = 0; f < count; ++f) {
+                record += (f > 0 ? "|" : "") + std::string(fields[f].begin, fields[f].length);
+            }
+            scanned.push_back(record);
+        });
+    
+    // Integer fields: the SWAR path takes up to 8 digits, everything else is refused
+    int value = -1;
+    bool ints = CsvScanner::parseInt("12345678", 8, value) && value == 12345678 &&
+                CsvScanner::parseInt("-45", 3, value) && value == -45 &&
+                !CsvScanner::parseInt("", 0, value) && !CsvScanner::parseInt("-", 1, value) &&
+                !CsvScanner::parseInt("12a", 3, value) && !CsvScanner::parseInt("+5", 2, value) &&
+                !CsvScanner::parseInt("123456789", 9, value) && !CsvScanner::parseInt(" 7", 2, value) &&
+                value == -45;
+    
+    // Records through Dataset: malformed numbers and short rows are skipped,
+    // CRLF rows, blank-padded numbers and a final unterminated row are kept
+    Dataset dataset;
+    dataset.loadFromBuffer("ibm,370,57,4000,16000,1,6,12,132,82\r\n"
+                           "ibm,bad,57x,4000,16000,1,6,12,132,82\r\n"
+                           "ibm,short,57,4000\r\n"
+                           "ibm,big,123456789,4000,16000,1,6,12,132,82\n"
+                           "amdahl,470, 29 ,8000,32000,32,8,32,269,253");
+    bool parsed = dataset.size() == 3 && dataset[0].getPRP() == 132 && dataset[1].getMYCT() == 123456789 &&
+                  dataset[2].getMYCT() == 29 && dataset[2].getERP() == 253;
+    
+    std::cout << "Small input: " << small << ", " << scanned.size() << " block-spanning records match: "
+              << (scanned == expected) << ", integer parsing: " << ints << ", dataset rows kept: "
+              << dataset.size() << " (expected 3): " << parsed << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testFileIO() {
+    std::cout << "=== Testing File I/O ===" << std::endl;
+    
+    // Odd-sized writes through small blocks, read back whole and block by block
+    std::string content;
+    for (size_t i = 0; content.size() < 300000; ++i) {
+        content += std::to_string(i * 2654435761ULL % 1000003) + (i % 5 == 0 ? "\r\n" : ",");
+    }
+    std::string fileName = "test_file_io.txt";
+    for (const char* backend : {"", "pread"}) {
+        if (backend[0] != '\0') {
+            setenv("CPUPERF_IO_BACKEND", backend, 1);
+        }
+        FileWriter writer(4096, 4);
+        bool written = writer.open(fileName);
+        std::string writerBackend = writer.backendName();
+        for (size_t pos = 0, chunk = 1; written && pos < content.size(); pos += chunk, chunk = chunk * 3 % 9973 + 1) {
+            written = writer.write(content.data() + pos, std::min(chunk, content.size() - pos));
+        }
+        written = writer.close() && written;
+        
+        FileReader reader(4096, 4);
+        std::string whole, joined;
+        size_t blocks = 0;
+        bool read = reader.open(fileName) && reader.fileSize() == content.size() && reader.readAll(whole);
+        std::string readerBackend = reader.backendName();
+        reader.close();
+        read = read && reader.open(fileName) && reader.readBlocks([&](const char* block, size_t length) {
+            joined.append(block, length);
+            ++blocks;
+            return true;
+        });
+        reader.close();
+        
+        // A consumer returning false stops after the first block
+        size_t stoppedAfter = 0;
+        bool stopped = reader.open(fileName) && reader.readBlocks([&](const char*, size_t) {
+            ++stoppedAfter;
+            return false;
+        });
+        reader.close();
+        
+        std::cout << "Backend " << writerBackend << "/" << readerBackend << ": written " << written
+                  << ", readAll matches: " << (read && whole == content) << ", " << blocks
+                  << " blocks match: " << (joined == content) << ", early stop after " << stoppedAfter
+                  << " block(s): " << stopped << std::endl;
+        unsetenv("CPUPERF_IO_BACKEND");
+    }
+    std::remove(fileName.c_str());
+    
+    // Empty and missing files
+    FileWriter empty;
+    std::string emptyContent = "unchanged";
+    FileReader reader;
+    bool emptyOk = empty.open(fileName) && empty.close() && reader.open(fileName) && reader.readAll(emptyContent) &&
+                   emptyContent.empty();
+    reader.close();
+    std::remove(fileName.c_str());
+    std::cout << "Empty file reads as empty: " << emptyOk << ", missing file rejected: "
+              << !reader.open("Data/missing.data") << std::endl;
+    
+    // Rows longer than any fixed formatting buffer are written in full
+    Dataset data;
+    LinearRegression model;
+    if (data.loadFromFile("Data/machine.data") && model.train(data)) {
+        std::string longModel(600, 'm');
+        data[0].setModel(longModel);
+        Evaluator evaluator(&model);
+        std::string csv;
+        FileReader csvReader;
+        bool exported = evaluator.exportPredictions(data, fileName) && csvReader.open(fileName) &&
+                        csvReader.readAll(csv);
+        csvReader.close();
+        std::remove(fileName.c_str());
+        size_t firstRow = csv.find('\n') + 1;
+        size_t rowEnd = csv.find('\n', firstRow);
+        size_t rows = static_cast<size_t>(std::count(csv.begin(), csv.end(), '\n'));
+        std::cout << "Exported " << rows - 1 << " rows, long row intact: "
+                  << (exported && rowEnd != std::string::npos &&
+                      csv.compare(firstRow, longModel.size() + 9, "adviser," + longModel + ",") == 0 &&
+                      std::count(csv.begin() + firstRow, csv.begin() + rowEnd, ',') >= 4)
+                  << std::endl;
+    }
+    
+    std::cout << std::endl;
+}
+
 void testLinearRegression() {
     std::cout << "=== Testing Linear Regression ===" << std::endl;
     
@@ -110,6 +418,9 @@ void testLinearRegression() {
                       << " (actual: " << actual 
                       << ", error: " << std::abs(prediction - actual) << ")" << std::endl;
         }
+        
+        // Per-fold progress, then the summary
+        model.crossValidate(fullDataset, 5);
     } else {
         std::cout << "Model training failed!" << std::endl;
     }
@@ -117,14 +428,1053 @@ void testLinearRegression() {
     std::cout << std::endl;
 }
 
+void testStreamingPipeline() {
+    std::cout << "=== Testing Streaming Pipeline ===" << std::endl;
+    
+    Dataset data;
+    if (!data.loadFromFile("Data/machine.data")) {
+        std::cout << "Failed to load dataset for streaming pipeline test!" << std::endl;
+        return;
+    }
+    
+    // Tiny batches and queues force many hand-offs between the stages
+    PipelineConfig smallBatches;
+    smallBatches.batchRows = 16;
+    smallBatches.queueCapacity = 2;
+    StreamingPipeline small(smallBatches);
+    StreamingPipeline standard;
+    LinearRegression smallModel, standardModel;
+    bool ran = small.run("Data/machine.data", smallModel) && standard.run("Data/machine.data", standardModel);
+    if (!ran) {
+        std::cout << "Streaming pipeline failed!" << std::endl;
+        return;
+    }
+    const StreamingPipeline::Result& result = small.getResult();
+    
+    // Train and test rows partition the file: together they give the full statistics
+    NormalEquations full, merged = small.getTrainStatistics();
+    merged.merge(small.getTestStatistics());
+    for (size_t i = 0; i < data.size(); ++i) {
+        std::vector<double> features = data[i].getFeatureVector();
+        full.addRow(features.data(), data[i].getTarget());
+    }
+    std::vector<double> fullXty = full.getXty(), mergedXty = merged.getXty();
+    bool partition = result.trainRows + result.testRows == data.size() && result.testRows > 0.0 &&
+                     std::abs(merged.getYty() - full.getYty()) <= 1e-9 * full.getYty();
+    for (size_t j = 0; j < fullXty.size(); ++j) {
+        partition = partition && std::abs(mergedXty[j] - fullXty[j]) <= 1e-9 * std::abs(fullXty[j]);
+    }
+    
+    // The model is fitted on the training rows only, and the split does not depend on batching
+    std::vector<double> trainOnly = small.getTrainStatistics().solve();
+    std::vector<double> allRows = full.solve();
+    bool heldOut = true, sameSplit = standard.getResult().testRows == result.testRows;
+    double fullDifference = 0.0;
+    for (size_t j = 0; j < trainOnly.size(); ++j) {
+        heldOut = heldOut && std::abs(result.coefficients[j] - trainOnly[j]) <= 1e-9 * (1.0 + std::abs(trainOnly[j]));
+        sameSplit = sameSplit && std::abs(standard.getResult().coefficients[j] - result.coefficients[j]) <=
+                                     1e-9 * (1.0 + std::abs(result.coefficients[j]));
+        fullDifference = std::max(fullDifference, std::abs(allRows[j] - trainOnly[j]));
+    }
+    heldOut = heldOut && fullDifference > 1e-6;
+    
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << "Rows: " << static_cast<size_t>(result.trainRows) << " train + "
+              << static_cast<size_t>(result.testRows) << " test, partition: " << partition
+              << ", fitted on training rows only: " << heldOut << ", same split at any batch size: " << sameSplit
+              << std::endl;
+    std::cout << "Held-out RMSE: " << result.testRMSE << ", R²: " << result.testRSquared
+              << ", consistent: " << (std::abs(result.testRMSE * result.testRMSE - result.testMSE) < 1e-6) << std::endl;
+    
+    // The reader stage counts every byte of the file exactly once
+    FileReader fileReader;
+    std::string contents;
+    bool readerBytes = fileReader.open("Data/machine.data") && fileReader.readAll(contents) &&
+                       !result.stages.empty() && result.stages[0].bytes == contents.size();
+    std::cout << "Reader bytes match the file size: " << readerBytes << std::endl;
+    
+    LinearRegression unused;
+    bool missingRejected = !StreamingPipeline().run("Data/missing.data", unused);
+    std::cout << "Missing file rejected: " << missingRejected << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testMultiTargetEvaluation() {
+    std::cout << "=== Testing Multi-Target Evaluation ===" << std::endl;
+    
+    // Three targets that are exact linear functions of four features
+    size_t n = 300;
+    Matrix X(n, 4);
+    Matrix Y(n, 3);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < 4; ++j) {
+            X[i][j] = std::sin((0.7 + 0.31 * j) * i + j) * (j + 1);
+        }
+        Y[i][0] = 2.0 * X[i][0] - X[i][3];
+        Y[i][1] = 0.5 * X[i][1] - 3.0 * X[i][2];
+        Y[i][2] = X[i][0] + X[i][1] + X[i][2] + X[i][3];
+    }
+    MultiTargetRegression model;
+    bool trained = model.train(X, Y, {"a", "b", "c"});
+    std::vector<Evaluator::TargetMetrics> metrics;
+    if (trained) {
+        metrics = Evaluator::evaluateTargets(model, X, Y);
+    }
+    bool exact = metrics.size() == 3;
+    for (const Evaluator::TargetMetrics& target : metrics) {
+        exact = exact && target.rmse < 1e-8 && target.rSquared > 0.999999;
+    }
+    std::cout << "Targets evaluated: " << metrics.size() << " (expected 3), exact fit: " << exact << std::endl;
+    
+    // Mismatched actual values and a dataset without these targets are rejected
+    bool rejectedColumns = false, rejectedDataset = false;
+    try {
+        Evaluator::evaluateTargets(model, X, Matrix(n, 2));
+    } catch (const std::invalid_argument&) {
+        rejectedColumns = true;
+    }
+    Dataset data;
+    if (data.loadFromFile("Data/machine.data")) {
+        try {
+            Evaluator::evaluateTargets(model, data);
+        } catch (const std::invalid_argument&) {
+            rejectedDataset = true;
+        }
+    }
+    std::cout << "Rejected 2 actual columns: " << rejectedColumns
+              << ", rejected dataset targets: " << rejectedDataset << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testSparseMatrix() {
+    std::cout << "=== Testing Sparse Matrix ===" << std::endl;
+    
+    Dataset dataset;
+    if (!dataset.loadFromFile("Data/machine.data")) {
+        std::cout << "Failed to load dataset for sparse test!" << std::endl;
+        return;
+    }
+    
+    std::vector<std::vector<double>> rows;
+    std::vector<double> y;
+    dataset.getMatrices(rows, y);
+    
+    // Sparse and dense training must agree on the 6-feature design
+    SparseMatrix X = dataset.getSparseDesign();
+    std::cout << "Sparse design: " << X.getRows() << "x" << X.getCols() 
+              << ", nonzeros: " << X.nonZeros() << std::endl;
+    
+    LinearRegression dense, sparse;
+    dense.train(dataset);
+    sparse.trainSparse(X, y);
+    double maxDifference = 0.0;
+    for (size_t j = 0; j < 6; ++j) {
+        maxDifference = std::max(maxDifference, 
+                                 std::abs(dense.getCoefficients()[j] - sparse.getCoefficients()[j]));
+    }
+    std::cout << "Max coefficient difference (dense vs sparse): " << maxDifference << std::endl;
+    
+    // One-hot vendor columns, solved without forming the Gram matrix
+    std::vector<std::string> vendors;
+    SparseMatrix oneHot = dataset.getSparseDesign(true, &vendors);
+    std::cout << "One-hot design: " << oneHot.getRows() << "x" << oneHot.getCols() 
+              << " (" << vendors.size() << " vendors), density: " << oneHot.density() << std::endl;
+    
+    ConjugateGradient solver(5000, 1e-10);
+    ConjugateGradient::Result cg = solver.solveLeastSquares(oneHot, y, 1.0);
+    Matrix gram = oneHot.gram().toDense();
+    for (size_t j = 0; j < gram.getRows(); ++j) {
+        gram(j, j) += 1.0;
+    }
+    std::vector<double> direct = gram.lu().solve(oneHot.transposeMultiply(y));
+    double cgDifference = 0.0;
+    for (size_t j = 0; j < direct.size(); ++j) {
+        cgDifference = std::max(cgDifference, std::abs(direct[j] - cg.solution[j]));
+    }
+    std::cout << "CG iterations: " << cg.iterations << (cg.converged ? " (converged)" : " (not converged)")
+              << ", max difference from LU: " << cgDifference << std::endl;
+    
+    LinearRegression vendorModel;
+    vendorModel.trainSparse(oneHot, y, 1.0);
+    double vendorDifference = 0.0;
+    for (size_t j = 0; j < direct.size(); ++j) {
+        vendorDifference = std::max(vendorDifference, std::abs(direct[j] - vendorModel.getCoefficients()[j]));
+    }
+    std::cout << "trainSparse on the one-hot design: " << vendorModel.getCoefficients().size()
+              << " coefficients, max difference from LU: " << vendorDifference << std::endl;
+    
+    // Wider than the direct-solve limit, so trainSparse runs conjugate gradient
+    const size_t wideRows = 3000, wideCols = 300;
+    std::vector<SparseMatrix::Triplet> wideTriplets;
+    std::vector<double> wideY(wideRows);
+    for (size_t i = 0; i < wideRows; ++i) {
+        for (size_t k = 0; k < 4; ++k) {
+            wideTriplets.push_back({i, (i * 7 + k * 131) % wideCols, 1.0 + 0.01 * ((i + k) % 17)});
+        }
+        wideY[i] = std::sin(0.1 * i);
+    }
+    SparseMatrix wide = SparseMatrix::fromTriplets(wideRows, wideCols, std::move(wideTriplets));
+    LinearRegression wideModel;
+    bool wideTrained = wideModel.trainSparse(wide, wideY, 0.5);
+    Matrix wideGram = wide.gram().toDense();
+    for (size_t j = 0; j < wideCols; ++j) {
+        wideGram(j, j) += 0.5;
+    }
+    std::vector<double> wideDirect = wideGram.lu().solve(wide.transposeMultiply(wideY));
+    double wideDifference = 0.0;
+    for (size_t j = 0; wideTrained && j < wideCols; ++j) {
+        wideDifference = std::max(wideDifference, std::abs(wideDirect[j] - wideModel.getCoefficients()[j]));
+    }
+    std::cout << "trainSparse on a " << wideRows << "x" << wideCols << " design: "
+              << (wideTrained ? "trained" : "FAILED") << ", inference: "
+              << (wideModel.getHasInference() ? "yes" : "no")
+              << ", max difference from LU: " << wideDifference << std::endl;
+    
+    // A team reuses its workers across loops; a loop started inside a block
+    // of a running loop falls back to its own threads
+    Parallel::Team team;
+    std::vector<size_t> visits(4, 0);
+    bool nestedFallback = true;
+    for (int round = 0; round < 3; ++round) {
+        team.run(visits.size(), [&](size_t block) {
+            ++visits[block];
+            if (block == 0) {
+                nestedFallback = nestedFallback && !team.run(2, [](size_t) {});
+            }
+        });
+    }
+    bool allVisited = std::all_of(visits.begin(), visits.end(), [](size_t v) { return v == 3; });
+    
+    // A throwing block, on the caller or a worker, reaches the caller after
+    // the loop has finished, and the team stays usable
+    bool rethrown = true;
+    for (size_t thrower : {size_t(0), size_t(2)}) {
+        try {
+            team.run(visits.size(), [thrower](size_t block) {
+                if (block == thrower) {
+                    throw std::runtime_error("block failed");
+                }
+            });
+            rethrown = false;
+        } catch (const std::runtime_error&) {
+        }
+    }
+    rethrown = rethrown && team.run(2, [](size_t) {});
+    try {
+        Parallel::parallelFor(1 << 16, 1 << 10, [](size_t block, size_t, size_t) {
+            if (block == Parallel::blockCount(1 << 16, 1 << 10) - 1) {
+                throw std::runtime_error("block failed");
+            }
+        });
+        rethrown = false;
+    } catch (const std::runtime_error&) {
+    }
+    std::cout << "Parallel team: " << (allVisited ? "every block ran once per loop" : "FAILED")
+              << ", nested loop " << (nestedFallback ? "refused" : "FAILED")
+              << ", block exceptions " << (rethrown ? "rethrown" : "FAILED") << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testKernelRidge() {
+    std::cout << "=== Testing Kernel Ridge (Random Fourier Features) ===" << std::endl;
+    
+    // Vectorized sin/cos against the standard library, including the scalar tail
+    std::vector<double> angles;
+    for (int i = -1000; i <= 1001; ++i) {
+        angles.push_back(i * 0.7311);
+    }
+    std::vector<double> sines(angles.size()), cosines(angles.size());
+    RandomFourierFeatures::sinCos(angles.data(), angles.size(), sines.data(), cosines.data());
+    double trigError = 0.0;
+    for (size_t i = 0; i < angles.size(); ++i) {
+        trigError = std::max(trigError, std::abs(sines[i] - std::sin(angles[i])));
+        trigError = std::max(trigError, std::abs(cosines[i] - std::cos(angles[i])));
+    }
+    std::cout << "sin/cos max error: " << trigError << std::endl;
+    
+    Dataset dataset;
+    if (!dataset.loadFromFile("Data/machine.data")) {
+        std::cout << "Failed to load dataset for kernel ridge test!" << std::endl;
+        return;
+    }
+    
+    KernelRidgeRegression model(256, 1.0);
+    if (!model.fit(dataset)) {
+        std::cout << "Kernel ridge training failed!" << std::endl << std::endl;
+        return;
+    }
+    std::cout << "Training RMSE: " << model.getTrainRMSE() << std::endl;
+    
+    // Only the seed is stored; the reloaded map must reproduce the predictions
+    std::string modelFile = "test_kernel_model.txt";
+    KernelRidgeRegression reloaded;
+    if (model.save(modelFile) && reloaded.load(modelFile)) {
+        std::vector<double> before = model.predict(dataset);
+        std::vector<double> after = reloaded.predict(dataset);
+        double difference = 0.0;
+        for (size_t i = 0; i < before.size(); ++i) {
+            difference = std::max(difference, std::abs(before[i] - after[i]));
+        }
+        std::cout << "Save/load max prediction difference: " << difference << std::endl;
+    } else {
+        std::cout << "Model save/load failed!" << std::endl;
+    }
+    std::remove(modelFile.c_str());
+    
+    std::cout << std::endl;
+}
+
+void testEnsemble() {
+    std::cout << "=== Testing Ensembles ===" << std::endl;
+    
+    Dataset dataset;
+    if (!dataset.loadFromFile("Data/machine.data")) {
+        std::cout << "Failed to load dataset for ensemble test!" << std::endl;
+        return;
+    }
+    
+    Matrix X = Ensemble::createDesignMatrix(dataset);
+    Ensemble bagged;
+    if (!bagged.fitBagged(dataset, 16)) {
+        std::cout << "Bagged ensemble training failed!" << std::endl;
+        return;
+    }
+    
+    // The fused predictor must equal the average of the member predictions
+    Matrix members = bagged.predictMembers(X);
+    std::vector<double> fused = bagged.predict(X);
+    double difference = 0.0;
+    for (size_t i = 0; i < X.getRows(); ++i) {
+        double average = 0.0;
+        for (size_t m = 0; m < members.getCols(); ++m) {
+            average += members[i][m] / members.getCols();
+        }
+        difference = std::max(difference, std::abs(average - fused[i]));
+    }
+    std::cout << "Bagged members: " << members.getCols() << ", fused vs member average: " << difference << std::endl;
+    std::cout << "Bagged RMSE: " << bagged.calculateRMSE(dataset) << std::endl;
+    
+    Ensemble stacked;
+    if (stacked.fitStacked(dataset)) {
+        std::cout << "Stacked members: " << stacked.getMemberCount()
+                  << ", RMSE: " << stacked.calculateRMSE(dataset) << std::endl;
+        
+        // Many batches (split across blocks when threads allow) score each row
+        // as a single batch does
+        Matrix tiled(X.getRows() * 50, X.getCols());
+        for (size_t i = 0; i < tiled.getRows(); ++i) {
+            tiled[i] = X[i % X.getRows()];
+        }
+        Matrix single = stacked.predictMembers(X);
+        Matrix batched = stacked.predictMembers(tiled);
+        double batchDifference = 0.0;
+        for (size_t i = 0; i < tiled.getRows(); ++i) {
+            for (size_t m = 0; m < batched.getCols(); ++m) {
+                batchDifference = std::max(batchDifference,
+                                           std::abs(batched[i][m] - single[i % X.getRows()][m]));
+            }
+        }
+        std::cout << "Members over " << tiled.getRows() << " rows vs one batch: " << batchDifference << std::endl;
+    } else {
+        std::cout << "Stacked ensemble training failed!" << std::endl;
+    }
+    
+    std::cout << std::endl;
+}
+
+void testPredictionIntervals() {
+    std::cout << "=== Testing Prediction Intervals ===" << std::endl;
+    
+    Dataset dataset;
+    if (!dataset.loadFromFile("Data/machine.data")) {
+        std::cout << "Failed to load dataset for interval test!" << std::endl;
+        return;
+    }
+    
+    LinearRegression model;
+    if (!model.train(dataset) || !model.getHasInference()) {
+        std::cout << "Training without standard errors!" << std::endl;
+        return;
+    }
+    
+    // Batched standard errors against s^2 * (1 + x^T (X^T X)^(-1) x) from the explicit inverse
+    Matrix X(dataset.size(), 6);
+    for (size_t i = 0; i < dataset.size(); ++i) {
+        X[i] = dataset[i].getFeatureVector();
+    }
+    Matrix inverse = (X.transpose() * X).inverse();
+    std::vector<LinearRegression::PredictionInterval> intervals = model.predictIntervals(X);
+    double difference = 0.0;
+    size_t covered = 0;
+    for (size_t i = 0; i < X.getRows(); ++i) {
+        double form = 0.0;
+        for (size_t a = 0; a < 6; ++a) {
+            for (size_t b = 0; b < 6; ++b) {
+                form += X[i][a] * inverse[a][b] * X[i][b];
+            }
+        }
+        double expected = std::sqrt(model.getResidualVariance() * (1.0 + form));
+        difference = std::max(difference, std::abs(expected - intervals[i].standardError) / expected);
+        double actual = dataset[i].getTarget();
+        covered += (actual >= intervals[i].lower && actual <= intervals[i].upper) ? 1 : 0;
+    }
+    std::cout << "Max relative standard error difference: " << difference << std::endl;
+    std::cout << "95% interval coverage: " << covered << "/" << X.getRows() << std::endl;
+    std::cout << "t(0.95, 10) = " << LinearRegression::tCriticalValue(0.95, 10) << " (exact 2.2281)" << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testScoringKernel() {
+    std::cout << "=== Testing Scoring Kernels ===" << std::endl;
+    
+    // Every specialized width and the blocked fallback against the generic loop;
+    // 37 rows leave a tail after the four-row groups
+    const size_t rows = 37;
+    size_t mismatches = 0;
+    for (size_t p = 1; p <= 300; p = (p < 70) ? p + 1 : p * 2) {
+        std::vector<double> coefficients(p);
+        std::vector<double> batch(rows * p);
+        for (size_t j = 0; j < p; ++j) {
+            coefficients[j] = std::sin(0.7 * j + 0.1);
+        }
+        for (size_t k = 0; k < batch.size(); ++k) {
+            batch[k] = std::cos(1.3 * k);
+        }
+        ScoringKernel kernel(coefficients, 0.25);
+        std::vector<double> expected(rows), actual(rows);
+        ScoringKernel::scoreGeneric(coefficients.data(), p, 0.25, batch.data(), rows, expected.data());
+        kernel.score(batch.data(), rows, actual.data());
+        mismatches += (expected == actual) ? 0 : 1;
+    }
+    std::cout << "Feature counts differing from the generic loop: " << mismatches << std::endl;
+    
+    Dataset dataset;
+    LinearRegression model;
+    if (dataset.loadFromFile("Data/machine.data") && model.train(dataset)) {
+        std::vector<double> batched = model.predict(dataset);
+        size_t differing = 0;
+        for (size_t i = 0; i < dataset.size(); ++i) {
+            differing += (batched[i] == model.predict(dataset[i])) ? 0 : 1;
+        }
+        std::cout << "Batched vs single-row predictions differing: " << differing << std::endl;
+    }
+    
+    std::cout << std::endl;
+}
+
+void testSummation() {
+    std::cout << "=== Testing Summation ===" << std::endl;
+    
+    // Triples (x, 1, -x) with x = 1e16 sum to one each, but the naive loop
+    // rounds every 1 away; a 7-term tail exercises the scalar remainder
+    const size_t triples = 20000;
+    const size_t n = 3 * triples + 7;
+    std::vector<double> values(n, 1.0);
+    for (size_t t = 0; t < triples; ++t) {
+        values[3 * t] = 1e16;
+        values[3 * t + 2] = -1e16;
+    }
+    double exact = static_cast<double>(triples + 7);
+    std::cout << std::scientific << std::setprecision(1);
+    std::cout << "Naive error:         " << std::abs(Summation::naive(values.data(), n) - exact) << std::endl;
+    std::cout << "Pairwise error:      " << std::abs(Summation::pairwise(values.data(), n) - exact) << std::endl;
+    std::cout << "Kahan-Babuska error: " << std::abs(Summation::kahanBabuska(values.data(), n) - exact) << std::endl;
+    std::cout << "Compensated error:   " << std::abs(Summation::compensated(values) - exact) << std::endl;
+    std::cout << "Parallel error:      " << std::abs(Summation::parallelSum(values.data(), n) - exact) << std::endl;
+    std::cout << std::fixed << std::setprecision(4);
+    
+    std::vector<double> a = {1.0, -2.0, 3.0, -4.0, 5.0, -6.0, 7.0, -8.0, 9.0, -10.0, 11.0};
+    std::vector<double> b(a.size(), 1.0);
+    std::cout << "dot / squared / absolute: " << Summation::dot(a.data(), b.data(), a.size()) << " / "
+              << Summation::squaredDifferences(a.data(), b.data(), a.size()) << " / "
+              << Summation::absoluteDifferences(a.data(), b.data(), a.size()) << " (expected 6 / 505 / 65)" << std::endl;
+    
+    // Deviations about a scalar match the differences against a filled vector at every level
+    std::vector<double> samples(1003);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = std::sin(0.37 * i) * 1e3 + 1e6;
+    }
+    double center = Summation::mean(samples);
+    std::vector<double> filled(samples.size(), center);
+    CpuDispatch::Level active = CpuDispatch::level();
+    bool sameDeviations = true;
+    for (int level = CpuDispatch::BASELINE; level < CpuDispatch::LEVEL_COUNT; ++level) {
+        if (CpuDispatch::setLevel(static_cast<CpuDispatch::Level>(level))) {
+            sameDeviations = sameDeviations &&
+                Summation::squaredDeviations(samples.data(), samples.size(), center) ==
+                Summation::squaredDifferences(samples.data(), filled.data(), samples.size());
+        }
+    }
+    CpuDispatch::setLevel(active);
+    std::cout << "Squared deviations match filled differences: " << sameDeviations << std::endl;
+    
+    // Statistics streamed in batches match one pass over all rows
+    NormalEquations whole(2), batched(2);
+    std::vector<double> x0(1000), x1(1000), y(1000);
+    for (size_t i = 0; i < 1000; ++i) {
+        x0[i] = 1.0;
+        x1[i] = 0.001 * i;
+        y[i] = 3.0 + 2.0 * x1[i];
+    }
+    const double* columns[] = {x0.data(), x1.data()};
+    whole.addColumns(columns, y.data(), 1000);
+    for (size_t begin = 0; begin < 1000; begin += 64) {
+        const double* batch[] = {x0.data() + begin, x1.data() + begin};
+        batched.addColumns(batch, y.data() + begin, std::min<size_t>(64, 1000 - begin));
+    }
+    std::vector<double> theta = batched.solve();
+    std::cout << "Batched Gram coefficients: " << theta[0] << ", " << theta[1]
+              << " (RSS " << std::scientific << std::setprecision(1) << batched.residualSumSquares(theta)
+              << std::fixed << std::setprecision(4) << ", Gram difference "
+              << std::abs(whole.getGram()(1, 1) - batched.getGram()(1, 1)) << ")" << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testDistributedTraining() {
+    std::cout << "=== Testing Distributed Training ===" << std::endl;
+    
+    // Shards merge to the same model whatever the worker count
+    std::vector<double> reference;
+    double referenceRMSE = 0.0;
+    for (size_t workers : {1, 3, 8}) {
+        DistributedConfig config;
+        config.workers = workers;
+        DistributedTrainer trainer(config);
+        LinearRegression model;
+        if (!trainer.run("Data/machine.data", model)) {
+            std::cout << workers << " workers: failed" << std::endl;
+            continue;
+        }
+        const DistributedTrainer::Result& result = trainer.getResult();
+        if (reference.empty()) {
+            reference = result.coefficients;
+            referenceRMSE = result.test.getRMSE();
+        }
+        double difference = 0.0;
+        for (size_t j = 0; j < reference.size(); ++j) {
+            difference = std::max(difference, std::abs(result.coefficients[j] - reference[j]));
+        }
+        std::cout << workers << " workers: " << std::setprecision(0) << result.trainRows << " train / "
+                  << result.testRows << " test rows, test RMSE " << std::setprecision(4) << result.test.getRMSE()
+                  << ", coefficient difference " << std::scientific << std::setprecision(1) << difference
+                  << ", RMSE difference " << std::abs(result.test.getRMSE() - referenceRMSE)
+                  << std::fixed << std::setprecision(4) << std::endl;
+    }
+    
+    // Merged accumulators match the Evaluator metrics over all rows
+    std::vector<double> actual = {10.0, 20.0, 30.0, 45.0, 0.0, 12.0, 7.0};
+    std::vector<double> predicted = {12.0, 18.0, 33.0, 40.0, 1.0, 12.5, 6.0};
+    MetricAccumulator left, right;
+    left.addBatch(actual.data(), predicted.data(), 4);
+    for (size_t i = 4; i < actual.size(); ++i) {
+        right.add(actual[i], predicted[i]);
+    }
+    std::vector<double> shipped = left.serialize();
+    MetricAccumulator merged = MetricAccumulator::deserialize(shipped.data(), shipped.size());
+    merged.merge(right);
+    std::cout << "Merged R² / MAPE: " << merged.getRSquared() << " / " << merged.getMAPE()
+              << " (Evaluator: " << Evaluator::calculateR2(actual, predicted) << " / "
+              << Evaluator::calculateMAPE(actual, predicted) << ")" << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testSharedDataset() {
+    std::cout << "=== Testing Shared Dataset ===" << std::endl;
+    
+    Dataset dataset;
+    if (!dataset.loadFromFile("Data/machine.data")) {
+        std::cout << "Failed to load data" << std::endl;
+        return;
+    }
+    const std::string name = "cpuperf_test_dataset";
+    if (!SharedDataset::publish(dataset, name)) {
+        std::cout << "Publish failed" << std::endl;
+        return;
+    }
+    
+    // Two attachments map the same pages; both reproduce the dataset
+    SharedDataset first, second;
+    bool attached = first.attach(name) && second.attach(name);
+    SharedDataset::unpublish(name);     // existing mappings stay valid
+    if (!attached) {
+        std::cout << "Attach failed" << std::endl;
+        return;
+    }
+    size_t mismatches = 0;
+    for (size_t i = 0; i < dataset.size(); ++i) {
+        const DataPoint& point = dataset[i];
+        if (first.getVendor(i) != point.getVendor() || first.getModel(i) != point.getModel() ||
+            first.column(SharedDataset::MMAX)[i] != point.getMMAX() || first.getTarget(i) != point.getTarget() ||
+            second.featureRows()[i * SharedDataset::FEATURE_COUNT + 3] != point.getCACH()) {
+            ++mismatches;
+        }
+    }
+    std::cout << "Rows: " << first.size() << ", dictionary entries: " << first.dictionarySize()
+              << ", mapped bytes: " << first.mappedBytes() << ", mismatches: " << mismatches << std::endl;
+    
+    // Scoring straight from the mapping matches scoring the Dataset
+    LinearRegression model;
+    model.train(dataset);
+    std::vector<double> expected = model.predict(dataset);
+    std::vector<double> shared(first.size());
+    model.predictBatch(first.featureRows(), first.size(), shared.data());
+    double difference = 0.0;
+    for (size_t i = 0; i < shared.size(); ++i) {
+        difference = std::max(difference, std::abs(shared[i] - expected[i]));
+    }
+    Dataset copy = first.toDataset();
+    std::cout << "Max prediction difference: " << difference << ", copied rows: " << copy.size() << std::endl;
+    
+    // A removed segment no longer attaches
+    std::cout << "Attach after unpublish: " << (SharedDataset().attach(name) ? "succeeded" : "failed") << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testNumaPlacement() {
+    std::cout << "=== Testing NUMA Placement ===" << std::endl;
+    
+    std::cout << "Nodes: " << Numa::nodeCount() << ", block 0 of 4 on CPU " << Numa::cpuForBlock(0, 4)
+              << ", block 3 of 4 on node " << Numa::nodeForBlock(3, 4) << std::endl;
+    
+    // Pinned blocks compute the same results as unpinned ones
+    Parallel::setPinning(true);
+    Parallel::NodeLocalArray<double> values(1 << 20, 1 << 16, Parallel::NodeLocalArray<double>::BIND, 0.5);
+    std::vector<double> partials(Parallel::blockCount(values.size(), 1 << 16), 0.0);
+    values.forEachBlock([&](size_t block, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            partials[block] += values[i];
+        }
+    });
+    Matrix X(10000, 4);
+    for (size_t i = 0; i < X.getRows(); ++i) {
+        for (size_t j = 0; j < X.getCols(); ++j) {
+            X(i, j) = static_cast<double>((i * 7 + j * 3) % 11);
+        }
+    }
+    Matrix pinnedGram = X.transposed() * X;
+    Parallel::setPinning(false);
+    Matrix gram = X.transposed() * X;
+    double difference = 0.0;
+    for (size_t i = 0; i < gram.getRows(); ++i) {
+        for (size_t j = 0; j < gram.getCols(); ++j) {
+            difference = std::max(difference, std::abs(gram(i, j) - pinnedGram(i, j)));
+        }
+    }
+    std::cout << "Node-local sum: " << Summation::naive(partials.data(), partials.size())
+              << " (expected " << 0.5 * values.size() << "), pinned Gram difference: " << difference
+              << ", first page on node " << Numa::nodeOfAddress(values.data()) << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testHugePages() {
+    std::cout << "=== Testing Huge Pages ===" << std::endl;
+    
+    // Large buffers are 2 MB aligned mappings, small ones 64-byte aligned
+    HugePages::Coverage before = HugePages::coverage();
+    std::vector<double, HugePages::Allocator<double>> large(3 << 18, 1.0);   // 6 MB
+    std::vector<double, HugePages::Allocator<double>> small(100, 2.0);
+    HugePages::Coverage during = HugePages::coverage();
+    std::cout << "Mode: " << HugePages::modeName(HugePages::mode())
+              << ", large aligned: " << (reinterpret_cast<uintptr_t>(large.data()) % HugePages::PAGE_BYTES == 0)
+              << ", small aligned: " << (reinterpret_cast<uintptr_t>(small.data()) % HugePages::ALIGNMENT == 0)
+              << ", new large buffers: " << during.allocations - before.allocations
+              << ", mapped MB: " << (during.bytes - before.bytes) / 1048576.0 << std::endl;
+    std::cout << "Sum: " << Summation::compensated(large.data(), large.size()) + small[0]
+              << ", coverage: " << HugePages::describe(during) << std::endl;
+    
+    // Releasing keeps the last measurement; a buffer never measured is booked as unmeasured
+    large = {};
+    large.shrink_to_fit();
+    HugePages::Coverage released = HugePages::coverage();
+    {
+        std::vector<double, HugePages::Allocator<double>> unmeasured(1 << 18, 3.0);   // 2 MB
+    }
+    HugePages::Coverage after = HugePages::coverage();
+    std::cout << "Released buffer keeps its measurement: "
+              << (released.bytes == during.bytes && released.hugeBytes == during.hugeBytes &&
+                  released.unmeasuredBytes == during.unmeasuredBytes)
+              << ", unmeasured MB after a release: "
+              << (after.unmeasuredBytes - released.unmeasuredBytes) / 1048576.0 << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testScanTuning() {
+    std::cout << "=== Testing Scan Tuning ===" << std::endl;
+    
+    // Prefetching and streaming stores change how memory is touched, never the results
+    const size_t rows = 100003;
+    std::vector<double> batch(rows * 3), y(rows);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i] = static_cast<double>((i * 7) % 101) * 0.1;
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        y[i] = static_cast<double>(i % 13);
+    }
+    ScoringKernel scorer({1.5, -0.5, 0.25}, 2.0);
+    
+    ScanTuning::Settings predictDefaults = ScanTuning::get(ScanTuning::PREDICT);
+    ScanTuning::Settings metricsDefaults = ScanTuning::get(ScanTuning::METRICS);
+    ScanTuning::set(ScanTuning::PREDICT, ScanTuning::Settings());
+    ScanTuning::set(ScanTuning::METRICS, ScanTuning::Settings());
+    std::vector<double> plain(rows), tuned(rows);
+    scorer.score(batch.data(), rows, plain.data());
+    double plainSse = Summation::squaredDifferences(plain.data(), y.data(), rows);
+    
+    ScanTuning::Settings settings;
+    settings.prefetchBytes = 1024;
+    settings.streamingStores = true;
+    ScanTuning::set(ScanTuning::PREDICT, settings);
+    ScanTuning::set(ScanTuning::METRICS, settings);
+    scorer.score(batch.data(), rows, tuned.data());
+    double tunedSse = Summation::squaredDifferences(tuned.data(), y.data(), rows);
+    ScanTuning::set(ScanTuning::PREDICT, predictDefaults);
+    ScanTuning::set(ScanTuning::METRICS, metricsDefaults);
+    
+    std::cout << "Default prefetch (predict/metrics/gram): " << predictDefaults.prefetchBytes << "/"
+              << metricsDefaults.prefetchBytes << "/" << ScanTuning::get(ScanTuning::GRAM).prefetchBytes
+              << ", predictions identical: " << (plain == tuned)
+              << ", SSE identical: " << (plainSse == tunedSse) << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testCpuDispatch() {
+    std::cout << "=== Testing CPU Dispatch ===" << std::endl;
+    
+    // Every level this CPU and build support must match the baseline bit for bit
+    const size_t n = 1003;
+    std::vector<double> a(n), b(n), sines(n), cosines(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = std::sin(static_cast<double>(i)) * 100.0 + static_cast<double>(i) * 0.01;
+        b[i] = static_cast<double>(i % 17) - 8.0;
+    }
+    std::string csv;
+    for (int i = 0; i < 300; ++i) {
+        csv += "amdahl,470v/7," + std::to_string(i) + ",\n";
+    }
+    
+    CpuDispatch::Level previous = CpuDispatch::level();
+    double referenceDot = 0.0;
+    std::vector<double> referenceSines, referenceCosines;
+    std::vector<uint32_t> referenceOffsets;
+    int levels = 0;
+    bool identical = true;
+    for (int l = 0; l < CpuDispatch::LEVEL_COUNT; ++l) {
+        if (!CpuDispatch::setLevel(static_cast<CpuDispatch::Level>(l))) {
+            continue;
+        }
+        double dot = Summation::dot(a.data(), b.data(), n);
+        RandomFourierFeatures::sinCos(a.data(), n, sines.data(), cosines.data());
+        std::vector<uint32_t> offsets;
+        CsvScanner::findStructurals(csv.data(), csv.size(), offsets);
+        if (levels++ == 0) {
+            referenceDot = dot;
+            referenceSines = sines;
+            referenceCosines = cosines;
+            referenceOffsets = offsets;
+        }
+        identical = identical && dot == referenceDot && sines == referenceSines &&
+                    cosines == referenceCosines && offsets == referenceOffsets;
+    }
+    CpuDispatch::setLevel(previous);
+    std::cout << "Selected: " << CpuDispatch::levelName(CpuDispatch::level())
+              << ", levels run: " << levels << ", identical: " << identical
+              << ", structurals: " << referenceOffsets.size() << std::endl;
+    
+    std::cout << std::endl;
+}
+
+void testCApi() {
+    std::cout << "=== Testing C API ===" << std::endl;
+    
+    // A model trained through the C API scores like LinearRegression
+    Dataset dataset;
+    LinearRegression reference;
+    cpuperf_model* model = cpuperf_model_train("Data/machine.data", 0.0);
+    if (!dataset.loadFromFile("Data/machine.data") || !reference.train(dataset) || model == nullptr) {
+        std::cout << "Training failed: " << cpuperf_last_error() << std::endl;
+        cpuperf_model_free(model);
+        return;
+    }
+    size_t n = std::min<size_t>(dataset.size(), 50);
+    std::vector<double> rows, out(n);
+    for (size_t i = 0; i < n; ++i) {
+        for (double value : dataset[i].getFeatureVector()) {
+            rows.push_back(value);
+        }
+    }
+    int status = cpuperf_predict(model, rows.data(), n, out.data());
+    bool same = status == CPUPERF_OK;
+    for (size_t i = 0; i < n && same; ++i) {
+        same = out[i] == reference.predict(dataset[i]);
+    }
+    
+    // Round trip through the coefficients, and the argument checks
+    double coefficients[CPUPERF_FEATURES];
+    cpuperf_model_coefficients(model, coefficients, CPUPERF_FEATURES);
+    cpuperf_model* copy = cpuperf_model_create(coefficients, CPUPERF_FEATURES);
+    double first = 0.0;
+    cpuperf_predict(copy, rows.data(), 1, &first);
+    bool rejected = cpuperf_model_create(coefficients, 5) == nullptr &&
+                    cpuperf_predict(nullptr, rows.data(), 1, &first) == CPUPERF_INVALID_ARGUMENT &&
+                    cpuperf_model_train("Data/missing.data", 0.0) == nullptr;
+    std::cout << "API version: " << cpuperf_api_version() << ", " << n << " rows match: " << same
+              << ", copy matches: " << (first == out[0]) << ", bad arguments rejected: " << rejected
+              << " (" << cpuperf_last_error() << ")" << std::endl;
+    cpuperf_model_free(copy);
+    cpuperf_model_free(model);
+    
+    // Training, loading and their failures print nothing; details go to cpuperf_last_error()
+    std::ostringstream captured;
+    std::streambuf* coutBuffer = std::cout.rdbuf(captured.rdbuf());
+    std::streambuf* cerrBuffer = std::cerr.rdbuf(captured.rdbuf());
+    cpuperf_model* quiet = cpuperf_model_train("Data/machine.data", 0.5);
+    cpuperf_model* missing = cpuperf_model_load("Data/missing_model.txt");
+    std::string loadError = cpuperf_last_error();
+    cpuperf_model* notData = cpuperf_model_train("include/cpuperf.h", 0.0);
+    std::string trainError = cpuperf_last_error();
+    std::cout.rdbuf(coutBuffer);
+    std::cerr.rdbuf(cerrBuffer);
+    std::cout << "Quiet: " << captured.str().empty() << ", trained: " << (quiet != nullptr)
+              << ", failures: " << (missing == nullptr && notData == nullptr) << " (" << loadError << "; "
+              << trainError << ")" << std::endl;
+    cpuperf_model_free(quiet);
+    
+    std::cout << std::endl;
+}
+
+void testCApiColumns() {
+    std::cout << "=== Testing C API columnar batches ===" << std::endl;
+    
+    // A model saved by LinearRegression loads through the C API unchanged
+    Dataset dataset;
+    LinearRegression reference;
+    std::string modelFile = "test_linear_model.txt";
+    if (!dataset.loadFromFile("Data/machine.data") || !reference.train(dataset) || !reference.save(modelFile)) {
+        std::cout << "Training or save failed!" << std::endl << std::endl;
+        return;
+    }
+    cpuperf_model* model = cpuperf_model_load(modelFile.c_str());
+    std::remove(modelFile.c_str());
+    if (model == nullptr) {
+        std::cout << "Load failed: " << cpuperf_last_error() << std::endl << std::endl;
+        return;
+    }
+    double coefficients[CPUPERF_FEATURES];
+    cpuperf_model_coefficients(model, coefficients, CPUPERF_FEATURES);
+    bool loaded = std::equal(coefficients, coefficients + CPUPERF_FEATURES, reference.getCoefficients().begin());
+    
+    // Odd row counts exercise the unrolled loop, the single-register loop and the tail
+    bool same = true;
+    for (size_t n : {size_t(1), size_t(7), size_t(37), dataset.size()}) {
+        std::vector<float> cols(CPUPERF_FEATURES * n);
+        std::vector<double> rows(CPUPERF_FEATURES * n), batch(n), byRow(n), split(n);
+        for (size_t i = 0; i < n; ++i) {
+            std::vector<double> features = dataset[i].getFeatureVector();
+            for (size_t j = 0; j < CPUPERF_FEATURES; ++j) {
+                cols[j * n + i] = static_cast<float>(features[j]);
+                rows[i * CPUPERF_FEATURES + j] = features[j];
+            }
+        }
+        const float* columns[CPUPERF_FEATURES];
+        for (size_t j = 0; j < CPUPERF_FEATURES; ++j) {
+            columns[j] = cols.data() + j * n;
+        }
+        same = same && cpuperf_predict_batch(model, cols.data(), n, batch.data()) == CPUPERF_OK &&
+               cpuperf_predict_columns(model, columns, n, split.data()) == CPUPERF_OK &&
+               cpuperf_predict(model, rows.data(), n, byRow.data()) == CPUPERF_OK && batch == byRow &&
+               split == byRow;
+    }
+    
+    // Concurrent readers of one handle see the same predictions
+    size_t n = dataset.size();
+    std::vector<float> cols(CPUPERF_FEATURES * n);
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<double> features = dataset[i].getFeatureVector();
+        for (size_t j = 0; j < CPUPERF_FEATURES; ++j) {
+            cols[j * n + i] = static_cast<float>(features[j]);
+        }
+    }
+    std::vector<double> expected(n);
+    cpuperf_predict_batch(model, cols.data(), n, expected.data());
+    const int THREADS = 4;
+    std::vector<std::vector<double>> results(THREADS, std::vector<double>(n));
+    std::vector<std::thread> readers;
+    for (int t = 0; t < THREADS; ++t) {
+        readers.emplace_back([&, t]() {
+            for (int repeat = 0; repeat < 100; ++repeat) {
+                cpuperf_predict_batch(model, cols.data(), n, results[t].data());
+            }
+        });
+    }
+    bool concurrent = true;
+    for (int t = 0; t < THREADS; ++t) {
+        readers[t].join();
+        concurrent = concurrent && results[t] == expected;
+    }
+    
+    bool rejected = cpuperf_model_load("Data/missing_model.txt") == nullptr &&
+                    cpuperf_predict_batch(model, nullptr, 1, expected.data()) == CPUPERF_INVALID_ARGUMENT;
+    
+    // A well-formed model file over the wrong number of features is refused
+    std::string narrowFile = "test_capi_narrow_model.txt";
+    FileWriter narrowWriter;
+    bool narrowWritten = narrowWriter.open(narrowFile) &&
+                         narrowWriter.write("cpuperf-linear 1\nfeatures 2\ncoefficients 1 2\ntrain_rmse 0\n") &&
+                         narrowWriter.close();
+    cpuperf_model* narrow = cpuperf_model_load(narrowFile.c_str());
+    std::string narrowError = cpuperf_last_error();
+    std::remove(narrowFile.c_str());
+    bool narrowRefused = narrowWritten && narrow == nullptr && narrowError.find("2 features") != std::string::npos;
+    cpuperf_model_free(narrow);
+    
+    std::cout << "Loaded coefficients match: " << loaded << ", batch/columns/row-major agree: " << same
+              << ", " << THREADS << " concurrent readers agree: " << concurrent
+              << ", bad arguments rejected: " << rejected << std::endl;
+    std::cout << "2-feature model refused: " << narrowRefused << " (" << narrowError << ")" << std::endl;
+    cpuperf_model_free(model);
+    
+    std::cout << std::endl;
+}
+
+void testDriftMonitor() {
+    std::cout << "=== Testing Drift Monitor ===" << std::endl;
+    
+    Dataset dataset;
+    DriftBaseline baseline, reloaded;
+    std::string baselineFile = "test_drift_baseline.txt";
+    if (!dataset.loadFromFile("Data/machine.data") || !baseline.capture(dataset) ||
+        !baseline.save(baselineFile) || !reloaded.load(baselineFile)) {
+        std::cout << "Baseline capture or save/load failed!" << std::endl << std::endl;
+        std::remove(baselineFile.c_str());
+        return;
+    }
+    bool roundTrip = reloaded.featureCount() == baseline.featureCount();
+    for (size_t j = 0; j < baseline.featureCount() && roundTrip; ++j) {
+        roundTrip = reloaded.feature(j).mean == baseline.feature(j).mean &&
+                    reloaded.feature(j).edges == baseline.feature(j).edges &&
+                    reloaded.feature(j).fractions == baseline.feature(j).fractions;
+    }
+    std::cout << "Baseline save/load round trip: " << roundTrip << ", MYCT bins: "
+              << baseline.feature(0).fractions.size() << std::endl;
+    
+    std::vector<double> rows, shifted;
+    for (size_t i = 0; i < dataset.size(); ++i) {
+        for (double value : dataset[i].getFeatureVector()) {
+            rows.push_back(value);
+            shifted.push_back(2.0 * value + 100.0);
+        }
+    }
+    
+    // Every row sampled and kept (a queue long enough that no batch is
+    // dropped): the training rows themselves score zero PSI, rows from a
+    // shifted distribution are flagged on every feature
+    DriftConfig config;
+    config.sampleStride = 1;
+    config.batchRows = 64;
+    config.queueBatches = 1024;
+    config.minWindowRows = 200;
+    DriftMonitor same(baseline, config), moved(baseline, config);
+    for (int pass = 0; pass < 4; ++pass) {
+        for (size_t first = 0; first < dataset.size(); first += 50) {
+            size_t n = std::min<size_t>(50, dataset.size() - first);
+            same.observe(rows.data() + first * 6, n);
+            moved.observe(shifted.data() + first * 6, n);
+        }
+    }
+    DriftMonitor::Report sameReport = same.report();
+    DriftMonitor::Report movedReport = moved.report();
+    double maxPsi = 0.0, minShiftedPsi = 1e300;
+    for (size_t j = 0; j < 6; ++j) {
+        maxPsi = std::max(maxPsi, sameReport.features[j].psi);
+        minShiftedPsi = std::min(minShiftedPsi, movedReport.features[j].psi);
+    }
+    std::cout << "Training rows: window " << sameReport.windowRows << ", max PSI " << maxPsi
+              << ", drifted: " << sameReport.drifted << std::endl;
+    std::cout << "Shifted rows: min PSI " << minShiftedPsi << ", drifted: " << movedReport.drifted << std::endl;
+    
+    // Sparse sampling and a small window: the live sketches keep at most two windows
+    config.sampleStride = 3;   // rounded up to 4
+    config.windowRows = 100;
+    DriftMonitor sampled(baseline, config);
+    for (int pass = 0; pass < 8; ++pass) {
+        sampled.observe(rows.data(), dataset.size());
+    }
+    DriftMonitor::Report sampledReport = sampled.report();
+    std::cout << "Stride " << sampled.getConfig().sampleStride << ": scored " << sampledReport.scoredRows
+              << ", window " << sampledReport.windowRows << " (<= " << 2 * config.windowRows + config.batchRows
+              << ")" << std::endl;
+    
+    // Through the C API, on float columns
+    cpuperf_model* model = cpuperf_model_train("Data/machine.data", 0.0);
+    if (model == nullptr) {
+        std::cout << "C API training failed: " << cpuperf_last_error() << std::endl << std::endl;
+        std::remove(baselineFile.c_str());
+        return;
+    }
+    std::vector<float> cols(6 * dataset.size());
+    for (size_t i = 0; i < dataset.size(); ++i) {
+        for (size_t j = 0; j < 6; ++j) {
+            cols[j * dataset.size() + i] = static_cast<float>(shifted[i * 6 + j]);
+        }
+    }
+    std::vector<double> out(dataset.size());
+    double psi[CPUPERF_FEATURES], ks[CPUPERF_FEATURES];
+    int drifted = 0;
+    bool offRejected = cpuperf_drift_scores(model, psi, ks, CPUPERF_FEATURES, &drifted) == CPUPERF_INVALID_ARGUMENT;
+    int status = cpuperf_model_monitor_drift(model, baselineFile.c_str(), 1);
+    for (int pass = 0; pass < 4 && status == CPUPERF_OK; ++pass) {
+        status = cpuperf_predict_batch(model, cols.data(), dataset.size(), out.data());
+    }
+    if (status == CPUPERF_OK) {
+        status = cpuperf_drift_scores(model, psi, ks, CPUPERF_FEATURES, &drifted);
+    }
+    std::cout << "C API: status " << cpuperf_status_string(status) << ", drifted: " << drifted << ", MMAX PSI "
+              << psi[2] << ", KS " << ks[2] << ", scores without a monitor rejected: " << offRejected << std::endl;
+    cpuperf_model_free(model);
+    std::remove(baselineFile.c_str());
+    
+    std::cout << std::endl;
+}
+
 int main() {
     std::cout << "CPU Performance Predictor - Test Suite" << std::endl;
     std::cout << "=======================================" << std::endl << std::endl;
     
     try {
         testMatrixOperations();
+        testMatrixViews();
+        testLUDecomposition();
         testDatasetLoading();
+        testCsvScanner();
+        testFileIO();
         testLinearRegression();
+        testMultiTargetEvaluation();
+        testStreamingPipeline();
+        testPredictionIntervals();
+        testScoringKernel();
+        testSummation();
+        testDistributedTraining();
+        testSharedDataset();
+        testNumaPlacement();
+        testHugePages();
+        testScanTuning();
+        testCpuDispatch();
+        testCApi();
+        testCApiColumns();
+        testDriftMonitor();
+        testSparseMatrix();
+        testKernelRidge();
+        testEnsemble();
         
         std::cout << "All tests completed!" << std::endl;
     }